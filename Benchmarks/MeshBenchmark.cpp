@@ -0,0 +1,402 @@
+/**
+ * @file MeshBenchmark.cpp
+ * @author DM8AT
+ * @brief measure the throughput of the mesh processing code on synthetic meshes to get a baseline for regressions
+ * @version 0.1
+ * @date 2025-11-11
+ * 
+ * usage: GLGE_CORE_MESH_BENCHMARK [--max-triangles N] [--max-import-triangles N] [--repetitions N] [--csv]
+ * 
+ * Every benchmark runs on grid meshes from 1k up to the maximum amount of triangles (10M by default). Each measurement is
+ * repeated and the median time is reported together with the throughput in vertices and bytes per second.
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ */
+
+//include the mesh system
+#include "../Geometry/Surface/Mesh.h"
+#include "../Geometry/Surface/Vertex.h"
+#include "../Geometry/Surface/MeshFile.h"
+#include "../Geometry/Surface/MeshCodec.h"
+#include "../Geometry/Surface/MeshBatch.h"
+#include "../Geometry/Surface/MeshAsset.h"
+//include the bounding volumes
+#include "../Geometry/Volumes/AABB.h"
+#include "../Geometry/Volumes/Sphere.h"
+
+//for timing
+#include <chrono>
+//for the median
+#include <algorithm>
+//for the output
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include <fstream>
+#include <filesystem>
+#include <functional>
+#include <vector>
+
+/**
+ * @brief store the settings of a benchmark run
+ */
+struct BenchmarkSettings {
+    //the largest mesh to benchmark in triangles
+    uint64_t maxTriangles = 10'000'000;
+    //the largest mesh to import using assimp in triangles (text files get large quickly)
+    uint64_t maxImportTriangles = 1'000'000;
+    //how often every measurement is repeated
+    uint32_t repetitions = 5;
+    //true to print comma separated values instead of a table
+    bool csv = false;
+};
+
+//store the settings of the current run
+static BenchmarkSettings __settings;
+//store the directory temporary files are written to
+static std::filesystem::path __tempDirectory;
+
+/**
+ * @brief measure the median run time of a function
+ * 
+ * @param setup a function that is called before every run and is not measured (may be empty)
+ * @param run the function to measure
+ * @return double the median run time in seconds
+ */
+static double __measure(const std::function<void()>& setup, const std::function<void()>& run) noexcept {
+    std::vector<double> times;
+    times.reserve(__settings.repetitions);
+    for (uint32_t i = 0; i < __settings.repetitions; ++i) {
+        if (setup) {setup();}
+        auto start = std::chrono::steady_clock::now();
+        run();
+        times.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    std::sort(times.begin(), times.end());
+    return times[times.size() / 2];
+}
+
+/**
+ * @brief print the result of a single measurement
+ * 
+ * @param name the name of the benchmark
+ * @param triangles the amount of triangles of the mesh
+ * @param vertices the amount of processed vertices
+ * @param bytes the amount of processed bytes
+ * @param seconds the median run time in seconds
+ */
+static void __report(const char* name, uint64_t triangles, uint64_t vertices, uint64_t bytes, double seconds) noexcept {
+    //avoid a division by zero for operations that are too fast for the clock
+    double time = std::max(seconds, 1e-9);
+    if (__settings.csv) {
+        printf("%s,%llu,%llu,%llu,%.9f,%.1f,%.1f\n", name, (unsigned long long)triangles, (unsigned long long)vertices, (unsigned long long)bytes,
+               seconds, vertices / time, bytes / time);
+    } else {
+        printf("%-28s %10llu tris %12.3f ms %12.2f Mvert/s %12.2f MB/s\n", name, (unsigned long long)triangles, seconds * 1e3,
+               vertices / time * 1e-6, bytes / time * 1e-6);
+    }
+    fflush(stdout);
+}
+
+/**
+ * @brief create a wavy grid with roughly a specific amount of triangles
+ * 
+ * @param triangles the amount of triangles the grid should have at least
+ * @return Mesh a mesh with full vertices (position, normal, tangent and texture coordinate)
+ */
+static Mesh __createGrid(uint64_t triangles) noexcept {
+    //a grid of n*n vertices has 2*(n-1)^2 triangles
+    uint64_t n = 2;
+    while (2 * (n-1) * (n-1) < triangles) {++n;}
+
+    std::vector<Vertex> vertices(n * n);
+    for (uint64_t y = 0; y < n; ++y) {
+        for (uint64_t x = 0; x < n; ++x) {
+            Vertex& v = vertices[y*n + x];
+            float fx = (float)x / (float)(n-1);
+            float fy = (float)y / (float)(n-1);
+            v.pos = vec3(fx * 100.f, std::sin(fx * 31.f) * std::cos(fy * 17.f), fy * 100.f);
+            v.normal = vec3(0.f, 1.f, 0.f);
+            v.tangent = vec3(1.f, 0.f, 0.f);
+            v.tex = vec2(fx, fy);
+        }
+    }
+    std::vector<index_t> indices;
+    indices.reserve(6 * (n-1) * (n-1));
+    for (uint64_t y = 0; y + 1 < n; ++y) {
+        for (uint64_t x = 0; x + 1 < n; ++x) {
+            index_t a = (index_t)(y*n + x), b = a + 1, c = (index_t)(a + n), d = c + 1;
+            indices.insert(indices.end(), {a, c, b, b, c, d});
+        }
+    }
+    return Mesh(vertices.data(), vertices.size(), GLGE_VERTEX_LAYOUT_VERTEX, indices);
+}
+
+/**
+ * @brief Get the amount of bytes the vertices and indices of a mesh use
+ * 
+ * @param mesh the mesh to quarry the size of
+ * @return uint64_t the size of the vertex and index data in bytes
+ */
+static uint64_t __meshBytes(const Mesh& mesh) noexcept
+{return mesh.getVertexCount() * mesh.getVertexLayout().m_size + mesh.getIndexCount() * (uint64_t)mesh.getIndexType();}
+
+/**
+ * @brief measure creating, copying and moving meshes
+ * 
+ * @param base the mesh to use as a source
+ * @param triangles the amount of triangles of the mesh
+ */
+static void __benchmarkLifetime(const Mesh& base, uint64_t triangles) noexcept {
+    uint64_t vertices = base.getVertexCount();
+    uint64_t bytes = __meshBytes(base);
+    //the constructor converts 32 bit indices to the smallest type, like an import does
+    std::vector<index_t> indices(base.getIndexCount());
+    for (uint64_t i = 0; i < indices.size(); ++i) {indices[i] = (index_t)base.getIndex(i);}
+
+    __report("mesh/construct", triangles, vertices, bytes, __measure({}, [&]() {
+        Mesh mesh(base.getVertices(), vertices, base.getVertexLayout(), indices.data(), indices.size());
+    }));
+    __report("mesh/copy", triangles, vertices, bytes, __measure({}, [&]() {
+        Mesh mesh(base);
+    }));
+    Mesh source;
+    __report("mesh/move", triangles, vertices, bytes, __measure([&]() {source = base;}, [&]() {
+        Mesh mesh(std::move(source));
+    }));
+}
+
+/**
+ * @brief measure the bounding box of a mesh whose positions are stored with a specific data type
+ * 
+ * @tparam Data the data type of the positions
+ * @param name the name of the benchmark
+ * @param base the mesh to take the positions from
+ * @param triangles the amount of triangles of the mesh
+ */
+template <VertexElementDataType Data>
+static void __benchmarkBounds(const char* name, const Mesh& base, uint64_t triangles) noexcept {
+    using Info = VertexElementDataTypeInfo<Data>;
+    using Component = typename Info::Component;
+    std::vector<vec3> positions = base.getPositions();
+
+    //integer types can't store every position. Unsigned types get the positions shifted into the positive range and all
+    //integer types clamp them, else the conversion is undefined.
+    vec3 shift(0);
+    if constexpr (std::is_integral_v<Component> && std::is_unsigned_v<Component>) {
+        for (const vec3& p : positions) {
+            shift.x = std::max(shift.x, -p.x);
+            shift.y = std::max(shift.y, -p.y);
+            shift.z = std::max(shift.z, -p.z);
+        }
+    }
+    auto convert = [](float value) -> Component {
+        //clamp as double, the limits of 32 bit types are not exact as floats
+        if constexpr (std::is_integral_v<Component>) {
+            return (Component)std::clamp((double)value, (double)std::numeric_limits<Component>::lowest(), (double)std::numeric_limits<Component>::max());
+        } else {
+            return (Component)value;
+        }
+    };
+
+    //convert the positions to the data type
+    std::vector<uint8_t> data(positions.size() * sizeof(typename Info::Value));
+    for (uint64_t i = 0; i < positions.size(); ++i) {
+        vec3 p = positions[i] + shift;
+        Component c[4] = {convert(p.x), convert(p.y), convert(p.z), (Component)1};
+        memcpy(data.data() + i * sizeof(typename Info::Value), c, sizeof(typename Info::Value));
+    }
+    VertexLayout layout{VertexElement(VERTEX_ELEMENT_TYPE_POSITION, Data)};
+    Mesh mesh(MeshBuffer::view(data.data(), data.size()), positions.size(), layout, MeshBuffer(), INDEX_TYPE_UINT32);
+
+    __report(name, triangles, positions.size(), data.size(), __measure({}, [&]() {
+        AABB box = mesh.getBoundingVolume<AABB>();
+        //make sure the result is used
+        if (box.min.x > box.max.x) {puts("invalid bounds");}
+    }));
+}
+
+/**
+ * @brief measure writing and reading mesh files
+ * 
+ * @param base the mesh to write
+ * @param triangles the amount of triangles of the mesh
+ */
+static void __benchmarkFiles(const Mesh& base, uint64_t triangles) noexcept {
+    uint64_t vertices = base.getVertexCount();
+    std::filesystem::path raw = __tempDirectory / "raw.gm";
+    std::filesystem::path streamed = __tempDirectory / "streamed.gm";
+    std::filesystem::path encoded = __tempDirectory / "encoded.gm";
+    MeshFileWriteOptions encodeOptions;
+    encodeOptions.encode = true;
+
+    //saving
+    __report("file/save", triangles, vertices, __meshBytes(base), __measure({}, [&]() {
+        MeshFile::write(raw, {MeshFileEntry{&base}});
+    }));
+    MeshFileStreamEntry entry;
+    entry.layout = base.getVertexLayout();
+    entry.vertexCount = vertices;
+    entry.indexCount = base.getIndexCount();
+    entry.vertices = [&](uint64_t first, uint64_t count, void* dst)
+    {memcpy(dst, (const uint8_t*)base.getVertices() + first * entry.layout.m_size, count * entry.layout.m_size);};
+    entry.indices = [&](uint64_t first, uint64_t count, index_t* dst)
+    {for (uint64_t i = 0; i < count; ++i) {dst[i] = (index_t)base.getIndex(first + i);}};
+    __report("file/save streamed", triangles, vertices, __meshBytes(base), __measure({}, [&]() {
+        MeshFile::writeStreamed(streamed, {entry});
+    }));
+    __report("file/save encoded", triangles, vertices, __meshBytes(base), __measure({}, [&]() {
+        MeshFile::write(encoded, {MeshFileEntry{&base}}, {}, encodeOptions);
+    }));
+
+    //loading. Raw files are mapped, so the bounds are computed to touch all vertices.
+    for (const auto& [name, path] : {std::pair{"file/load", raw}, std::pair{"file/load encoded", encoded}}) {
+        __report(name, triangles, vertices, std::filesystem::file_size(path), __measure({}, [&]() {
+            MeshFile file(path);
+            std::optional<Mesh> mesh = file.createMesh(0);
+            if (!mesh || (mesh->getBoundingVolume<AABB>().min.x > 0.f)) {puts("failed to load the mesh");}
+        }));
+    }
+}
+
+/**
+ * @brief measure importing a wavefront file using assimp
+ * 
+ * @param base the mesh to export as the source file
+ * @param triangles the amount of triangles of the mesh
+ */
+static void __benchmarkImport(const Mesh& base, uint64_t triangles) noexcept {
+    //write the mesh as a wavefront file
+    std::filesystem::path source = __tempDirectory / "source.obj";
+    {
+        std::ofstream f(source);
+        const Vertex* vertices = (const Vertex*)base.getVertices();
+        for (uint64_t i = 0; i < base.getVertexCount(); ++i) {
+            f << "v " << vertices[i].pos.x << " " << vertices[i].pos.y << " " << vertices[i].pos.z << "\n"
+              << "vn " << vertices[i].normal.x << " " << vertices[i].normal.y << " " << vertices[i].normal.z << "\n"
+              << "vt " << vertices[i].tex.x << " " << vertices[i].tex.y << "\n";
+        }
+        for (uint64_t i = 0; i + 2 < base.getIndexCount(); i += 3) {
+            f << "f";
+            for (uint64_t c = 0; c < 3; ++c) {
+                uint64_t index = base.getIndex(i + c) + 1;
+                f << " " << index << "/" << index << "/" << index;
+            }
+            f << "\n";
+        }
+    }
+
+    //the cache is cleared before every run, so the file is converted every time
+    std::filesystem::path cache = __tempDirectory / "cache";
+    MeshAsset::setImportCacheDirectory(cache);
+    __report("import/obj", triangles, base.getVertexCount(), std::filesystem::file_size(source), __measure([&]() {
+        std::error_code err;
+        std::filesystem::remove_all(cache, err);
+    }, [&]() {
+        if (MeshAsset::import(source.string()).empty()) {puts("failed to import the mesh");}
+    }));
+}
+
+/**
+ * @brief measure the passes that modify or convert meshes
+ * 
+ * @param base the mesh to process
+ * @param triangles the amount of triangles of the mesh
+ */
+static void __benchmarkPasses(const Mesh& base, uint64_t triangles) noexcept {
+    uint64_t vertices = base.getVertexCount();
+    uint64_t vertexBytes = vertices * base.getVertexLayout().m_size;
+    uint64_t bytes = __meshBytes(base);
+    //every pass works on a fresh copy that is created outside of the measurement
+    Mesh work;
+    auto reset = [&]() {work = base;};
+
+    __report("pass/recalculateNormals", triangles, vertices, bytes, __measure(reset, [&]() {work.recalculateNormals();}));
+    __report("pass/recalculateTangents", triangles, vertices, bytes, __measure(reset, [&]() {work.recalculateTangents();}));
+    __report("pass/weld", triangles, vertices, bytes, __measure(reset, [&]() {work.weld();}));
+    __report("pass/applyTransform", triangles, vertices, vertexBytes, __measure(reset, [&]() {
+        work.applyTransform(Transform(vec3(1.f, 2.f, 3.f), Quaternion(0.7071f, 0.f, 0.7071f, 0.f), vec3(2.f)));
+    }));
+    __report("pass/deinterleave", triangles, vertices, vertexBytes, __measure(reset, [&]() {work.deinterleave();}));
+    __report("pass/getPositions", triangles, vertices, vertexBytes, __measure({}, [&]() {
+        if (base.getPositions().size() != vertices) {puts("failed to read the positions");}
+    }));
+
+    //the codec works on raw streams
+    std::vector<uint8_t> encodedVertices;
+    std::vector<uint8_t> encodedIndices;
+    __report("codec/encode", triangles, vertices, bytes, __measure([&]() {encodedVertices.clear(); encodedIndices.clear();}, [&]() {
+        MeshCodec::encodeVertices(encodedVertices, base.getVertices(), vertices, base.getVertexLayout().m_size);
+        MeshCodec::encodeIndices(encodedIndices, base.getIndices(), base.getIndexCount(), base.getIndexType());
+    }));
+    std::vector<uint8_t> decoded(bytes);
+    __report("codec/decode", triangles, vertices, bytes, __measure({}, [&]() {
+        uint64_t used = 0;
+        MeshCodec::decodeVertices(decoded.data(), vertices, base.getVertexLayout().m_size, encodedVertices.data(), encodedVertices.size(), used);
+        MeshCodec::decodeIndices(decoded.data() + vertexBytes, base.getIndexCount(), base.getIndexType(), vertices, encodedIndices.data(), encodedIndices.size());
+    }));
+
+    //batch the mesh 4 times with different offsets
+    std::vector<MeshBatchInput> inputs(4);
+    for (uint32_t i = 0; i < inputs.size(); ++i) {inputs[i] = MeshBatchInput{&base, Transform(vec3(100.f * i, 0.f, 0.f), Quaternion(), vec3(1.f))};}
+    MeshBatch batch;
+    __report("batch/build x4", triangles * 4, vertices * 4, bytes * 4, __measure({}, [&]() {batch.build(inputs);}));
+}
+
+/**
+ * @brief parse the command line
+ * 
+ * @param argc the amount of arguments
+ * @param argv the arguments
+ * @return true : the arguments are valid
+ * @return false : an argument is unknown or has no value
+ */
+static bool __parseArguments(int argc, char** argv) noexcept {
+    for (int i = 1; i < argc; ++i) {
+        bool hasValue = (i + 1 < argc);
+        if (!strcmp(argv[i], "--csv")) {__settings.csv = true;}
+        else if (!strcmp(argv[i], "--max-triangles") && hasValue) {__settings.maxTriangles = strtoull(argv[++i], nullptr, 10);}
+        else if (!strcmp(argv[i], "--max-import-triangles") && hasValue) {__settings.maxImportTriangles = strtoull(argv[++i], nullptr, 10);}
+        else if (!strcmp(argv[i], "--repetitions") && hasValue) {__settings.repetitions = std::max<uint32_t>((uint32_t)strtoul(argv[++i], nullptr, 10), 1);}
+        else {return false;}
+    }
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    if (!__parseArguments(argc, argv)) {
+        printf("usage: %s [--max-triangles N] [--max-import-triangles N] [--repetitions N] [--csv]\n", argv[0]);
+        return 1;
+    }
+
+    //all files are written to a private directory that is removed at the end
+    std::error_code err;
+    __tempDirectory = std::filesystem::temp_directory_path(err) / "glge_mesh_benchmark";
+    std::filesystem::create_directories(__tempDirectory, err);
+
+    if (__settings.csv) {puts("benchmark,triangles,vertices,bytes,seconds,vertices_per_second,bytes_per_second");}
+    for (uint64_t triangles = 1000; triangles <= __settings.maxTriangles; triangles *= 10) {
+        Mesh base = __createGrid(triangles);
+
+        __benchmarkLifetime(base, triangles);
+        __benchmarkBounds<VERTEX_ELEMENT_DATA_TYPE_FLOAT>("bounds/float", base, triangles);
+        __benchmarkBounds<VERTEX_ELEMENT_DATA_TYPE_DOUBLE>("bounds/double", base, triangles);
+        __benchmarkBounds<VERTEX_ELEMENT_DATA_TYPE_INT16>("bounds/int16", base, triangles);
+        __benchmarkBounds<VERTEX_ELEMENT_DATA_TYPE_FLOAT_VEC2>("bounds/float_vec2", base, triangles);
+        __benchmarkBounds<VERTEX_ELEMENT_DATA_TYPE_FLOAT_VEC3>("bounds/float_vec3", base, triangles);
+        __benchmarkBounds<VERTEX_ELEMENT_DATA_TYPE_FLOAT_VEC4>("bounds/float_vec4", base, triangles);
+        __benchmarkBounds<VERTEX_ELEMENT_DATA_TYPE_DOUBLE_VEC3>("bounds/double_vec3", base, triangles);
+        __benchmarkBounds<VERTEX_ELEMENT_DATA_TYPE_INT32_VEC3>("bounds/int32_vec3", base, triangles);
+        __benchmarkBounds<VERTEX_ELEMENT_DATA_TYPE_UINT32_VEC4>("bounds/uint32_vec4", base, triangles);
+        __benchmarkFiles(base, triangles);
+        if (triangles <= __settings.maxImportTriangles) {__benchmarkImport(base, triangles);}
+        __benchmarkPasses(base, triangles);
+    }
+
+    std::filesystem::remove_all(__tempDirectory, err);
+    return 0;
+}
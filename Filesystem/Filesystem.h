@@ -19,5 +19,9 @@
 #include "Compression.h"
 //include the encryption stuff
 #include "Encryption.h"
+//include memory mapped files
+#include "MappedFile.h"
+//include hashing of file contents
+#include "Hash.h"
 
 #endif
\ No newline at end of file
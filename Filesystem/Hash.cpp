@@ -0,0 +1,115 @@
+/**
+ * @file Hash.cpp
+ * @author DM8AT
+ * @brief implement the 64 bit xxHash
+ * @version 0.1
+ * @date 2025-11-06
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ */
+
+//include the hash API
+#include "Hash.h"
+//memcpy is used for unaligned reads
+#include <cstring>
+
+//the primes used by XXH64
+static constexpr uint64_t XXH_PRIME64_1 = 0x9E3779B185EBCA87ull;
+static constexpr uint64_t XXH_PRIME64_2 = 0xC2B2AE3D27D4EB4Full;
+static constexpr uint64_t XXH_PRIME64_3 = 0x165667B19E3779F9ull;
+static constexpr uint64_t XXH_PRIME64_4 = 0x85EBCA77C2B2AE63ull;
+static constexpr uint64_t XXH_PRIME64_5 = 0x27D4EB2F165667C5ull;
+
+/**
+ * @brief rotate a 64 bit value to the left
+ * 
+ * @param value the value to rotate
+ * @param amount the amount of bits to rotate by
+ * @return uint64_t the rotated value
+ */
+static inline uint64_t __rotl64(uint64_t value, uint32_t amount) noexcept
+{return (value << amount) | (value >> (64 - amount));}
+
+/**
+ * @brief read an unaligned little endian 64 bit value
+ * 
+ * @param ptr a pointer to the first byte
+ * @return uint64_t the read value
+ */
+static inline uint64_t __read64(const uint8_t* ptr) noexcept
+{uint64_t v; memcpy(&v, ptr, sizeof(v)); return v;}
+
+/**
+ * @brief read an unaligned little endian 32 bit value
+ * 
+ * @param ptr a pointer to the first byte
+ * @return uint64_t the read value
+ */
+static inline uint64_t __read32(const uint8_t* ptr) noexcept
+{uint32_t v; memcpy(&v, ptr, sizeof(v)); return v;}
+
+/**
+ * @brief process 8 bytes of input for one of the four accumulators
+ * 
+ * @param acc the accumulator
+ * @param input the input lane
+ * @return uint64_t the new accumulator
+ */
+static inline uint64_t __round(uint64_t acc, uint64_t input) noexcept
+{return __rotl64(acc + input * XXH_PRIME64_2, 31) * XXH_PRIME64_1;}
+
+/**
+ * @brief merge an accumulator into the hash
+ * 
+ * @param hash the current hash
+ * @param acc the accumulator to merge
+ * @return uint64_t the new hash
+ */
+static inline uint64_t __mergeRound(uint64_t hash, uint64_t acc) noexcept
+{return (hash ^ __round(0, acc)) * XXH_PRIME64_1 + XXH_PRIME64_4;}
+
+uint64_t glge_Hash64(const void* data, uint64_t size, uint64_t seed)
+{
+    const uint8_t* ptr = (const uint8_t*)data;
+    const uint8_t* end = ptr + size;
+    uint64_t hash = 0;
+
+    if (size >= 32) {
+        //process 32 byte stripes with four independent accumulators
+        uint64_t acc[4] = {seed + XXH_PRIME64_1 + XXH_PRIME64_2, seed + XXH_PRIME64_2, seed, seed - XXH_PRIME64_1};
+        const uint8_t* limit = end - 32;
+        do {
+            acc[0] = __round(acc[0], __read64(ptr));
+            acc[1] = __round(acc[1], __read64(ptr + 8));
+            acc[2] = __round(acc[2], __read64(ptr + 16));
+            acc[3] = __round(acc[3], __read64(ptr + 24));
+            ptr += 32;
+        } while (ptr <= limit);
+
+        //merge the accumulators
+        hash = __rotl64(acc[0], 1) + __rotl64(acc[1], 7) + __rotl64(acc[2], 12) + __rotl64(acc[3], 18);
+        for (uint64_t a : acc) {hash = __mergeRound(hash, a);}
+    } else
+    {hash = seed + XXH_PRIME64_5;}
+
+    hash += size;
+
+    //process the remaining bytes
+    for (; ptr + 8 <= end; ptr += 8)
+    {hash = __rotl64(hash ^ __round(0, __read64(ptr)), 27) * XXH_PRIME64_1 + XXH_PRIME64_4;}
+    if (ptr + 4 <= end) {
+        hash = __rotl64(hash ^ (__read32(ptr) * XXH_PRIME64_1), 23) * XXH_PRIME64_2 + XXH_PRIME64_3;
+        ptr += 4;
+    }
+    for (; ptr < end; ++ptr)
+    {hash = __rotl64(hash ^ (*ptr * XXH_PRIME64_5), 11) * XXH_PRIME64_1;}
+
+    //final avalanche
+    hash ^= hash >> 33;
+    hash *= XXH_PRIME64_2;
+    hash ^= hash >> 29;
+    hash *= XXH_PRIME64_3;
+    hash ^= hash >> 32;
+    return hash;
+}
@@ -0,0 +1,40 @@
+/**
+ * @file Hash.h
+ * @author DM8AT
+ * @brief define a fast, non-cryptographic 64 bit hash to identify file contents
+ * @version 0.1
+ * @date 2025-11-06
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ */
+
+//header guard
+#ifndef _GLGE_CORE_FILESYSTEM_HASH_
+#define _GLGE_CORE_FILESYSTEM_HASH_
+
+//include types
+#include "../Types.h"
+
+#if __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief compute the 64 bit xxHash (XXH64) of a block of memory
+ * 
+ * The hash is fast enough to hash whole source files before importing them, but it is not cryptographically secure. 
+ * The result is identical on all platforms and can be stored in files. 
+ * 
+ * @param data a pointer to the first byte to hash
+ * @param size the amount of bytes to hash
+ * @param seed a seed to mix into the hash
+ * @return uint64_t the hash of the data
+ */
+uint64_t glge_Hash64(const void* data, uint64_t size, uint64_t seed);
+
+#if __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,96 @@
+/**
+ * @file MappedFile.cpp
+ * @author DM8AT
+ * @brief implement memory mapped files for windows and POSIX systems
+ * @version 0.1
+ * @date 2025-11-05
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ */
+
+//include memory mapped files
+#include "MappedFile.h"
+
+//include the operating system API
+#if _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+bool MappedFile::open(const std::filesystem::path& path) noexcept
+{
+    //if a file is mapped, unmap it
+    close();
+
+    #if _WIN32
+
+    //open the file for reading
+    HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {return false;}
+    //get the size of the file
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || (size.QuadPart == 0)) {
+        CloseHandle(file);
+        return false;
+    }
+    //create a copy-on-write mapping of the whole file
+    //the mapping object keeps the file open, so the file handle is not needed anymore
+    HANDLE mapping = CreateFileMappingW(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+    CloseHandle(file);
+    if (!mapping) {return false;}
+    void* data = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+    if (!data) {
+        CloseHandle(mapping);
+        return false;
+    }
+    m_mapping = mapping;
+    m_size = (uint64_t)size.QuadPart;
+
+    #else
+
+    //open the file for reading
+    int file = ::open(path.c_str(), O_RDONLY);
+    if (file < 0) {return false;}
+    //get the size of the file
+    struct stat info;
+    if ((fstat(file, &info) != 0) || (info.st_size <= 0)) {
+        ::close(file);
+        return false;
+    }
+    //create a private (copy-on-write) mapping of the whole file
+    //the mapping keeps the file referenced, so the descriptor is not needed anymore
+    void* data = mmap(nullptr, (size_t)info.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0);
+    ::close(file);
+    if (data == MAP_FAILED) {return false;}
+    m_size = (uint64_t)info.st_size;
+
+    #endif
+
+    //store the mapped memory
+    m_data = (uint8_t*)data;
+    return true;
+}
+
+void MappedFile::close() noexcept
+{
+    //nothing to unmap
+    if (!m_data) {return;}
+
+    #if _WIN32
+    UnmapViewOfFile(m_data);
+    CloseHandle((HANDLE)m_mapping);
+    m_mapping = nullptr;
+    #else
+    munmap(m_data, (size_t)m_size);
+    #endif
+
+    //the file is not mapped anymore
+    m_data = nullptr;
+    m_size = 0;
+}
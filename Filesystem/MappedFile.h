@@ -0,0 +1,111 @@
+/**
+ * @file MappedFile.h
+ * @author DM8AT
+ * @brief define a read only view onto a file that is mapped into memory
+ * @version 0.1
+ * @date 2025-11-05
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ */
+
+//header guard
+#ifndef _GLGE_CORE_FILESYSTEM_MAPPED_FILE_
+#define _GLGE_CORE_FILESYSTEM_MAPPED_FILE_
+
+//include types
+#include "../Types.h"
+
+//memory mapped files are only available for C++
+#if __cplusplus
+
+//include the C++ filesystem
+#include <filesystem>
+
+/**
+ * @brief map the contents of a file into memory
+ * 
+ * The pages are loaded by the operating system when they are first touched, so opening a file does not read it. 
+ * The mapping is private: writing to the memory creates a private copy of the page and never changes the file. 
+ */
+class MappedFile
+{
+public:
+
+    /**
+     * @brief Construct a new Mapped File
+     * 
+     * No file is mapped
+     */
+    MappedFile() = default;
+
+    /**
+     * @brief Construct a new Mapped File
+     * 
+     * @param path the path to the file to map
+     */
+    MappedFile(const std::filesystem::path& path) noexcept
+    {open(path);}
+
+    //the mapping can't be shared between two instances
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief Destroy the Mapped File and unmap the memory
+     */
+    ~MappedFile() noexcept
+    {close();}
+
+    /**
+     * @brief map a file into memory (unmap the current one if one is mapped)
+     * 
+     * @param path the path to the file to map
+     * @return true : the file was mapped successfully
+     * @return false : failed to open or map the file
+     */
+    bool open(const std::filesystem::path& path) noexcept;
+
+    /**
+     * @brief unmap the currently mapped file
+     */
+    void close() noexcept;
+
+    /**
+     * @brief check if a file is mapped
+     * 
+     * @return true : a file is mapped
+     * @return false : no file is mapped
+     */
+    inline bool isOpen() const noexcept {return m_data != nullptr;}
+
+    /**
+     * @brief Get the mapped memory
+     * 
+     * @return uint8_t* a pointer to the first byte of the file or NULL if no file is mapped
+     */
+    inline uint8_t* data() const noexcept {return m_data;}
+
+    /**
+     * @brief Get the size of the mapped file
+     * 
+     * @return uint64_t the size of the file in bytes
+     */
+    inline uint64_t size() const noexcept {return m_size;}
+
+protected:
+
+    //store a pointer to the mapped memory
+    uint8_t* m_data = nullptr;
+    //store the size of the mapping in bytes
+    uint64_t m_size = 0;
+    #if _WIN32
+    //store the handle of the file mapping object
+    void* m_mapping = nullptr;
+    #endif
+
+};
+
+#endif
+
+#endif
@@ -27,5 +27,7 @@
 #include "Geometry/Geometry.h"
 //include the asset system
 #include "Assets/Assets.h"
+//include the threading utilities
+#include "Threading/Threading.h"
 
 #endif
\ No newline at end of file
@@ -15,9 +15,21 @@
 
 //include objects
 #include "Object.h"
+//include the storage of the objects
+#include "ObjectStore.h"
 //also, add scenes
 #include "Scene.h"
+//add command buffers to change scenes from systems
+#include "SceneCommandBuffer.h"
+//add snapshots to store scenes
+#include "SceneSnapshot.h"
+//add streaming to load large worlds cell by cell
+#include "SceneStreamer.h"
+//add prefabs to create the same hierarchy many times
+#include "Prefab.h"
 //add systems to operate on the scenes
 #include "System.h"
+//add the scheduler that runs the systems
+#include "SystemScheduler.h"
 
 #endif
\ No newline at end of file
@@ -21,6 +21,38 @@
 //the maximum depth an object print may reach before exiting preemitfly
 #define OBJECT_PRINT_DEPTH_LIMIT 32
 
+/**
+ * @brief a handle identifies an object in a scene. Unlike an object pointer, a handle can be checked for validity after the object was deleted. 
+ */
+typedef struct s_ObjectHandle {
+    //the index of the slot the object is stored in
+    uint32_t index;
+    //the generation of the slot. It is increased every time an object in the slot is deleted. 
+    uint32_t generation;
+
+    //for C++ add comparison operators
+    #if __cplusplus
+
+    /**
+     * @brief check if two handles identify the same object
+     * 
+     * @param other the handle to compare with
+     * @return true : both handles identify the same object
+     * @return false : the handles identify different objects
+     */
+    inline constexpr bool operator==(const s_ObjectHandle& other) const noexcept = default;
+
+    #endif
+
+} ObjectHandle;
+
+//a handle that never identifies an object
+#if __cplusplus
+    #define OBJECT_HANDLE_INVALID (ObjectHandle{UINT32_MAX, 0})
+#else
+    #define OBJECT_HANDLE_INVALID ((ObjectHandle){UINT32_MAX, 0})
+#endif
+
 //include unordered maps for C++ only
 #if __cplusplus
     //vectors are needed for raw objects
@@ -45,6 +77,8 @@
         RawObject* parent = NULL;
         //store a vector of object pointers to the children
         std::vector<RawObject*> children{};
+        //the handle of the object (set by the object store of the scene)
+        ObjectHandle handle{UINT32_MAX, 0};
 
         /**
          * @brief recursively print the object with all children
@@ -104,6 +138,8 @@ typedef struct s_ObjectWrapper {
     void* parent;
     //opaque padding
     byte padding[24];
+    //the handle of the object
+    ObjectHandle handle;
 
 
     //for C++ add helper functions
@@ -155,6 +191,20 @@ typedef struct s_ObjectWrapper {
      */
     template <typename Component> inline void remove() noexcept;
 
+    /**
+     * @brief change the local transform of this object. The world transforms of this object and all children are updated during the next scene update. 
+     * 
+     * @param transform the new local transform
+     * @return true : the transform was changed
+     * @return false : this object does not have a transform
+     */
+    inline bool setTransform(const struct s_Transform& transform) noexcept;
+
+    /**
+     * @brief mark the world transforms of this object and all children as outdated after the local transform was changed in place
+     */
+    inline void markTransformDirty() noexcept;
+
     #endif
 
 } ObjectWrapper;
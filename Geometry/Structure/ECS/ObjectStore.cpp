@@ -0,0 +1,81 @@
+/**
+ * @file ObjectStore.cpp
+ * @author DM8AT
+ * @brief implement the object store
+ * @version 0.1
+ * @date 2025-11-13
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ */
+
+//include the object store
+#include "ObjectStore.h"
+
+RawObject* ObjectStore::create(RawObject&& object) noexcept {
+    //re-use a free slot if possible, else add a new slot
+    uint32_t index;
+    if (!m_free.empty()) {
+        index = m_free.back();
+        m_free.pop_back();
+    } else {
+        index = (uint32_t)m_slots.size();
+        m_slots.emplace_back();
+        //add a new page if the slot is the first one of a page
+        if (index / PAGE_SIZE >= m_pages.size()) 
+        {m_pages.emplace_back(new RawObject[PAGE_SIZE]);}
+    }
+
+    //store the object
+    Slot& slot = m_slots[index];
+    slot.dense = (uint32_t)m_dense.size();
+    RawObject* obj = slotObject(index);
+    *obj = std::move(object);
+    obj->handle = ObjectHandle{index, slot.generation};
+    //add the object to the dense list
+    m_dense.push_back(obj);
+    m_denseSlots.push_back(index);
+    return obj;
+}
+
+void ObjectStore::destroy(RawObject* object) noexcept {
+    //only destroy objects that are still alive
+    if (!object || get(object->handle) != object) {return;}
+    uint32_t index = object->handle.index;
+    Slot& slot = m_slots[index];
+
+    //move the last object of the dense list into the place of the removed object
+    uint32_t dense = slot.dense;
+    m_dense[dense] = m_dense.back();
+    m_denseSlots[dense] = m_denseSlots.back();
+    m_slots[m_denseSlots[dense]].dense = dense;
+    m_dense.pop_back();
+    m_denseSlots.pop_back();
+
+    //free the slot. The generation is increased so all handles to the object become invalid. 
+    slot.dense = UINT32_MAX;
+    ++slot.generation;
+    //skip the generation 0, it is used by invalid handles
+    if (slot.generation == 0) {slot.generation = 1;}
+    m_free.push_back(index);
+    //release the memory owned by the object
+    *object = RawObject{};
+}
+
+RawObject* ObjectStore::get(ObjectHandle handle) const noexcept {
+    //check if the handle belongs to an alive object
+    if (handle.index >= m_slots.size()) {return NULL;}
+    const Slot& slot = m_slots[handle.index];
+    if (slot.dense == UINT32_MAX || slot.generation != handle.generation) {return NULL;}
+    return slotObject(handle.index);
+}
+
+void ObjectStore::reserve(uint64_t count) noexcept {
+    //make space for the bookkeeping
+    m_dense.reserve(count);
+    m_denseSlots.reserve(count);
+    m_slots.reserve(count);
+    //allocate the pages up front
+    while (m_pages.size() * PAGE_SIZE < count) 
+    {m_pages.emplace_back(new RawObject[PAGE_SIZE]);}
+}
@@ -0,0 +1,146 @@
+/**
+ * @file ObjectStore.h
+ * @author DM8AT
+ * @brief an object store owns the objects of a scene. Objects are stored in fixed size pages, so pointers to them stay valid, and are addressed by generational handles. 
+ * @version 0.1
+ * @date 2025-11-13
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ */
+
+//header guard
+#ifndef _GLGE_CORE_GEOMETRY_STRUCTURE_ECS_OBJECT_STORE_
+#define _GLGE_CORE_GEOMETRY_STRUCTURE_ECS_OBJECT_STORE_
+
+//include objects
+#include "Object.h"
+
+//the object store is only available for C++
+#if __cplusplus
+
+//unique pointers own the pages
+#include <memory>
+//spans are used to iterate over the objects
+#include <span>
+
+/**
+ * @brief a slot map that stores raw objects
+ * 
+ * Every object lives in a slot. A slot has a generation that is increased when the object in it is deleted, so handles to
+ * deleted objects can be detected even if the slot is re-used. The slots are stored in pages of fixed size that never move,
+ * so an `Object` (a pointer to the raw object) stays valid until the object is deleted. Additionally, a dense list of
+ * all alive objects is kept for fast iteration. Deleting an object moves the last element of the dense list into its place. 
+ */
+class ObjectStore {
+public:
+
+    //the amount of objects stored in a single page
+    static constexpr uint32_t PAGE_SIZE = 1024;
+
+    /**
+     * @brief Construct a new Object Store
+     */
+    ObjectStore() = default;
+
+    //the store owns the objects, pointers to them must stay unique
+    ObjectStore(const ObjectStore&) = delete;
+    ObjectStore& operator=(const ObjectStore&) = delete;
+
+    /**
+     * @brief store a new object
+     * 
+     * @param object the object to store. The handle of the object is overwritten. 
+     * @return RawObject* a pointer to the stored object. It stays valid until the object is destroyed. 
+     */
+    RawObject* create(RawObject&& object) noexcept;
+
+    /**
+     * @brief delete an object from the store. All handles to the object become invalid. 
+     * 
+     * @param object a pointer to the object to delete
+     */
+    void destroy(RawObject* object) noexcept;
+
+    /**
+     * @brief get an object from a handle
+     * 
+     * @param handle the handle of the object
+     * @return RawObject* a pointer to the object or NULL if the handle is invalid or the object was deleted
+     */
+    RawObject* get(ObjectHandle handle) const noexcept;
+
+    /**
+     * @brief make space for a specific amount of objects
+     * 
+     * @param count the amount of objects the store should be able to hold without allocating
+     */
+    void reserve(uint64_t count) noexcept;
+
+    /**
+     * @brief get the amount of stored objects
+     * 
+     * @return uint64_t the amount of alive objects
+     */
+    inline uint64_t size() const noexcept {return m_dense.size();}
+
+    /**
+     * @brief get all alive objects in a dense list
+     * 
+     * The order of the objects is not stable, deleting an object changes it. 
+     * 
+     * @return std::span<RawObject* const> a list of pointers to all objects
+     */
+    inline std::span<RawObject* const> objects() const noexcept {return m_dense;}
+
+    /**
+     * @brief get an iterator to the first object
+     * 
+     * @return auto the iterator to the first element of the dense list
+     */
+    inline auto begin() const noexcept {return m_dense.begin();}
+
+    /**
+     * @brief get an iterator behind the last object
+     * 
+     * @return auto the iterator behind the last element of the dense list
+     */
+    inline auto end() const noexcept {return m_dense.end();}
+
+protected:
+
+    /**
+     * @brief store the state of a single slot
+     */
+    struct Slot {
+        //the generation of the slot
+        uint32_t generation = 1;
+        //the index of the object in the dense list (UINT32_MAX if the slot is free)
+        uint32_t dense = UINT32_MAX;
+    };
+
+    /**
+     * @brief get the object stored in a slot
+     * 
+     * @param index the index of the slot
+     * @return RawObject* a pointer to the object of the slot
+     */
+    inline RawObject* slotObject(uint32_t index) const noexcept 
+    {return &m_pages[index / PAGE_SIZE][index % PAGE_SIZE];}
+
+    //store the pages that contain the objects
+    std::vector<std::unique_ptr<RawObject[]>> m_pages;
+    //store the state of all slots
+    std::vector<Slot> m_slots;
+    //store the indices of all free slots
+    std::vector<uint32_t> m_free;
+    //store pointers to all alive objects
+    std::vector<RawObject*> m_dense;
+    //store the slot index for every element of the dense list
+    std::vector<uint32_t> m_denseSlots;
+
+};
+
+#endif
+
+#endif
@@ -0,0 +1,83 @@
+/**
+ * @file Prefab.cpp
+ * @author DM8AT
+ * @brief implement capturing and instantiating prefabs
+ * @version 0.1
+ * @date 2025-11-16
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ */
+
+//include prefabs
+#include "Prefab.h"
+
+bool Prefab::capture(Scene& scene, Object root) noexcept {
+    //the scene root can't be a node
+    if (!root || root == (Object)&scene.getRoot()) {
+        m_contents = SceneSnapshot::Contents();
+        return false;
+    }
+    m_snapshot.capture(scene, root);
+    return decode();
+}
+
+std::vector<Object> Prefab::instantiate(Scene& scene, uint64_t instances, Object parent, const Transform* transforms) const noexcept {
+    //the parent indices of all objects must fit into 32 bits
+    uint64_t nodes = getNodeCount();
+    uint64_t count = nodes * instances;
+    if (!nodes || !instances || count / instances != nodes || count >= UINT32_MAX) {return {};}
+
+    //repeat the hierarchy and the transforms for every instance
+    std::vector<uint32_t> parents(count);
+    std::vector<Transform> locals(count);
+    for (uint64_t i = 0; i < instances; ++i) {
+        uint32_t base = (uint32_t)(i * nodes);
+        for (uint64_t j = 0; j < nodes; ++j) {
+            uint32_t par = m_contents.parents[j];
+            parents[base + j] = (par == GLGE_SCENE_SNAPSHOT_NO_PARENT) ? par : (base + par);
+        }
+        memcpy(locals.data() + base, m_contents.transforms.data(), nodes * sizeof(Transform));
+        if (transforms) {locals[base] = transforms[i];}
+    }
+
+    //create all objects at once and copy the components of all instances column by column
+    std::vector<Object> objects = scene.spawnHierarchy(count, parents.data(), parent, locals.data());
+    for (const SceneSnapshot::Contents::Column& column : m_contents.columns) {
+        m_snapshot.m_components[column.component].write(scene, objects.data(), instances, nodes, column.objects.data(), column.objects.size(), column.data.data());
+    }
+    return objects;
+}
+
+bool Prefab::load(const std::filesystem::path& path) noexcept {
+    m_snapshot.load(path);
+    return decode();
+}
+
+bool Prefab::setData(std::vector<byte> data) noexcept {
+    m_snapshot.setData(std::move(data));
+    return decode();
+}
+
+uint32_t Prefab::getNodeIndex(const std::string& name) const noexcept {
+    for (size_t i = 0; i < m_contents.names.size(); ++i)
+    {if (m_contents.names[i] == name) {return (uint32_t)i;}}
+    return GLGE_PREFAB_NODE_INVALID;
+}
+
+bool Prefab::decode() noexcept {
+    //only node 0 may be a top level object
+    bool valid = m_snapshot.decode(m_contents) && !m_contents.parents.empty() && (m_contents.parents[0] == GLGE_SCENE_SNAPSHOT_NO_PARENT);
+    for (size_t i = 1; valid && i < m_contents.parents.size(); ++i)
+    {valid = (m_contents.parents[i] != GLGE_SCENE_SNAPSHOT_NO_PARENT);}
+    if (!valid) {
+        m_snapshot.setData({});
+        m_contents = SceneSnapshot::Contents();
+    }
+    return valid;
+}
+
+void PrefabAsset::load() noexcept {
+    updateLoadState(ASSET_STATE_LOADING);
+    updateLoadState(m_prefab.load(m_path) ? ASSET_STATE_LOADED : ASSET_STATE_FAILED);
+}
@@ -0,0 +1,205 @@
+/**
+ * @file Prefab.h
+ * @author DM8AT
+ * @brief a prefab is a pre-baked hierarchy of objects that can be created many times in a scene
+ * @version 0.1
+ * @date 2025-11-16
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ */
+
+//header guard
+#ifndef _GLGE_CORE_GEOMETRY_STRUCTURE_ECS_PREFAB_
+#define _GLGE_CORE_GEOMETRY_STRUCTURE_ECS_PREFAB_
+
+//include the type definitions
+#include "../../../Types.h"
+
+//the invalid index of a node
+#define GLGE_PREFAB_NODE_INVALID UINT32_MAX
+
+//prefabs are only available for C++
+#if __cplusplus
+
+//prefabs are stored as snapshots
+#include "SceneSnapshot.h"
+//prefabs can be stored as assets
+#include "../../../Assets/Assets.h"
+
+/**
+ * @brief store a hierarchy of objects (the nodes) with their components and transforms relative to their parents
+ * 
+ * A prefab is captured from an object of a scene together with all of its children or read from a stored snapshot that has
+ * a single top level object. The nodes are stored in breadth-first order, node 0 is the root of the prefab.
+ * 
+ * Instantiating creates all objects of all instances in one batch and copies the components column by column, the objects
+ * don't get names. The names of the nodes stay in the prefab, so a node of an instance can be found by `getNodeIndex`.
+ */
+class Prefab {
+public:
+
+    /**
+     * @brief Construct a new Prefab
+     */
+    Prefab() = default;
+
+    /**
+     * @brief register a component type that is stored in the prefab
+     * 
+     * All components must be registered before the prefab is captured or its data is set.
+     * 
+     * @tparam Component the type of the component. It must be trivially copyable.
+     * @param name a name that identifies the component in the stored data
+     * @return true : the component was registered
+     * @return false : the name is allready used or the maximum amount of components is reached
+     */
+    template <typename Component> inline bool registerComponent(const std::string& name) noexcept
+    {return m_snapshot.registerComponent<Component>(name);}
+
+    /**
+     * @brief store an object together with all of its children as the prefab
+     * 
+     * @param scene the scene that contains the object
+     * @param root the object that becomes the root of the prefab. It must not be the root of the scene.
+     * @return true : the prefab was created
+     * @return false : the object is not part of the scene
+     */
+    bool capture(Scene& scene, Object root) noexcept;
+
+    /**
+     * @brief create instances of the prefab
+     * 
+     * @param scene the scene to create the instances in
+     * @param instances the amount of instances to create
+     * @param parent the object to attach the roots of the instances to or NULL to use the root of the scene
+     * @param transforms a pointer to an array of `instances` transforms for the roots or NULL to use the stored transform of the root
+     * @return std::vector<Object> the objects of all instances. Node j of instance i is at index i * getNodeCount() + j.
+     */
+    std::vector<Object> instantiate(Scene& scene, uint64_t instances = 1, Object parent = NULL, const Transform* transforms = NULL) const noexcept;
+
+    /**
+     * @brief write the prefab to a file
+     * 
+     * @param path the path of the file to write
+     * @return true : the file was written
+     * @return false : failed to write the file
+     */
+    inline bool save(const std::filesystem::path& path) const noexcept {return m_snapshot.save(path);}
+
+    /**
+     * @brief read a prefab from a file
+     * 
+     * @param path the path of the file to read
+     * @return true : the file contains a valid prefab
+     * @return false : failed to read the file or the file is not a prefab
+     */
+    bool load(const std::filesystem::path& path) noexcept;
+
+    /**
+     * @brief use existing binary data as the prefab
+     * 
+     * @param data the binary data of a snapshot with a single top level object
+     * @return true : the data is a valid prefab
+     * @return false : the data is not a prefab, the prefab is cleared
+     */
+    bool setData(std::vector<byte> data) noexcept;
+
+    /**
+     * @brief get the binary data of the prefab
+     * 
+     * @return const std::vector<byte>& the binary data (empty if nothing was captured or loaded)
+     */
+    inline const std::vector<byte>& getData() const noexcept {return m_snapshot.getData();}
+
+    /**
+     * @brief get the amount of objects a single instance has
+     * 
+     * @return uint64_t the amount of nodes
+     */
+    inline uint64_t getNodeCount() const noexcept {return m_contents.parents.size();}
+
+    /**
+     * @brief find a node by the name of the object it was captured from
+     * 
+     * @param name the name of the node
+     * @return uint32_t the index of the node or GLGE_PREFAB_NODE_INVALID if no node has the name
+     */
+    uint32_t getNodeIndex(const std::string& name) const noexcept;
+
+protected:
+
+    /**
+     * @brief read the content of the snapshot and check that it has a single root
+     * 
+     * @return true : the snapshot is a valid prefab
+     * @return false : the snapshot is not a prefab, the prefab is cleared
+     */
+    bool decode() noexcept;
+
+    //store the binary data and the registered components
+    SceneSnapshot m_snapshot;
+    //store the decoded nodes
+    SceneSnapshot::Contents m_contents;
+
+};
+
+/**
+ * @brief an asset that reads a prefab from disk
+ */
+class PrefabAsset final : public BaseAsset
+{
+public:
+
+    /**
+     * @brief Construct a new Prefab Asset
+     * 
+     * @param path the path to the stored prefab
+     * @param layout a prefab that has the components registered that should be read. Only the registration is used.
+     */
+    PrefabAsset(const std::filesystem::path& path, const Prefab& layout)
+     : m_path(path), m_prefab(layout)
+    {}
+
+    /**
+     * @brief read the prefab
+     */
+    virtual void load() noexcept override;
+
+    /**
+     * @brief access the prefab
+     * 
+     * @return Prefab& a reference to the prefab (only valid if the asset is loaded)
+     */
+    inline Prefab& prefab() noexcept {return m_prefab;}
+
+    /**
+     * @brief access the prefab
+     * 
+     * @return Prefab& a reference to the prefab (only valid if the asset is loaded)
+     */
+    inline Prefab& operator()(void) noexcept {return m_prefab;}
+
+    /**
+     * @brief get access to the prefab as a pointer
+     * 
+     * @return Prefab* a pointer to the prefab (only valid if the asset is loaded)
+     */
+    inline Prefab* operator->(void) noexcept {return &m_prefab;}
+
+private:
+
+    /**
+     * @brief store the path to the stored prefab
+     */
+    std::filesystem::path m_path;
+    /**
+     * @brief store the prefab
+     */
+    Prefab m_prefab;
+
+};
+
+#endif
+
+#endif
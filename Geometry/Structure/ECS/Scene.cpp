@@ -13,9 +13,18 @@
 #include "Scene.h"
 //include systems (needed for calling functions on them)
 #include "System.h"
+//include command buffers (needed for applying them)
+#include "SceneCommandBuffer.h"
 
 //for remove_if
 #include <algorithm>
+//large hierarchies are updated on the thread pool
+#include "../../../Threading/ThreadPool.h"
+
+//the amount of objects a scene must have before the world transforms are updated level by level in parallel
+static constexpr uint64_t __TRANSFORM_LEVEL_THRESHOLD = 4096;
+//the amount of objects of a level a single job processes
+static constexpr uint64_t __TRANSFORM_LEVEL_GRAIN = 1024;
 
 Scene::~Scene()
 {
@@ -24,6 +33,8 @@ Scene::~Scene()
         delete it->second;
         it->second = NULL;
     }
+    //delete all command buffers, recorded commands are dropped
+    for (SceneCommandBuffer* buffer : m_commandBuffers) {delete buffer;}
 }
 
 void Scene::deleteObject(Object object) noexcept {
@@ -41,6 +52,8 @@ void Scene::deleteObject(Object object) noexcept {
             //change the parent and add the new child to the parent list
             ((RawObject*)child)->parent = raw->parent;
             raw->parent->children.push_back((RawObject*)child);
+            //the child is now relative to a different parent
+            markTransformDirty((Object)child);
         }
     } else {
         //what?
@@ -62,6 +75,10 @@ void Scene::deleteObject(Object object) noexcept {
         );
     }
 
+    //the object must not be updated anymore
+    std::erase(m_dirtyTransforms, raw);
+    m_transformLevelsValid = false;
+
     //destroy entity from the world
     mustache::Entity ent = *((mustache::Entity*)&raw->entity);
     m_world.entities().destroyNow(ent);
@@ -70,8 +87,8 @@ void Scene::deleteObject(Object object) noexcept {
     size_t openParen = name.rfind('(');
     size_t closeParen = name.rfind(')');
 
-    //check if the name has an index
-    if (openParen != std::string::npos && closeParen == name.size() - 1 && openParen < closeParen) {
+    //check if the name has an index (only indexed names are made unique)
+    if (m_indexNames && openParen != std::string::npos && closeParen == name.size() - 1 && openParen < closeParen) {
         //get the index from the name
         std::string baseName = name.substr(0, openParen);
         std::string numberStr = name.substr(openParen + 1, closeParen - openParen - 1);
@@ -82,7 +99,7 @@ void Scene::deleteObject(Object object) noexcept {
             m_nameFreeIndices[baseName].insert(index);
 
             //clean up map entries if no objects with that base name exist anymore
-            if (m_objects.count(baseName) == 0 &&
+            if (m_names.count(baseName) == 0 &&
                 (m_nameFreeIndices[baseName].size() == m_nameUniquenessMap[baseName])) {
                 m_nameFreeIndices.erase(baseName);
                 m_nameUniquenessMap.erase(baseName);
@@ -92,18 +109,292 @@ void Scene::deleteObject(Object object) noexcept {
         }
     }
 
-    //remove from object map
-    m_objects.erase(name);
+    //remove from the name index (anonymous objects are not indexed) and the object store
+    if (m_indexNames) {
+        auto it = m_names.find(name);
+        if (it != m_names.end() && it->second == raw) {m_names.erase(it);}
+    }
+    m_store.destroy(raw);
+}
+
+std::vector<Object> Scene::spawnHierarchy(uint64_t count, const uint32_t* parents, Object parent, const Transform* transforms) noexcept {
+    //get the non-null parent
+    RawObject* par = (parent) ? ((RawObject*)parent) : &m_root;
+
+    //count the children of every object, so every list of children is allocated once
+    std::vector<uint32_t> childCount(count, 0);
+    uint64_t topLevel = 0;
+    for (uint64_t i = 0; i < count; ++i) {
+        if (parents[i] < i) {++childCount[parents[i]];}
+        else {++topLevel;}
+    }
+
+    //make space for all objects up front
+    std::vector<Object> ret;
+    ret.reserve(count);
+    par->children.reserve(par->children.size() + topLevel);
+    m_store.reserve(m_store.size() + count);
+    m_dirtyTransforms.reserve(m_dirtyTransforms.size() + topLevel);
+
+    //create all objects, the parents are always created before their children
+    for (uint64_t i = 0; i < count; ++i) {
+        mustache::Entity ent = m_world.entities().create<String, Transform, WorldTransform>();
+        if (transforms) {*(m_world.entities().getComponent<Transform>(ent)) = transforms[i];}
+        RawObject* objParent = (parents[i] < i) ? ((RawObject*)ret[parents[i]]) : par;
+        RawObject* newObj = m_store.create(RawObject{
+            .name = std::string(),
+            .entity = *((uint64_t*)&ent),
+            .scene = this,
+            .parent = objParent,
+            .children{}
+        });
+        newObj->children.reserve(childCount[i]);
+        objParent->children.push_back(newObj);
+        ret.emplace_back((Object)newObj);
+        //the children are updated together with the top level objects
+        if (objParent == par) {markTransformDirty((Object)newObj);}
+    }
+    m_transformLevelsValid = false;
+    return ret;
+}
+
+const std::string& Scene::setName(Object object, const String& nameSuggestion) noexcept {
+    RawObject* raw = (RawObject*)object;
+    //the root keeps its name
+    if (raw == NULL || raw == &m_root) {return m_root.name;}
+
+    //remove the old name from the index
+    if (m_indexNames) {
+        auto it = m_names.find(raw->name);
+        if (it != m_names.end() && it->second == raw) {m_names.erase(it);}
+    }
+    //store the new name
+    raw->name = resolveName(nameSuggestion);
+    if (m_indexNames) {m_names.emplace(raw->name, raw);}
+    //keep the name component in sync
+    if (String* name = get<String>(object)) {*name = raw->name;}
+    return raw->name;
+}
+
+String Scene::resolveName(const String& nameSuggestion) noexcept {
+    //without the name index, names don't need to be unique
+    if (!m_indexNames) {return nameSuggestion;}
+
+    //check if the name exists. If it does, get a number to add to the end to make it unique
+    if (m_names.find(nameSuggestion) == m_names.end()) {return nameSuggestion;}
+
+    //Name collision -> generate unique name from set
+    auto& freeIndices = m_nameFreeIndices[nameSuggestion];
+    uint64_t index;
+
+    if (!freeIndices.empty()) {
+        //reuse a previously freed index
+        index = *freeIndices.begin();
+        freeIndices.erase(freeIndices.begin());
+    } else {
+        //get next unused index
+        index = ++m_nameUniquenessMap[nameSuggestion];
+    }
+
+    //format string
+    return nameSuggestion + "(" + std::to_string(index) + ")";
 }
 
 void Scene::execute(ISystem* system) {
     system->execute(m_world);
 }
 
+void Scene::markTransformDirty(const Object& obj) noexcept {
+    //NULL is interpreted as root
+    RawObject* raw = (obj) ? ((RawObject*)obj) : &m_root;
+    //the root has no entity, so all children must be marked instead
+    if (raw->entity == UINT64_MAX) {
+        for (RawObject* child : raw->children) 
+        {markTransformDirty((Object)child);}
+        return;
+    }
+
+    //objects without a world transform are never updated
+    WorldTransform* world = get<WorldTransform>((Object)raw);
+    if (!world) {
+        //the children still depend on the transform of this object
+        for (RawObject* child : raw->children) 
+        {markTransformDirty((Object)child);}
+        return;
+    }
+    //if the object is allready marked, it is allready queued
+    if (world->dirty) {return;}
+    world->dirty = 1;
+    m_dirtyTransforms.push_back(raw);
+}
+
+mat4 Scene::computeWorldMatrix(RawObject* obj) noexcept {
+    //the root is the origin of the world
+    if (obj == NULL || obj->entity == UINT64_MAX) 
+    {return mat4(1,0,0,0, 0,1,0,0, 0,0,1,0, 0,0,0,1);}
+    //if the object caches the world matrix, use the cached one
+    if (WorldTransform* world = get<WorldTransform>((Object)obj)) {return world->matrix;}
+    //else, apply the local transform to the parent's matrix
+    Transform* local = get<Transform>((Object)obj);
+    return (local) ? (computeWorldMatrix(obj->parent) * local->getTransformMatrix()) : computeWorldMatrix(obj->parent);
+}
+
+void Scene::updateSubtree(RawObject* obj) noexcept {
+    //store the objects that still need to be processed together with the world matrix of their parent
+    std::vector<std::pair<RawObject*, mat4>> stack;
+    stack.emplace_back(obj, computeWorldMatrix(obj->parent));
+
+    //iterate until all objects of the sub-tree are processed
+    while (!stack.empty()) {
+        auto [current, parentMatrix] = stack.back();
+        stack.pop_back();
+
+        //apply the local transform (objects without a transform stay in the parent's space)
+        Transform* local = get<Transform>((Object)current);
+        mat4 matrix = (local) ? (parentMatrix * local->getTransformMatrix()) : parentMatrix;
+        //store the matrix and mark it as up to date
+        if (WorldTransform* world = get<WorldTransform>((Object)current)) {
+            world->matrix = matrix;
+            world->dirty = 0;
+        }
+
+        //queue all children
+        for (RawObject* child : current->children) 
+        {stack.emplace_back(child, matrix);}
+    }
+}
+
+void Scene::rebuildTransformLevels() noexcept {
+    //start with the children of the root
+    m_transformLevels.clear();
+    TransformLevel level;
+    level.objects = m_root.children;
+    level.parents.assign(level.objects.size(), UINT32_MAX);
+
+    //add levels until the deepest object is reached
+    while (!level.objects.empty()) {
+        //collect the children of all objects of the level in order, so siblings stay next to each other
+        TransformLevel next;
+        for (size_t i = 0; i < level.objects.size(); ++i) {
+            for (RawObject* child : level.objects[i]->children) {
+                next.objects.push_back(child);
+                next.parents.push_back((uint32_t)i);
+            }
+        }
+        m_transformLevels.push_back(std::move(level));
+        level = std::move(next);
+    }
+    m_transformLevelsValid = true;
+}
+
+void Scene::updateTransformLevels() noexcept {
+    //make sure the levels match the hierarchy
+    if (!m_transformLevelsValid) {rebuildTransformLevels();}
+
+    //the levels are processed in order, the objects of a level in parallel
+    for (size_t l = 0; l < m_transformLevels.size(); ++l) {
+        TransformLevel& level = m_transformLevels[l];
+        const TransformLevel* prev = (l > 0) ? &m_transformLevels[l-1] : NULL;
+        level.updated.resize(level.objects.size());
+
+        ThreadPool::getGlobal().parallelFor(level.objects.size(), __TRANSFORM_LEVEL_GRAIN, [&](uint64_t begin, uint64_t end) {
+            //collect the local transforms of all objects that need to be updated, so their matrices can be computed at once
+            uint64_t indices[__TRANSFORM_LEVEL_GRAIN];
+            Transform locals[__TRANSFORM_LEVEL_GRAIN];
+            mat4 localMatrices[__TRANSFORM_LEVEL_GRAIN];
+            uint64_t count = 0;
+            for (uint64_t i = begin; i < end; ++i) {
+                //an object is updated if it was marked or if the parent was updated
+                WorldTransform* world = get<WorldTransform>((Object)level.objects[i]);
+                bool update = (prev && prev->updated[level.parents[i]]) || (world && world->dirty);
+                level.updated[i] = update;
+                if (!update) {continue;}
+                //objects without a transform stay in the parent's space
+                Transform* local = get<Transform>((Object)level.objects[i]);
+                locals[count] = (local) ? *local : Transform();
+                indices[count++] = i;
+            }
+            Transform::getTransformMatrices(locals, count, localMatrices);
+
+            //the previous level is finished, so the parent's world matrices are up to date
+            for (uint64_t u = 0; u < count; ++u) {
+                RawObject* obj = level.objects[indices[u]];
+                mat4 matrix = computeWorldMatrix(obj->parent) * localMatrices[u];
+                if (WorldTransform* world = get<WorldTransform>((Object)obj)) {
+                    world->matrix = matrix;
+                    world->dirty = 0;
+                }
+            }
+        });
+    }
+}
+
+void Scene::updateTransforms() noexcept {
+    //if nothing moved, nothing needs to be done
+    if (m_dirtyTransforms.empty()) {return;}
+
+    //large hierarchies are processed level by level in parallel
+    if (m_store.size() >= __TRANSFORM_LEVEL_THRESHOLD) {
+        updateTransformLevels();
+        m_dirtyTransforms.clear();
+        return;
+    }
+
+    //remove all objects that are part of a sub-tree that is updated as a whole. This must happen before any sub-tree
+    //is updated, else the dirty flags of the parents are allready cleared. 
+    std::erase_if(m_dirtyTransforms, [this](RawObject* obj) {
+        for (RawObject* par = obj->parent; par && par->entity != UINT64_MAX; par = par->parent) {
+            WorldTransform* world = get<WorldTransform>((Object)par);
+            if (world && world->dirty) {return true;}
+        }
+        return false;
+    });
+    //update the remaining sub-trees
+    for (RawObject* obj : m_dirtyTransforms) 
+    {updateSubtree(obj);}
+    //all transforms are up to date
+    m_dirtyTransforms.clear();
+}
+
+SceneCommandBuffer& Scene::getCommandBuffer() noexcept {
+    //every thread remembers its buffers per scene, so finding the buffer doesn't need a lock
+    thread_local std::vector<std::pair<uint64_t, SceneCommandBuffer*>> buffers;
+    for (const auto& [id, buffer] : buffers) 
+    {if (id == m_id) {return *buffer;}}
+
+    //first use on this thread: create a new buffer
+    std::unique_lock lock(m_commandMutex);
+    m_commandBuffers.push_back(new SceneCommandBuffer());
+    buffers.emplace_back(m_id, m_commandBuffers.back());
+    return *m_commandBuffers.back();
+}
+
+void Scene::applyCommands() noexcept {
+    //collect the commands of all buffers
+    std::vector<SceneCommandBuffer::Command*> commands;
+    for (SceneCommandBuffer* buffer : m_commandBuffers) {
+        for (SceneCommandBuffer::Command& command : buffer->m_commands) {commands.push_back(&command);}
+    }
+    if (commands.empty()) {return;}
+
+    //sort by stage and archetype or component. The sort is stable, so the recording order of similar commands is kept. 
+    std::stable_sort(commands.begin(), commands.end(), [](const SceneCommandBuffer::Command* a, const SceneCommandBuffer::Command* b) {
+        return (a->stage != b->stage) ? (a->stage < b->stage) : (a->key < b->key);
+    });
+    //apply all commands
+    for (SceneCommandBuffer::Command* command : commands) {command->apply(*this);}
+
+    //all commands are done
+    for (SceneCommandBuffer* buffer : m_commandBuffers) {buffer->m_commands.clear();}
+}
+
 void Scene::update() noexcept {
-    //iterate over all systems and then update the map
-    for (auto it = m_systems.begin(); it != m_systems.end(); ++it) 
-    {execute(it->second);}
+    //run all systems (non-conflicting systems run at the same time) and then update the map
+    m_scheduler.run(m_world);
+    //apply the structural changes recorded by the systems
+    applyCommands();
+    //update the world transforms of all objects that were moved
+    updateTransforms();
     //update the scene
     m_world.update();
 }
\ No newline at end of file
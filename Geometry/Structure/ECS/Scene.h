@@ -15,8 +15,12 @@
 
 //include objects
 #include "Object.h"
+//objects are owned by an object store
+#include "ObjectStore.h"
 //transforms are added to all objects by default
 #include "../Transform.h"
+//world transforms are added to all objects by default and are maintained by the scene
+#include "../WorldTransform.h"
 
 //for C++ create a scene class
 #if __cplusplus
@@ -25,12 +29,19 @@
 #include <unordered_map>
 //sets are for speeding up the duplicate name resolver
 #include <set>
+//a mutex guards the creation of command buffers
+#include <mutex>
+//atomics give every scene an unique identifier
+#include <atomic>
 
 //mustache is the main ECS manager
 #include "../../../external/mustache/src/mustache/ecs/ecs.hpp"
 
-//systems will be defined later
-class ISystem;
+//the scheduler runs the systems
+#include "SystemScheduler.h"
+
+//command buffers will be defined later
+class SceneCommandBuffer;
 
 //use a namespace for GLGE concepts
 namespace GLGE::Concept {
@@ -62,25 +73,62 @@ protected:
         } 
     }
 
+    /**
+     * @brief compute the world matrix of an object by using the cached world matrix of the object or of the nearest parent that has one
+     * 
+     * @param obj the object to compute the world matrix for
+     * @return mat4 the matrix that moves from the object's space into world space
+     */
+    mat4 computeWorldMatrix(RawObject* obj) noexcept;
+
+    /**
+     * @brief re-compute the world matrices of an object and all of its children
+     * 
+     * @param obj the root of the sub-tree to update
+     */
+    void updateSubtree(RawObject* obj) noexcept;
+
+    /**
+     * @brief get a unique name for a new object
+     * 
+     * If names are not indexed, the suggestion is returned as is. 
+     * 
+     * @param nameSuggestion the name the object should have
+     * @return String the suggestion or, if an object with the name exists, the suggestion followed by a number in brackets
+     */
+    String resolveName(const String& nameSuggestion) noexcept;
+
+    /**
+     * @brief sort all objects into breadth-first levels of the hierarchy
+     */
+    void rebuildTransformLevels() noexcept;
+
+    /**
+     * @brief re-compute the world matrices of all dirty objects level by level. All objects of a level are processed in parallel. 
+     */
+    void updateTransformLevels() noexcept;
+
 public:
 
     /**
      * @brief Construct a new Scene
      * 
      * @param name the name of the scene
+     * @param indexNames true : object names are made unique and can be used to find objects quickly | false : names are stored as given and finding an object by name searches all objects
      */
-    Scene(const char* name)
-     : m_name(name)
-    {}
+    Scene(const char* name, bool indexNames = true)
+     : m_name(name), m_indexNames(indexNames)
+    {if (m_indexNames) {m_names.emplace(m_root.name, &m_root);}}
 
     /**
      * @brief Construct a new Scene
      * 
      * @param name the name of the scene
+     * @param indexNames true : object names are made unique and can be used to find objects quickly | false : names are stored as given and finding an object by name searches all objects
      */
-    Scene(const std::string& name)
-     : m_name(name)
-    {}
+    Scene(const std::string& name, bool indexNames = true)
+     : m_name(name), m_indexNames(indexNames)
+    {if (m_indexNames) {m_names.emplace(m_root.name, &m_root);}}
 
     /**
      * @brief Destroy the Scene
@@ -118,41 +166,26 @@ public:
      * @return Object* a pointer to the new object
      */
     template <typename ...Components> inline Object createObject(const String& nameSuggestion, Transform transform = Transform(), Object parent = NULL) noexcept {
-        //check if the name exists. If it does, get a number to add to the end to make it unique
-        String name = nameSuggestion;
-        if (m_objects.find(name) != m_objects.end())
-        {
-            //Name collision -> generate unique name from set
-            auto& freeIndices = m_nameFreeIndices[nameSuggestion];
-            uint64_t index;
-
-            if (!freeIndices.empty()) {
-                //reuse a previously freed index
-                index = *freeIndices.begin();
-                freeIndices.erase(freeIndices.begin());
-            } else {
-                //get next unused index
-                index = ++m_nameUniquenessMap[nameSuggestion];
-            }
-
-            //format string
-            name = nameSuggestion + "(" + std::to_string(index) + ")";
-        }
+        //make sure the name is unique
+        String name = resolveName(nameSuggestion);
         //store the object and add it to the internal world
-        mustache::Entity ent = m_world.entities().create<String, Transform, Components...>();
+        mustache::Entity ent = m_world.entities().create<String, Transform, WorldTransform, Components...>();
         *(m_world.entities().getComponent<String>(ent)) = name;
         *(m_world.entities().getComponent<Transform>(ent)) = transform;
         //add the new object to the object mapping and parent
         RawObject* par = (RawObject*)((parent) ? ((RawObject*)parent) : &m_root);
-        m_objects.emplace(name, RawObject{
+        RawObject* newObj = m_store.create(RawObject{
             .name = name,
             .entity = *((uint64_t*)&ent),
             .scene = this,
             .parent = par,
             .children{}
         });
-        RawObject* newObj = &m_objects[name];
+        if (m_indexNames) {m_names.emplace(name, newObj);}
         par->children.push_back(newObj);
+        m_transformLevelsValid = false;
+        //the world transform of the new object must be computed during the next update
+        markTransformDirty((Object)newObj);
         //call the set object method for all components
         (callSetObjectIfExists<Components>(newObj), ...);
         //return a pointer to the new object
@@ -180,46 +213,32 @@ public:
         //make enough space in the parent
         par->children.reserve(par->children.size() + instances);
 
-        //make space in the internal object map
-        m_objects.reserve(m_objects.size() + instances);
+        //make space in the internal object store
+        m_store.reserve(m_store.size() + instances);
+        if (m_indexNames) {m_names.reserve(m_names.size() + instances);}
 
         //now, create all objects
         for (size_t i = 0; i < instances; ++i) {
-            //check if the name exists. If it does, get a number to add to the end to make it unique
-            String name = nameSuggestion;
-            if (m_objects.find(name) != m_objects.end())
-            {
-                //Name collision -> generate unique name from set
-                auto& freeIndices = m_nameFreeIndices[nameSuggestion];
-                uint64_t index;
-
-                if (!freeIndices.empty()) {
-                    //reuse a previously freed index
-                    index = *freeIndices.begin();
-                    freeIndices.erase(freeIndices.begin());
-                } else {
-                    //get next unused index
-                    index = ++m_nameUniquenessMap[nameSuggestion];
-                }
-
-                //format string
-                name = nameSuggestion + "(" + std::to_string(index) + ")";
-            }
+            //make sure the name is unique
+            String name = resolveName(nameSuggestion);
 
             //store the object and add it to the internal world
-            mustache::Entity ent = m_world.entities().create<String, Transform, Components...>();
+            mustache::Entity ent = m_world.entities().create<String, Transform, WorldTransform, Components...>();
             *(m_world.entities().getComponent<String>(ent)) = name;
             //add the new object to the object mapping and parent
-            m_objects.emplace(name, RawObject{
+            RawObject* newObj = m_store.create(RawObject{
                 .name = name,
                 .entity = *((uint64_t*)&ent),
                 .scene = this,
                 .parent = par,
                 .children{}
             });
-            RawObject* newObj = &m_objects[name];
+            if (m_indexNames) {m_names.emplace(name, newObj);}
             par->children.push_back(newObj);
+            m_transformLevelsValid = false;
             ret.emplace_back((Object)newObj);
+            //the world transform of the new object must be computed during the next update
+            markTransformDirty((Object)newObj);
             //call the set object method for all components
             (callSetObjectIfExists<Components>(newObj), ...);
         }
@@ -234,6 +253,79 @@ public:
      */
     void deleteObject(Object object) noexcept;
 
+    /**
+     * @brief create a lot of anonymous objects as fast as possible
+     * 
+     * The objects don't get a name, so no name is hashed, formatted or made unique. They can't be found by name until a name
+     * is given to them using `setName`. 
+     * 
+     * @tparam Components the components to add to all objects
+     * @param instances the amount of objects to create
+     * @param parent a pointer to the parent object (NULL is interpreted as ROOT and is the default)
+     * @param transforms a pointer to an array of `instances` initial transforms or NULL to use the default transform for all objects
+     * @return std::vector<Object> a list of all created objects
+     */
+    template <typename ...Components> 
+    std::vector<Object> spawnObjects(uint64_t instances, Object parent = NULL, const Transform* transforms = NULL) noexcept
+    {
+        //get the non-null parent
+        RawObject* par = (parent) ? ((RawObject*)parent) : &m_root;
+
+        //make space for all objects up front
+        std::vector<Object> ret;
+        ret.reserve(instances);
+        par->children.reserve(par->children.size() + instances);
+        m_store.reserve(m_store.size() + instances);
+        m_dirtyTransforms.reserve(m_dirtyTransforms.size() + instances);
+
+        //create all objects
+        for (uint64_t i = 0; i < instances; ++i) {
+            mustache::Entity ent = m_world.entities().create<String, Transform, WorldTransform, Components...>();
+            if (transforms) {*(m_world.entities().getComponent<Transform>(ent)) = transforms[i];}
+            RawObject* newObj = m_store.create(RawObject{
+                .name = std::string(),
+                .entity = *((uint64_t*)&ent),
+                .scene = this,
+                .parent = par,
+                .children{}
+            });
+            par->children.push_back(newObj);
+            ret.emplace_back((Object)newObj);
+            //the world transform of the new object must be computed during the next update
+            markTransformDirty((Object)newObj);
+            //call the set object method for all components
+            (callSetObjectIfExists<Components>(newObj), ...);
+        }
+        m_transformLevelsValid = false;
+        return ret;
+    }
+
+    /**
+     * @brief create a lot of anonymous objects that form one or more hierarchies
+     * 
+     * This works like `spawnObjects`, but every object can be attached to an object that is created by the same call. Only the
+     * objects that are attached to the parent are marked for a transform update, their children are updated with them. 
+     * 
+     * @param count the amount of objects to create
+     * @param parents a pointer to an array of `count` parent indices. An index points to an earlier object of the same call, 
+     *                UINT32_MAX (or any other index that is not smaller than the index of the object) attaches the object to the parent. 
+     * @param parent a pointer to the parent object of the top level objects (NULL is interpreted as ROOT and is the default)
+     * @param transforms a pointer to an array of `count` initial transforms or NULL to use the default transform for all objects
+     * @return std::vector<Object> a list of all created objects
+     */
+    std::vector<Object> spawnHierarchy(uint64_t count, const uint32_t* parents, Object parent = NULL, const Transform* transforms = NULL) noexcept;
+
+    /**
+     * @brief give an object a new name
+     * 
+     * This is mostly used to name objects created by `spawnObjects` when the name is needed. 
+     * 
+     * @param object the object to rename
+     * @param nameSuggestion the name SUGGESTION for the object. If names are indexed, it is made unique like for `createObject`. 
+     * @return const std::string& the new name of the object
+     */
+    const std::string& setName(Object object, const String& nameSuggestion) noexcept;
+
     /**
      * @brief get a pointer to the requested component or NULL if the object does not have the requested component
      * 
@@ -265,6 +357,8 @@ public:
             new (comp) Component(std::forward<Args>(args) ...);
             //if it exists, set the object for the component
             callSetObjectIfExists<Component>(*((RawObject**)&obj));
+            //a new local transform moves the object and all children
+            if constexpr (std::is_same_v<Component, Transform>) {markTransformDirty(obj);}
             return true;
         } else {
             return false;
@@ -291,6 +385,8 @@ public:
             m_world.entities().assignUnique<Component>(*((mustache::Entity*)&obj->entity), std::forward<Args>(args)...);
             //if it exists, set the object for the component
             callSetObjectIfExists<Component>(*((RawObject**)&obj));
+            //a new local transform moves the object and all children
+            if constexpr (std::is_same_v<Component, Transform>) {markTransformDirty(obj);}
             return true;
         } else {
             return false;
@@ -315,8 +411,48 @@ public:
      * @tparam Component the component to remove from the object
      * @param obj the object to remove the component from
      */
-    template <typename Component> inline void remove(const Object& obj) noexcept
-    {m_world.entities().removeComponent<Component>(*((mustache::Entity*)&obj->entity));}
+    template <typename Component> inline void remove(const Object& obj) noexcept {
+        m_world.entities().removeComponent<Component>(*((mustache::Entity*)&obj->entity));
+        //without a local transform the object and all children move back to the parent's space
+        if constexpr (std::is_same_v<Component, Transform>) {markTransformDirty(obj);}
+    }
+
+    /**
+     * @brief change the local transform of an object. The world transforms of the object and all children are updated during the next update. 
+     * 
+     * @param obj the object to change the transform of
+     * @param transform the new local transform of the object
+     * @return true : the transform was changed
+     * @return false : the object does not have a transform
+     */
+    inline bool setTransform(const Object& obj, const Transform& transform) noexcept {
+        //get the local transform of the object
+        Transform* local = get<Transform>(obj);
+        if (!local) {return false;}
+        //store the new transform and update the world transforms later
+        *local = transform;
+        markTransformDirty(obj);
+        return true;
+    }
+
+    /**
+     * @brief mark the world transform of an object and all children as outdated
+     * 
+     * This must be called after the local transform of an object was changed through a pointer (for example from `get<Transform>`). 
+     * Only the marked sub-trees are re-computed during the next update. This function is not thread safe. 
+     * 
+     * @param obj the object that changed (NULL is interpreted as ROOT and marks the whole scene)
+     */
+    void markTransformDirty(const Object& obj) noexcept;
+
+    /**
+     * @brief re-compute the world transforms of all objects that are marked as dirty
+     * 
+     * This is called automatically by `update` after all systems ran. Small scenes walk the dirty sub-trees directly. Large scenes
+     * process the hierarchy in breadth-first levels stored in contiguous arrays, where all objects of a level are updated in parallel
+     * and every level is finished before the next one starts, so parents are always written before their children. 
+     */
+    void updateTransforms() noexcept;
 
     /**
      * @brief check if an object with the name exists
@@ -326,7 +462,7 @@ public:
      * @return false : the name is not used
      */
     inline bool exists(const std::string& name) noexcept {
-        return m_objects.find(name) != m_objects.end();
+        return get(name) != NULL;
     }
 
     /**
@@ -336,12 +472,51 @@ public:
      * @return Object the actual object (NULL if it is not found)
      */
     inline Object get(const std::string& name) noexcept {
+        //without the name index all objects must be searched
+        if (!m_indexNames) {
+            if (name == m_root.name) {return (Object)&m_root;}
+            for (RawObject* obj : m_store) {if (obj->name == name) {return (Object)obj;}}
+            return NULL;
+        }
         //quarry the object
-        auto it = m_objects.find(name);
+        auto it = m_names.find(name);
         //return the object (if it does not exist, return null)
-        return (it == m_objects.end()) ? NULL : ((ObjectWrapper*)&it->second);
+        return (it == m_names.end()) ? NULL : ((ObjectWrapper*)it->second);
     }
 
+    /**
+     * @brief get an object by the handle
+     * 
+     * @param handle the handle of the object
+     * @return Object the object or NULL if the object was deleted
+     */
+    inline Object get(ObjectHandle handle) const noexcept 
+    {return (Object)m_store.get(handle);}
+
+    /**
+     * @brief get the amount of objects in the scene (without the root)
+     * 
+     * @return uint64_t the amount of objects
+     */
+    inline uint64_t getObjectCount() const noexcept {return m_store.size();}
+
+    /**
+     * @brief get the command buffer of the calling thread
+     * 
+     * Systems use the command buffer to create or delete objects and to add or remove components while other systems may run
+     * at the same time. The recorded commands are applied by `update` after all systems ran. 
+     * 
+     * @return SceneCommandBuffer& the command buffer that belongs to the calling thread and this scene
+     */
+    SceneCommandBuffer& getCommandBuffer() noexcept;
+
+    /**
+     * @brief apply the commands recorded in all command buffers
+     * 
+     * This is called automatically by `update` after all systems ran. It must not be called while systems run. 
+     */
+    void applyCommands() noexcept;
+
     /**
      * @brief run a function on all objects in the scene
      * 
@@ -361,11 +536,11 @@ public:
     template <typename Component> inline std::vector<std::pair<Object, Component*>> get() noexcept {
         //store a vector with enough space for potentially all entities
         std::vector<std::pair<Object,Component*>> out;
-        out.reserve(m_objects.size());
+        out.reserve(m_store.size());
         //get all entities of the type
-        for (auto it = m_objects.begin(); it != m_objects.end(); ++it) {
-            if (Component* comp = m_world.entities().getComponent<Component>(*((mustache::Entity*)&it->second.entity))) {
-                out.emplace_back((Object)&it->second, comp);
+        for (RawObject* obj : m_store) {
+            if (Component* comp = m_world.entities().getComponent<Component>(*((mustache::Entity*)&obj->entity))) {
+                out.emplace_back((Object)obj, comp);
             }
         }
         //remove not needed space and return
@@ -391,8 +566,10 @@ public:
             return false;
         }
 
-        //add the new system
-        m_systems.emplace(name, new T(args...));
+        //add the new system and schedule it
+        ISystem* system = new T(args...);
+        m_systems.emplace(name, system);
+        m_scheduler.add(system, typeid(T));
 
         //success
         return true;
@@ -440,6 +617,7 @@ public:
         auto it = m_systems.find(name);
         if (it != m_systems.end()) {
             //delete the element to free the memory
+            m_scheduler.remove(it->second);
             delete it->second;
             m_systems.erase(it);
         }
@@ -447,6 +625,10 @@ public:
 
     /**
      * @brief update the whole scene
+     * 
+     * All systems are run by the system scheduler. Systems that declared their component accesses and don't conflict run at the
+     * same time on the global thread pool, so they must not make structural changes (create or delete objects, add or remove components)
+     * directly. Instead, they record them in the command buffer of their thread. The commands are applied after all systems finished. 
      */
     void update() noexcept;
 
@@ -466,6 +648,7 @@ protected:
     RawObject m_root = {
         .name = "ROOT",
         .entity = UINT64_MAX,
+        .scene = this,
         .parent = NULL,
         .children{}
     };
@@ -473,12 +656,44 @@ protected:
     std::unordered_map<std::string, uint64_t> m_nameUniquenessMap;
     //store all freed indices for the names
     std::unordered_map<std::string, std::set<uint64_t>> m_nameFreeIndices;
+    //store if the names of the objects are indexed
+    bool m_indexNames = true;
     //store all the objects
-    std::unordered_map<std::string, RawObject> m_objects{{m_root.name, m_root}};
+    ObjectStore m_store;
+    //map the names of the objects to the objects (only filled if the names are indexed)
+    std::unordered_map<std::string, RawObject*> m_names;
     //store the world of the scene
     mustache::World m_world;
     //store a mapping from the system's name to the system instance
     std::unordered_map<const char*, ISystem*> m_systems;
+    //store the scheduler that runs the systems
+    SystemScheduler m_scheduler;
+    //count the created scenes to give every scene an unique identifier
+    static inline std::atomic<uint64_t> s_sceneCount{0};
+    //store the unique identifier of the scene. It is used to find the command buffers of a thread. 
+    uint64_t m_id = ++s_sceneCount;
+    //store the command buffers of all threads that recorded commands (owned by the scene)
+    std::vector<SceneCommandBuffer*> m_commandBuffers;
+    //guards the list of command buffers
+    std::mutex m_commandMutex;
+    //store all objects whose world transform must be re-computed (including the children)
+    std::vector<RawObject*> m_dirtyTransforms;
+
+    /**
+     * @brief store a single breadth-first level of the object hierarchy
+     */
+    struct TransformLevel {
+        //the objects of the level. The children of an object are stored next to each other in the next level. 
+        std::vector<RawObject*> objects;
+        //the index of the parent of each object in the previous level (UINT32_MAX for children of the root)
+        std::vector<uint32_t> parents;
+        //store for each object if the world transform was re-computed during the current update
+        std::vector<byte> updated;
+    };
+    //store the levels of the hierarchy, starting with the children of the root
+    std::vector<TransformLevel> m_transformLevels;
+    //store if the levels match the current hierarchy
+    bool m_transformLevelsValid = false;
 
 };
 
@@ -493,6 +708,10 @@ template <typename Component> inline bool ObjectWrapper::has() noexcept
     {return ((Scene*)scene)->has<Component>(this);}
 template <typename Component> inline void ObjectWrapper::remove() noexcept
     {((Scene*)scene)->remove<Component>(this);}
+inline bool ObjectWrapper::setTransform(const s_Transform& transform) noexcept
+    {return ((Scene*)scene)->setTransform(this, transform);}
+inline void ObjectWrapper::markTransformDirty() noexcept
+    {((Scene*)scene)->markTransformDirty(this);}
 
 #endif
 
@@ -0,0 +1,169 @@
+/**
+ * @file SceneCommandBuffer.h
+ * @author DM8AT
+ * @brief a scene command buffer records structural changes of a scene (creating and deleting objects, adding and removing components) so they can be applied later at a safe point
+ * @version 0.1
+ * @date 2025-11-14
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ */
+
+//header guard
+#ifndef _GLGE_CORE_GEOMETRY_STRUCTURE_ECS_SCENE_COMMAND_BUFFER_
+#define _GLGE_CORE_GEOMETRY_STRUCTURE_ECS_SCENE_COMMAND_BUFFER_
+
+//command buffers are only available for C++
+#if __cplusplus
+
+//the commands are applied to scenes
+#include "Scene.h"
+
+//commands are stored as generic functions
+#include <functional>
+
+/**
+ * @brief record structural changes of a scene
+ * 
+ * Every thread gets its own command buffer from `Scene::getCommandBuffer`, so systems that run at the same time can record
+ * changes without locks. The scene applies the commands of all buffers after all systems ran. Objects are referenced by
+ * their handles, so commands for objects that were deleted in the meantime are skipped. 
+ * 
+ * The commands are applied in stages: first all objects are created, then components are added and removed, then transforms
+ * are set and last objects are deleted. Inside of a stage, the commands are sorted by the archetype (for creation) or the
+ * component type, so mustache processes similar changes one after another. Adding and removing the same component type share
+ * a key, so they are applied in the order they were recorded in. 
+ */
+class SceneCommandBuffer {
+public:
+
+    /**
+     * @brief Construct a new Scene Command Buffer
+     */
+    SceneCommandBuffer() = default;
+
+    /**
+     * @brief record the creation of a new object
+     * 
+     * The object only exists after the commands were applied, so nothing is returned. Components, transforms and children of
+     * the new object can only be recorded after the scene applied the commands, for example by a system in the next update. 
+     * 
+     * @tparam Components a list of components to add to the entity
+     * @param nameSuggestion the name SUGGESTION for the object
+     * @param transform the initial transformation of the object
+     * @param parent a pointer to the parent or NULL if the root should be used. If the parent is deleted before the command is applied, the root is used. 
+     */
+    template <typename ...Components> inline void createObject(const String& nameSuggestion, Transform transform = Transform(), Object parent = NULL) noexcept {
+        ObjectHandle par = (parent) ? parent->handle : OBJECT_HANDLE_INVALID;
+        //the archetype does not depend on the order of the components, so the key doesn't either
+        record(STAGE_CREATE, (typeid(Components).hash_code() + ... + 0), [nameSuggestion, transform, par](Scene& scene) {
+            scene.createObject<Components...>(nameSuggestion, transform, scene.get(par));
+        });
+    }
+
+    /**
+     * @brief record the deletion of an object
+     * 
+     * @param object the object to delete
+     */
+    inline void deleteObject(Object object) noexcept {
+        ObjectHandle handle = object->handle;
+        record(STAGE_DELETE, 0, [handle](Scene& scene) {
+            if (Object obj = scene.get(handle)) {scene.deleteObject(obj);}
+        });
+    }
+
+    /**
+     * @brief record adding a component to an object
+     * 
+     * @tparam Component the type of component to add
+     * @tparam Args the argument types for the component constructor
+     * @param object the object to add the component to
+     * @param args the arguments to pass to the component constructor
+     */
+    template <typename Component, typename ...Args> inline void add(Object object, Args... args) noexcept {
+        ObjectHandle handle = object->handle;
+        record(STAGE_COMPONENT, typeid(Component).hash_code(), [handle, args...](Scene& scene) {
+            if (Object obj = scene.get(handle)) {scene.add<Component>(obj, args...);}
+        });
+    }
+
+    /**
+     * @brief record removing a component from an object
+     * 
+     * @tparam Component the component to remove from the object
+     * @param object the object to remove the component from
+     */
+    template <typename Component> inline void remove(Object object) noexcept {
+        ObjectHandle handle = object->handle;
+        record(STAGE_COMPONENT, typeid(Component).hash_code(), [handle](Scene& scene) {
+            if (Object obj = scene.get(handle)) {scene.remove<Component>(obj);}
+        });
+    }
+
+    /**
+     * @brief record changing the local transform of an object
+     * 
+     * @param object the object to change the transform of
+     * @param transform the new local transform of the object
+     */
+    inline void setTransform(Object object, const Transform& transform) noexcept {
+        ObjectHandle handle = object->handle;
+        record(STAGE_TRANSFORM, 0, [handle, transform](Scene& scene) {
+            if (Object obj = scene.get(handle)) {scene.setTransform(obj, transform);}
+        });
+    }
+
+    /**
+     * @brief get the amount of recorded commands
+     * 
+     * @return uint64_t the amount of commands that are not applied yet
+     */
+    inline uint64_t size() const noexcept {return m_commands.size();}
+
+protected:
+
+    //the scene applies the commands
+    friend class Scene;
+
+    /**
+     * @brief store the stages commands are applied in
+     */
+    enum Stage : uint8_t {
+        STAGE_CREATE = 0,
+        //adding and removing components share a stage, so their recording order is kept
+        STAGE_COMPONENT,
+        STAGE_TRANSFORM,
+        STAGE_DELETE
+    };
+
+    /**
+     * @brief store a single recorded command
+     */
+    struct Command {
+        //the stage the command is applied in
+        Stage stage;
+        //the key the commands are sorted by inside of a stage
+        uint64_t key;
+        //the function that applies the command
+        std::function<void(Scene&)> apply;
+    };
+
+    /**
+     * @brief add a new command
+     * 
+     * @param stage the stage to apply the command in
+     * @param key the key to sort the command by
+     * @param apply the function that applies the command
+     */
+    inline void record(Stage stage, uint64_t key, std::function<void(Scene&)> apply) noexcept 
+    {m_commands.push_back(Command{stage, key, std::move(apply)});}
+
+    //store all recorded commands in recording order
+    std::vector<Command> m_commands;
+
+};
+
+#endif
+
+#endif
@@ -0,0 +1,340 @@
+/**
+ * @file SceneSnapshot.cpp
+ * @author DM8AT
+ * @brief implement capturing and restoring scene snapshots
+ * @version 0.1
+ * @date 2025-11-14
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ */
+
+//include snapshots
+#include "SceneSnapshot.h"
+//snapshots are read from mapped files
+#include "../../../Filesystem/MappedFile.h"
+
+//for writing files
+#include <fstream>
+//for sorting the objects by archetype
+#include <algorithm>
+//for offsetof
+#include <cstddef>
+
+/**
+ * @brief append raw bytes to the snapshot data
+ * 
+ * @param data the data to append to
+ * @param src a pointer to the bytes to append
+ * @param size the amount of bytes to append
+ */
+static inline void __append(std::vector<byte>& data, const void* src, uint64_t size) noexcept {
+    data.insert(data.end(), (const byte*)src, (const byte*)src + size);
+}
+
+/**
+ * @brief pad the snapshot data, so the next block starts at a multiple of 8 bytes
+ * 
+ * @param data the data to pad
+ */
+static inline void __align(std::vector<byte>& data) noexcept {
+    data.resize((data.size() + 7) & ~(uint64_t)7, 0);
+}
+
+/**
+ * @brief read the snapshot data and check that no read leaves the data
+ */
+struct __SnapshotReader {
+    //the data to read
+    const byte* data;
+    //the size of the data in bytes
+    uint64_t size;
+    //the position of the next read
+    uint64_t offset = 0;
+
+    /**
+     * @brief get a pointer to the next bytes and move behind them
+     * 
+     * @param count the amount of bytes to read
+     * @return const byte* a pointer to the bytes or NULL if they are not inside the data
+     */
+    inline const byte* take(uint64_t count) noexcept {
+        if (count > size - offset) {return NULL;}
+        const byte* ptr = data + offset;
+        offset += count;
+        return ptr;
+    }
+
+    /**
+     * @brief copy the next bytes and move behind them
+     * 
+     * @param dst the memory to copy to
+     * @param count the amount of bytes to copy
+     * @return true : the bytes were copied
+     * @return false : the bytes are not inside the data
+     */
+    inline bool read(void* dst, uint64_t count) noexcept {
+        const byte* src = take(count);
+        if (src) {memcpy(dst, src, count);}
+        return src != NULL;
+    }
+
+    /**
+     * @brief move to the next multiple of 8 bytes
+     */
+    inline void align() noexcept {offset = std::min<uint64_t>((offset + 7) & ~(uint64_t)7, size);}
+};
+
+bool SceneSnapshot::capture(Scene& scene, Object root) noexcept {
+    //store a single object or all top level objects. The root of the scene is checked first, it is not stored itself.
+    if (root && root != (Object)&scene.getRoot()) {
+        //the object must belong to the scene
+        if (((RawObject*)root)->scene != &scene) {
+            m_data.clear();
+            return false;
+        }
+        return capture(scene, std::vector<Object>{root});
+    }
+    std::vector<Object> roots;
+    roots.reserve(scene.getRoot().children.size());
+    for (RawObject* child : scene.getRoot().children) {roots.push_back((Object)child);}
+    return capture(scene, roots);
+}
+
+bool SceneSnapshot::capture(Scene& scene, const std::vector<Object>& roots) noexcept {
+    m_data.clear();
+    //all objects must belong to the scene
+    for (Object root : roots) {if (!root || ((RawObject*)root)->scene != &scene) {return false;}}
+
+    //collect the objects in breadth-first order together with the index of their parents
+    std::vector<RawObject*> objects;
+    std::vector<uint32_t> parents;
+    for (Object root : roots) {
+        objects.push_back((RawObject*)root);
+        parents.push_back(GLGE_SCENE_SNAPSHOT_NO_PARENT);
+    }
+    for (size_t i = 0; i < objects.size(); ++i) {
+        for (RawObject* child : objects[i]->children) {
+            objects.push_back(child);
+            parents.push_back((uint32_t)i);
+        }
+    }
+    uint64_t count = objects.size();
+
+    //find the registered components of every object
+    std::vector<uint64_t> masks(count, 0);
+    for (uint64_t i = 0; i < count; ++i) {
+        for (size_t c = 0; c < m_components.size(); ++c)
+        {if (m_components[c].read(scene, (Object)objects[i], NULL)) {masks[i] |= (1ull << c);}}
+    }
+    //sort the objects with components by the archetype, the order inside of an archetype stays the stored order
+    std::vector<uint32_t> order;
+    order.reserve(count);
+    for (uint64_t i = 0; i < count; ++i) {if (masks[i]) {order.push_back((uint32_t)i);}}
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {return masks[a] < masks[b];});
+    uint64_t archetypes = 0;
+    for (size_t i = 0; i < order.size(); ++i) {if (i == 0 || masks[order[i]] != masks[order[i-1]]) {++archetypes;}}
+
+    //write the header (the size is filled in at the end)
+    SceneSnapshotHeader header{};
+    memcpy(header.magic, GLGE_SCENE_SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = GLGE_SCENE_SNAPSHOT_VERSION;
+    header.componentCount = (uint32_t)m_components.size();
+    header.objectCount = count;
+    header.archetypeCount = archetypes;
+    __append(m_data, &header, sizeof(header));
+
+    //write the component table
+    for (const ComponentType& type : m_components) {
+        uint32_t info[2] = {(uint32_t)type.name.size(), type.size};
+        __append(m_data, info, sizeof(info));
+        __append(m_data, type.name.data(), type.name.size());
+    }
+    __align(m_data);
+
+    //write the hierarchy and the names
+    __append(m_data, parents.data(), count * sizeof(uint32_t));
+    __align(m_data);
+    for (RawObject* obj : objects) {
+        uint32_t length = (uint32_t)obj->name.size();
+        __append(m_data, &length, sizeof(length));
+    }
+    for (RawObject* obj : objects) {__append(m_data, obj->name.data(), obj->name.size());}
+    __align(m_data);
+
+    //write the transforms as a single column
+    uint64_t transformOffset = m_data.size();
+    m_data.resize(transformOffset + count * sizeof(Transform));
+    for (uint64_t i = 0; i < count; ++i) {
+        Transform* transform = scene.get<Transform>((Object)objects[i]);
+        Transform value = (transform) ? *transform : Transform();
+        memcpy(m_data.data() + transformOffset + i * sizeof(Transform), &value, sizeof(Transform));
+    }
+    __align(m_data);
+
+    //write the archetype blocks
+    for (size_t begin = 0; begin < order.size();) {
+        //find the end of the archetype
+        uint64_t mask = masks[order[begin]];
+        size_t end = begin;
+        while (end < order.size() && masks[order[end]] == mask) {++end;}
+        uint64_t blockCount = end - begin;
+
+        __append(m_data, &mask, sizeof(mask));
+        __append(m_data, &blockCount, sizeof(blockCount));
+        __append(m_data, order.data() + begin, blockCount * sizeof(uint32_t));
+        __align(m_data);
+        //write one column per component
+        for (size_t c = 0; c < m_components.size(); ++c) {
+            if (!(mask & (1ull << c))) {continue;}
+            uint64_t offset = m_data.size();
+            m_data.resize(offset + blockCount * m_components[c].size);
+            for (uint64_t i = 0; i < blockCount; ++i)
+            {m_components[c].read(scene, (Object)objects[order[begin + i]], m_data.data() + offset + i * m_components[c].size);}
+            __align(m_data);
+        }
+        begin = end;
+    }
+
+    //store the final size
+    uint64_t size = m_data.size();
+    memcpy(m_data.data() + offsetof(SceneSnapshotHeader, size), &size, sizeof(size));
+    return true;
+}
+
+bool SceneSnapshot::decode(Contents& contents) const noexcept {
+    contents = Contents();
+    //check the data
+    if (!isSnapshot(m_data.data(), m_data.size())) {return false;}
+    __SnapshotReader reader{m_data.data(), m_data.size()};
+    SceneSnapshotHeader header;
+    reader.read(&header, sizeof(header));
+    uint64_t count = header.objectCount;
+
+    //map the stored components to the registered ones (UINT32_MAX if the component is unknown)
+    std::vector<uint32_t> mapping(header.componentCount, UINT32_MAX);
+    std::vector<uint32_t> sizes(header.componentCount, 0);
+    for (uint32_t c = 0; c < header.componentCount; ++c) {
+        uint32_t info[2];
+        if (!reader.read(info, sizeof(info))) {return false;}
+        const byte* name = reader.take(info[0]);
+        if (!name) {return false;}
+        sizes[c] = info[1];
+        for (size_t r = 0; r < m_components.size(); ++r) {
+            //the size must match as well, else the component changed
+            if ((m_components[r].name.size() == info[0]) && (memcmp(m_components[r].name.data(), name, info[0]) == 0) && (m_components[r].size == info[1]))
+            {mapping[c] = (uint32_t)r;}
+        }
+    }
+    reader.align();
+
+    //read the hierarchy, the names and the transforms
+    if (count > (reader.size - reader.offset) / (2*sizeof(uint32_t) + sizeof(Transform))) {return false;}
+    contents.parents.resize(count);
+    reader.read(contents.parents.data(), count * sizeof(uint32_t));
+    reader.align();
+    std::vector<uint32_t> nameLengths(count);
+    if (!reader.read(nameLengths.data(), count * sizeof(uint32_t))) {return false;}
+    contents.names.resize(count);
+    for (uint64_t i = 0; i < count; ++i) {
+        const char* name = (const char*)reader.take(nameLengths[i]);
+        if (!name) {return false;}
+        contents.names[i].assign(name, nameLengths[i]);
+    }
+    reader.align();
+    contents.transforms.resize(count);
+    if (!reader.read(contents.transforms.data(), count * sizeof(Transform))) {return false;}
+    reader.align();
+    //the parents must be stored before their children
+    for (uint64_t i = 0; i < count; ++i)
+    {if (contents.parents[i] != GLGE_SCENE_SNAPSHOT_NO_PARENT && contents.parents[i] >= i) {return false;}}
+
+    //collect the components of all archetype blocks into one column per registered component
+    std::vector<uint32_t> columns(m_components.size(), UINT32_MAX);
+    for (uint64_t a = 0; a < header.archetypeCount; ++a) {
+        uint64_t info[2];
+        if (!reader.read(info, sizeof(info))) {break;}
+        uint64_t mask = info[0], blockCount = info[1];
+        if (blockCount > (reader.size - reader.offset) / sizeof(uint32_t)) {break;}
+        std::vector<uint32_t> indices(blockCount);
+        reader.read(indices.data(), blockCount * sizeof(uint32_t));
+        reader.align();
+        for (uint32_t c = 0; c < header.componentCount; ++c) {
+            if (!(mask & (1ull << c))) {continue;}
+            const byte* column = reader.take(blockCount * sizes[c]);
+            reader.align();
+            //skip unknown components
+            if (!column || mapping[c] == UINT32_MAX) {continue;}
+            if (columns[mapping[c]] == UINT32_MAX) {
+                columns[mapping[c]] = (uint32_t)contents.columns.size();
+                contents.columns.push_back(Contents::Column{.component = mapping[c], .objects{}, .data{}});
+            }
+            Contents::Column& target = contents.columns[columns[mapping[c]]];
+            for (uint64_t i = 0; i < blockCount; ++i) {
+                if (indices[i] >= count) {continue;}
+                target.objects.push_back(indices[i]);
+                target.data.insert(target.data.end(), column + i * sizes[c], column + (i + 1) * sizes[c]);
+            }
+        }
+    }
+    return true;
+}
+
+std::vector<Object> SceneSnapshot::restore(Scene& scene, Object parent) const noexcept {
+    //read the stored objects
+    Contents contents;
+    if (!decode(contents)) {return {};}
+    uint64_t count = contents.parents.size();
+
+    //create all objects at once, the parents are stored before their children
+    std::vector<Object> created = scene.spawnHierarchy(count, contents.parents.data(), parent, contents.transforms.data());
+    //restore the names
+    for (uint64_t i = 0; i < count; ++i)
+    {if (!contents.names[i].empty()) {scene.setName(created[i], contents.names[i]);}}
+
+    //restore the components column by column
+    for (const Contents::Column& column : contents.columns) {
+        m_components[column.component].write(scene, created.data(), 1, count, column.objects.data(), column.objects.size(), column.data.data());
+    }
+    return created;
+}
+
+bool SceneSnapshot::save(const std::filesystem::path& path) const noexcept {
+    //nothing to write
+    if (m_data.empty()) {return false;}
+    std::ofstream f(path, std::ofstream::binary);
+    if (!f) {return false;}
+    f.write((const char*)m_data.data(), m_data.size());
+    return (bool)f;
+}
+
+bool SceneSnapshot::load(const std::filesystem::path& path) noexcept {
+    //map the file and copy the data
+    MappedFile file(path);
+    if (!file.isOpen()) {return false;}
+    return setData(std::vector<byte>(file.data(), file.data() + file.size()));
+}
+
+bool SceneSnapshot::setData(std::vector<byte> data) noexcept {
+    //only accept valid snapshots
+    if (!isSnapshot(data.data(), data.size())) {
+        m_data.clear();
+        return false;
+    }
+    m_data = std::move(data);
+    return true;
+}
+
+uint64_t SceneSnapshot::getObjectCount() const noexcept {
+    if (!isSnapshot(m_data.data(), m_data.size())) {return 0;}
+    return ((const SceneSnapshotHeader*)m_data.data())->objectCount;
+}
+
+bool SceneSnapshot::isSnapshot(const void* data, uint64_t size) noexcept {
+    //the data must at least contain the header
+    if (!data || (size < sizeof(SceneSnapshotHeader))) {return false;}
+    SceneSnapshotHeader header;
+    memcpy(&header, data, sizeof(header));
+    return (memcmp(header.magic, GLGE_SCENE_SNAPSHOT_MAGIC, sizeof(header.magic)) == 0) && (header.version == GLGE_SCENE_SNAPSHOT_VERSION) &&
+           (header.size == size) && (header.componentCount <= GLGE_SCENE_SNAPSHOT_MAX_COMPONENTS);
+}
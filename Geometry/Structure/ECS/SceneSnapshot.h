@@ -0,0 +1,286 @@
+/**
+ * @file SceneSnapshot.h
+ * @author DM8AT
+ * @brief a scene snapshot stores the objects of a scene (hierarchy, names, transforms and registered components) in a compact binary format
+ * @version 0.1
+ * @date 2025-11-14
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ */
+
+//header guard
+#ifndef _GLGE_CORE_GEOMETRY_STRUCTURE_ECS_SCENE_SNAPSHOT_
+#define _GLGE_CORE_GEOMETRY_STRUCTURE_ECS_SCENE_SNAPSHOT_
+
+//include the type definitions
+#include "../../../Types.h"
+
+/*
+ * A snapshot has the following layout (all values are little endian, every block starts at a multiple of 8 bytes):
+ * 
+ * | SceneSnapshotHeader (48 bytes)                                                        |
+ * | component table: per component a uint32_t name length, the uint32_t size and the name |
+ * | uint32_t parents[objectCount] (GLGE_SCENE_SNAPSHOT_NO_PARENT for top level objects)   |
+ * | uint32_t nameLengths[objectCount] followed by all names without NULL terminators      |
+ * | Transform transforms[objectCount]                                                     |
+ * | archetype blocks                                                                      |
+ * 
+ * The objects are stored in breadth-first order, so parents always come before their children and siblings are stored
+ * next to each other. Every archetype block starts with a uint64_t mask of the components (bit i is the i-th entry of the
+ * component table) and the uint64_t amount of objects, followed by the uint32_t indices of the objects and one column of
+ * raw component data per set bit of the mask. Objects without registered components are not part of any block.
+ */
+
+//the magic value at the start of a snapshot
+#define GLGE_SCENE_SNAPSHOT_MAGIC "GLGESNP1"
+//the current version of the snapshot layout
+#define GLGE_SCENE_SNAPSHOT_VERSION 1
+//the parent index of top level objects
+#define GLGE_SCENE_SNAPSHOT_NO_PARENT UINT32_MAX
+//the maximum amount of component types a snapshot can store
+#define GLGE_SCENE_SNAPSHOT_MAX_COMPONENTS 64
+
+/**
+ * @brief the header at the start of a snapshot
+ */
+typedef struct s_SceneSnapshotHeader {
+    //the magic value (GLGE_SCENE_SNAPSHOT_MAGIC without the NULL terminator)
+    char magic[8];
+    //the version of the layout
+    uint32_t version;
+    //the amount of entries in the component table
+    uint32_t componentCount;
+    //the amount of stored objects
+    uint64_t objectCount;
+    //the amount of archetype blocks
+    uint64_t archetypeCount;
+    //the size of the whole snapshot in bytes
+    uint64_t size;
+    //reserved for future use, must be 0
+    uint8_t reserved[8];
+} SceneSnapshotHeader;
+
+//the snapshot class is only available for C++
+#if __cplusplus
+
+//snapshots are taken from scenes
+#include "Scene.h"
+//snapshots can be stored in files
+#include <filesystem>
+//components are copied as raw bytes
+#include <cstring>
+#include <type_traits>
+
+//make sure the layout does not depend on the compiler
+static_assert(sizeof(SceneSnapshotHeader) == 48, "The scene snapshot header must be 48 bytes large");
+
+/**
+ * @brief store a binary copy of (a part of) a scene
+ * 
+ * Only components that are registered using `registerComponent` are stored. The transforms and the hierarchy are always
+ * stored, world transforms are re-computed after restoring. A snapshot can be restored into any scene that registered the
+ * same component names, components that are unknown to the restoring snapshot are skipped.
+ */
+class SceneSnapshot {
+public:
+
+    /**
+     * @brief Construct a new Scene Snapshot
+     */
+    SceneSnapshot() = default;
+
+    /**
+     * @brief register a component type that should be stored in the snapshot
+     * 
+     * @tparam Component the type of the component. It must be trivially copyable, it is stored as raw bytes.
+     * @param name a name that identifies the component in the stored data. It must be the same for all programs that read the data.
+     * @return true : the component was registered
+     * @return false : the name is allready used or the maximum amount of components is reached
+     */
+    template <typename Component> inline bool registerComponent(const std::string& name) noexcept {
+        static_assert(std::is_trivially_copyable_v<Component>, "Only trivially copyable components can be stored in a snapshot");
+        //check if the component can be added
+        if (m_components.size() >= GLGE_SCENE_SNAPSHOT_MAX_COMPONENTS) {return false;}
+        for (const ComponentType& type : m_components) {if (type.name == name) {return false;}}
+        //store the functions to access the component
+        m_components.push_back(ComponentType{
+            .name = name,
+            .size = (uint32_t)sizeof(Component),
+            .read = [](Scene& scene, Object obj, void* data) -> bool {
+                Component* comp = scene.get<Component>(obj);
+                if (comp && data) {memcpy(data, comp, sizeof(Component));}
+                return comp != NULL;
+            },
+            .write = [](Scene& scene, const Object* objects, uint64_t instances, uint64_t stride, const uint32_t* indices, uint64_t count, const void* data) {
+                for (uint64_t i = 0; i < instances; ++i) {
+                    const Object* instance = objects + i * stride;
+                    for (uint64_t k = 0; k < count; ++k) {
+                        const byte* src = (const byte*)data + k * sizeof(Component);
+                        Object obj = instance[indices[k]];
+                        Component* comp = scene.get<Component>(obj);
+                        if (!comp) {
+                            //add the component as a copy of the stored bytes
+                            alignas(Component) byte value[sizeof(Component)];
+                            memcpy(value, src, sizeof(Component));
+                            scene.add<Component>(obj, *((const Component*)value));
+                        } else {
+                            memcpy(comp, src, sizeof(Component));
+                        }
+                    }
+                }
+            }
+        });
+        return true;
+    }
+
+    /**
+     * @brief store a part of a scene
+     * 
+     * @param scene the scene to store
+     * @param root the object to store together with all children or NULL to store all objects of the scene
+     * @return true : the snapshot was created
+     * @return false : the root does not belong to the scene
+     */
+    bool capture(Scene& scene, Object root = NULL) noexcept;
+
+    /**
+     * @brief store multiple objects of a scene together with all of their children
+     * 
+     * The objects become the top level objects of the snapshot. No object may be a child of another object in the list.
+     * 
+     * @param scene the scene to store
+     * @param roots the objects to store
+     * @return true : the snapshot was created
+     * @return false : one of the objects does not belong to the scene
+     */
+    bool capture(Scene& scene, const std::vector<Object>& roots) noexcept;
+
+    /**
+     * @brief create all stored objects in a scene
+     * 
+     * @param scene the scene to create the objects in
+     * @param parent the object to attach the top level objects to or NULL to use the root of the scene
+     * @return std::vector<Object> all created objects in the stored order or an empty list if the snapshot is invalid
+     */
+    std::vector<Object> restore(Scene& scene, Object parent = NULL) const noexcept;
+
+    /**
+     * @brief the content of a snapshot in a form that can be used without reading the binary data again
+     */
+    struct Contents {
+        /**
+         * @brief store all stored values of a single registered component
+         */
+        struct Column {
+            //the index of the registered component
+            uint32_t component;
+            //the indices of the objects that have the component
+            std::vector<uint32_t> objects;
+            //the raw component data, one value per object index
+            std::vector<byte> data;
+        };
+
+        //the index of the parent of every object (GLGE_SCENE_SNAPSHOT_NO_PARENT for top level objects)
+        std::vector<uint32_t> parents;
+        //the name of every object
+        std::vector<std::string> names;
+        //the local transform of every object
+        std::vector<Transform> transforms;
+        //one column per registered component that is stored for at least one object
+        std::vector<Column> columns;
+    };
+
+    /**
+     * @brief read the stored objects without creating them
+     * 
+     * Components that are not registered are skipped. 
+     * 
+     * @param contents the structure to fill with the content of the snapshot
+     * @return true : the content was read
+     * @return false : the snapshot is invalid
+     */
+    bool decode(Contents& contents) const noexcept;
+
+    /**
+     * @brief write the snapshot to a file
+     * 
+     * @param path the path of the file to write
+     * @return true : the file was written
+     * @return false : failed to write the file
+     */
+    bool save(const std::filesystem::path& path) const noexcept;
+
+    /**
+     * @brief read a snapshot from a file
+     * 
+     * @param path the path of the file to read
+     * @return true : the file contains a valid snapshot
+     * @return false : failed to read the file or the file is not a snapshot
+     */
+    bool load(const std::filesystem::path& path) noexcept;
+
+    /**
+     * @brief use existing binary data as the snapshot
+     * 
+     * @param data the binary data of a snapshot
+     * @return true : the data is a valid snapshot
+     * @return false : the data is not a snapshot, the snapshot is cleared
+     */
+    bool setData(std::vector<byte> data) noexcept;
+
+    /**
+     * @brief get the binary data of the snapshot
+     * 
+     * @return const std::vector<byte>& the binary data (empty if nothing was captured or loaded)
+     */
+    inline const std::vector<byte>& getData() const noexcept {return m_data;}
+
+    /**
+     * @brief get the amount of stored objects
+     * 
+     * @return uint64_t the amount of objects a restore creates
+     */
+    uint64_t getObjectCount() const noexcept;
+
+    /**
+     * @brief check if some data is a snapshot
+     * 
+     * @param data a pointer to the data
+     * @param size the size of the data in bytes
+     * @return true : the data starts with a snapshot header of the current version
+     * @return false : the data is not a snapshot
+     */
+    static bool isSnapshot(const void* data, uint64_t size) noexcept;
+
+protected:
+
+    /**
+     * @brief store how to access a registered component
+     */
+    struct ComponentType {
+        //the name that identifies the component in the data
+        std::string name;
+        //the size of the component in bytes
+        uint32_t size;
+        //copy the component of an object to the data (data may be NULL). Returns false if the object does not have the component.
+        bool (*read)(Scene&, Object, void*);
+        //add the component to objects (if needed) and copy the data into them. The arguments are the objects of all instances,
+        //the amount of instances, the amount of objects per instance, the indices of the objects inside of an instance,
+        //the amount of indices and one value per index. 
+        void (*write)(Scene&, const Object*, uint64_t, uint64_t, const uint32_t*, uint64_t, const void*);
+    };
+
+    //prefabs create the objects of a snapshot many times
+    friend class Prefab;
+
+    //store all registered components
+    std::vector<ComponentType> m_components;
+    //store the binary data of the snapshot
+    std::vector<byte> m_data;
+
+};
+
+#endif
+
+#endif
@@ -0,0 +1,269 @@
+/**
+ * @file SceneStreamer.cpp
+ * @author DM8AT
+ * @brief implement streaming scene cells
+ * @version 0.1
+ * @date 2025-11-15
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ */
+
+//include the streamer
+#include "SceneStreamer.h"
+//cells are read from mapped files
+#include "../../../Filesystem/MappedFile.h"
+
+//for sorting the cells by distance
+#include <algorithm>
+//for floor and sqrt
+#include <cmath>
+//for parsing the file names
+#include <cstdio>
+//for infinity
+#include <limits>
+
+void SceneCellAsset::load() noexcept {
+    updateLoadState(ASSET_STATE_LOADING);
+    //map the file and copy the snapshot
+    MappedFile file(m_path);
+    if (!file.isOpen() || !SceneSnapshot::isSnapshot(file.data(), file.size())) {
+        updateLoadState(ASSET_STATE_FAILED);
+        return;
+    }
+    m_data.assign(file.data(), file.data() + file.size());
+    updateLoadState(ASSET_STATE_LOADED);
+}
+
+/**
+ * @brief read the coordinate of a cell from the name of its file
+ * 
+ * @param path the path to the file
+ * @param cell the coordinate to fill
+ * @return true : the file is exactly named like a cell
+ * @return false : the file is not a cell
+ */
+static bool __parseCellName(const std::filesystem::path& path, SceneCellCoord& cell) noexcept {
+    std::string name = path.filename().string();
+    int length = 0;
+    return (sscanf(name.c_str(), "cell_%d_%d_%d.gsnp%n", &cell.x, &cell.y, &cell.z, &length) == 3) && ((size_t)length == name.size());
+}
+
+SceneStreamer::SceneStreamer(Scene& scene, const std::filesystem::path& directory, float cellSize, Object parent) noexcept
+ : m_scene(&scene), m_parent(parent), m_directory(directory), m_cellSize(cellSize), m_loadRadius(cellSize), m_unloadRadius(cellSize * 1.5f)
+{
+    //find all cells that allready exist
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(m_directory, error)) {
+        SceneCellCoord cell;
+        if (__parseCellName(entry.path(), cell)) {m_cells[pack(cell)].coord = cell;}
+    }
+}
+
+uint64_t SceneStreamer::partition(Scene& source) noexcept {
+    //sort the top level objects into the cells
+    std::unordered_map<uint64_t, std::pair<SceneCellCoord, std::vector<Object>>> cells;
+    for (RawObject* obj : source.getRoot().children) {
+        Transform* transform = source.get<Transform>((Object)obj);
+        SceneCellCoord cell = getCell((transform) ? transform->pos : vec3(0));
+        auto& entry = cells[pack(cell)];
+        entry.first = cell;
+        entry.second.push_back((Object)obj);
+    }
+
+    //the old cells belong to a different world, so their objects and files are removed
+    for (auto& [key, cell] : m_cells) {
+        if (cell.state == Cell::LOADED) {unload(cell);}
+        else if (cell.state == Cell::PENDING) {--m_pendingCount;}
+    }
+    m_cells.clear();
+    m_active.clear();
+    std::error_code error;
+    std::vector<std::filesystem::path> stale;
+    for (const auto& entry : std::filesystem::directory_iterator(m_directory, error)) {
+        SceneCellCoord cell;
+        if (__parseCellName(entry.path(), cell)) {stale.push_back(entry.path());}
+    }
+    for (const std::filesystem::path& path : stale) {std::filesystem::remove(path, error);}
+
+    //write one snapshot per cell
+    std::filesystem::create_directories(m_directory, error);
+    for (auto& [key, entry] : cells) {
+        if (!m_snapshot.capture(source, entry.second) || !m_snapshot.save(getCellPath(entry.first))) {return 0;}
+        m_cells[key].coord = entry.first;
+    }
+    return cells.size();
+}
+
+uint32_t SceneStreamer::addObserver(const vec3& position) noexcept {
+    //re-use the slot of a removed observer
+    for (size_t i = 0; i < m_observers.size(); ++i) {
+        if (!m_observers[i].second) {
+            m_observers[i] = {position, 1};
+            return (uint32_t)i;
+        }
+    }
+    m_observers.emplace_back(position, 1);
+    return (uint32_t)(m_observers.size() - 1);
+}
+
+void SceneStreamer::setObserver(uint32_t observer, const vec3& position) noexcept {
+    if (observer < m_observers.size() && m_observers[observer].second) {m_observers[observer].first = position;}
+}
+
+void SceneStreamer::removeObserver(uint32_t observer) noexcept {
+    if (observer < m_observers.size()) {m_observers[observer].second = 0;}
+}
+
+void SceneStreamer::setRadius(float loadRadius, float unloadRadius) noexcept {
+    m_loadRadius = loadRadius;
+    m_unloadRadius = std::max(loadRadius, unloadRadius);
+}
+
+SceneCellCoord SceneStreamer::getCell(const vec3& position) const noexcept {
+    return SceneCellCoord{
+        (int32_t)std::floor(position.x / m_cellSize),
+        (int32_t)std::floor(position.y / m_cellSize),
+        (int32_t)std::floor(position.z / m_cellSize)
+    };
+}
+
+bool SceneStreamer::isLoaded(const SceneCellCoord& cell) const noexcept {
+    auto it = m_cells.find(pack(cell));
+    return (it != m_cells.end()) && (it->second.state == Cell::LOADED);
+}
+
+std::filesystem::path SceneStreamer::getCellPath(const SceneCellCoord& cell) const noexcept {
+    return m_directory / ("cell_" + std::to_string(cell.x) + "_" + std::to_string(cell.y) + "_" + std::to_string(cell.z) + ".gsnp");
+}
+
+/**
+ * @brief get the distance between a value and a range on a single axis
+ * 
+ * @param value the value to measure from
+ * @param min the start of the range
+ * @param max the end of the range
+ * @return float the distance (0 if the value is inside of the range)
+ */
+static inline float __axisDistance(float value, float min, float max) noexcept {
+    return (value < min) ? (min - value) : ((value > max) ? (value - max) : 0.f);
+}
+
+float SceneStreamer::getDistance(const SceneCellCoord& cell) const noexcept {
+    float best = std::numeric_limits<float>::infinity();
+    for (const auto& [pos, active] : m_observers) {
+        if (!active) {continue;}
+        //the distance between the observer and the box of the cell
+        float dx = __axisDistance(pos.x, cell.x * m_cellSize, (cell.x + 1) * m_cellSize);
+        float dy = __axisDistance(pos.y, cell.y * m_cellSize, (cell.y + 1) * m_cellSize);
+        float dz = __axisDistance(pos.z, cell.z * m_cellSize, (cell.z + 1) * m_cellSize);
+        best = std::min(best, std::sqrt(dx*dx + dy*dy + dz*dz));
+    }
+    return best;
+}
+
+uint64_t SceneStreamer::unload(Cell& cell) noexcept {
+    //delete the children first, so nothing has to be re-parented
+    for (auto it = cell.objects.rbegin(); it != cell.objects.rend(); ++it) {
+        if (Object obj = m_scene->get(*it)) {m_scene->deleteObject(obj);}
+    }
+    uint64_t count = cell.objects.size();
+    cell.objects = {};
+    cell.state = Cell::UNLOADED;
+    --m_loadedCount;
+    return count;
+}
+
+void SceneStreamer::update() noexcept {
+    //store how many objects were created or deleted in this update
+    uint64_t work = 0;
+    //check if another cell with the amount of objects fits into the budget
+    auto fits = [&](uint64_t objects) {return (work == 0) || (work + objects <= m_budget.maxObjectsPerUpdate);};
+
+    //sort the active cells by distance, so the nearest cells are integrated first and the furthest are unloaded first
+    std::vector<std::pair<float, uint64_t>> active;
+    active.reserve(m_active.size());
+    for (uint64_t key : m_active) {active.emplace_back(getDistance(m_cells[key].coord), key);}
+    std::sort(active.begin(), active.end());
+
+    //unload the cells that are too far away
+    for (auto it = active.rbegin(); it != active.rend() && it->first > m_unloadRadius; ++it) {
+        Cell& cell = m_cells[it->second];
+        if (cell.state == Cell::PENDING) {
+            //the loaded data is not needed anymore
+            cell.asset = AssetHandle();
+            cell.state = Cell::UNLOADED;
+            --m_pendingCount;
+        } else if (cell.state == Cell::LOADED && fits(cell.objects.size())) {
+            work += unload(cell);
+        }
+    }
+
+    //integrate the cells that finished loading
+    for (const auto& [distance, key] : active) {
+        Cell& cell = m_cells[key];
+        if (cell.state != Cell::PENDING) {continue;}
+        SceneCellAsset* asset = AssetManager::getAsset<SceneCellAsset>(cell.asset);
+        AssetState state = (asset) ? asset->getLoadState() : ASSET_STATE_FAILED;
+        if (state == ASSET_STATE_LOADING || state == ASSET_STATE_UNLOADED) {continue;}
+        if (state == ASSET_STATE_LOADED) {
+            //the data was checked while loading, so the header can be read directly. If it does not fit, it is kept for the next update.
+            SceneSnapshotHeader header;
+            memcpy(&header, asset->data().data(), sizeof(header));
+            if (!fits(header.objectCount)) {continue;}
+        }
+        if (state == ASSET_STATE_FAILED || !m_snapshot.setData(std::move(asset->data()))) {
+            cell.asset = AssetHandle();
+            cell.state = Cell::FAILED;
+            --m_pendingCount;
+            continue;
+        }
+        //create the objects and remember their handles
+        std::vector<Object> objects = m_snapshot.restore(*m_scene, m_parent);
+        cell.objects.resize(objects.size());
+        for (size_t i = 0; i < objects.size(); ++i) {cell.objects[i] = ((RawObject*)objects[i])->handle;}
+        work += objects.size();
+        cell.asset = AssetHandle();
+        cell.state = Cell::LOADED;
+        --m_pendingCount;
+        ++m_loadedCount;
+    }
+
+    //only keep the cells that are still pending or loaded
+    std::erase_if(m_active, [&](uint64_t key) {
+        Cell::State state = m_cells[key].state;
+        return (state != Cell::PENDING) && (state != Cell::LOADED);
+    });
+
+    //find the known cells inside of the load radius that are not loaded yet
+    std::vector<std::pair<float, uint64_t>> wanted;
+    int32_t reach = (int32_t)std::ceil(m_loadRadius / m_cellSize);
+    for (const auto& [pos, isActive] : m_observers) {
+        if (!isActive) {continue;}
+        SceneCellCoord center = getCell(pos);
+        for (int32_t x = center.x - reach; x <= center.x + reach; ++x) {
+            for (int32_t y = center.y - reach; y <= center.y + reach; ++y) {
+                for (int32_t z = center.z - reach; z <= center.z + reach; ++z) {
+                    auto it = m_cells.find(pack(SceneCellCoord{x, y, z}));
+                    if (it == m_cells.end() || it->second.state != Cell::UNLOADED) {continue;}
+                    float distance = getDistance(it->second.coord);
+                    if (distance <= m_loadRadius) {wanted.emplace_back(distance, it->first);}
+                }
+            }
+        }
+    }
+    std::sort(wanted.begin(), wanted.end());
+    wanted.erase(std::unique(wanted.begin(), wanted.end()), wanted.end());
+
+    //start reading the nearest cells in the background
+    uint32_t started = 0;
+    for (const auto& [distance, key] : wanted) {
+        if (m_pendingCount >= m_budget.maxPendingLoads || started >= m_budget.maxLoadsPerUpdate) {break;}
+        Cell& cell = m_cells[key];
+        cell.asset = AssetManager::create<SceneCellAsset>(getCellPath(cell.coord));
+        cell.state = Cell::PENDING;
+        m_active.push_back(key);
+        ++m_pendingCount;
+        ++started;
+    }
+}
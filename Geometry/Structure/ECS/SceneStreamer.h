@@ -0,0 +1,353 @@
+/**
+ * @file SceneStreamer.h
+ * @author DM8AT
+ * @brief a scene streamer partitions the objects of a world into spatial cells and loads or unloads the cells around observers
+ * @version 0.1
+ * @date 2025-11-15
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ */
+
+//header guard
+#ifndef _GLGE_CORE_GEOMETRY_STRUCTURE_ECS_SCENE_STREAMER_
+#define _GLGE_CORE_GEOMETRY_STRUCTURE_ECS_SCENE_STREAMER_
+
+//include the type definitions
+#include "../../../Types.h"
+//include math stuff (like vectors)
+#include "../../../../GLGE_Math/GLGEMath.h"
+
+/**
+ * @brief store the coordinate of a cell in the cell grid
+ */
+typedef struct s_SceneCellCoord {
+    //the index of the cell on the x axis
+    int32_t x;
+    //the index of the cell on the y axis
+    int32_t y;
+    //the index of the cell on the z axis
+    int32_t z;
+
+    //for C++ add a comparison
+    #if __cplusplus
+
+    /**
+     * @brief compare two cell coordinates
+     * 
+     * @param other the coordinate to compare with
+     * @return true : both coordinates name the same cell
+     * @return false : the coordinates name different cells
+     */
+    inline constexpr bool operator==(const s_SceneCellCoord& other) const noexcept = default;
+
+    #endif
+
+} SceneCellCoord;
+
+/**
+ * @brief store how much work the streamer may do per update
+ */
+typedef struct s_SceneStreamerBudget {
+    //the maximum amount of cells that are loaded in the background at the same time
+    uint32_t maxPendingLoads;
+    //the maximum amount of cell loads that are started per update
+    uint32_t maxLoadsPerUpdate;
+    //the maximum amount of objects that are created or deleted per update. At least one cell is always integrated or unloaded.
+    uint64_t maxObjectsPerUpdate;
+} SceneStreamerBudget;
+
+//the streamer is only available for C++
+#if __cplusplus
+
+//cells are stored as snapshots
+#include "SceneSnapshot.h"
+//cells are loaded through the asset system
+#include "../../../Assets/Assets.h"
+//the cells are stored in a map
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief an asset that reads the snapshot of a single cell from disk
+ */
+class SceneCellAsset final : public BaseAsset
+{
+public:
+
+    /**
+     * @brief Construct a new Scene Cell Asset
+     * 
+     * @param path the path to the snapshot of the cell
+     */
+    SceneCellAsset(const std::filesystem::path& path)
+     : m_path(path)
+    {}
+
+    /**
+     * @brief read the snapshot of the cell
+     */
+    virtual void load() noexcept override;
+
+    /**
+     * @brief access the data of the read snapshot
+     * 
+     * @return std::vector<byte>& the binary data of the snapshot (only valid if the asset is loaded)
+     */
+    inline std::vector<byte>& data() noexcept {return m_data;}
+
+private:
+
+    /**
+     * @brief store the path to the snapshot of the cell
+     */
+    std::filesystem::path m_path;
+    /**
+     * @brief store the binary data of the snapshot
+     */
+    std::vector<byte> m_data;
+
+};
+
+/**
+ * @brief stream the objects of a world that does not fit into memory into a scene
+ * 
+ * The world is stored as one snapshot file per cell of a regular grid. `partition` creates the files from a scene that holds
+ * the whole world (or a part of it), the top level objects are sorted into the cells by their position. While the streamer is
+ * updated, the cells inside the load radius of any observer are read in the background by the asset system and created below
+ * the parent object of the streamer. Cells outside of the unload radius of all observers are deleted again.
+ * 
+ * Streamed objects are not written back, changes made to them are lost when their cell is unloaded. Objects that were deleted
+ * by someone else are skipped when the cell is unloaded, objects that are attached to streamed objects later are re-parented
+ * like for every other deletion.
+ */
+class SceneStreamer {
+public:
+
+    /**
+     * @brief Construct a new Scene Streamer
+     * 
+     * @param scene the scene to stream the objects into
+     * @param directory the directory that contains the snapshots of the cells
+     * @param cellSize the edge length of a single cell
+     * @param parent the object to attach the streamed objects to or NULL to use the root of the scene
+     */
+    SceneStreamer(Scene& scene, const std::filesystem::path& directory, float cellSize, Object parent = NULL) noexcept;
+
+    /**
+     * @brief Destroy the Scene Streamer
+     * 
+     * The loaded objects stay in the scene, background loads are dropped.
+     */
+    ~SceneStreamer() noexcept = default;
+
+    /**
+     * @brief register a component type that is stored in the cells
+     * 
+     * The same components must be registered for partitioning and for streaming.
+     * 
+     * @tparam Component the type of the component. It must be trivially copyable.
+     * @param name a name that identifies the component in the stored data
+     * @return true : the component was registered
+     * @return false : the name is allready used or the maximum amount of components is reached
+     */
+    template <typename Component> inline bool registerComponent(const std::string& name) noexcept
+    {return m_snapshot.registerComponent<Component>(name);}
+
+    /**
+     * @brief write the top level objects of a scene as cells into the directory of the streamer
+     * 
+     * Every top level object is stored together with its children in the cell that contains its position.
+     * All cells the streamer knows about are unloaded and all cell files in the directory are deleted first, so no cell of an
+     * earlier partition is left behind. The streamer knows about the new cells afterwards.
+     * 
+     * @param source the scene that contains the objects to store
+     * @return uint64_t the amount of written cells or 0 if writing failed
+     */
+    uint64_t partition(Scene& source) noexcept;
+
+    /**
+     * @brief add a position around which cells are loaded
+     * 
+     * @param position the position relative to the parent of the streamer
+     * @return uint32_t the identifier of the observer
+     */
+    uint32_t addObserver(const vec3& position) noexcept;
+
+    /**
+     * @brief move an observer
+     * 
+     * @param observer the identifier of the observer
+     * @param position the new position relative to the parent of the streamer
+     */
+    void setObserver(uint32_t observer, const vec3& position) noexcept;
+
+    /**
+     * @brief remove an observer
+     * 
+     * @param observer the identifier of the observer
+     */
+    void removeObserver(uint32_t observer) noexcept;
+
+    /**
+     * @brief set the distances at which cells are loaded and unloaded
+     * 
+     * The unload radius is clamped so it is never smaller than the load radius, so cells at the border don't load and unload
+     * every update.
+     * 
+     * @param loadRadius cells that intersect a sphere with this radius around any observer are loaded
+     * @param unloadRadius cells that don't intersect a sphere with this radius around any observer are unloaded
+     */
+    void setRadius(float loadRadius, float unloadRadius) noexcept;
+
+    /**
+     * @brief set how much work the streamer may do per update
+     * 
+     * @param budget the new budget
+     */
+    inline void setBudget(const SceneStreamerBudget& budget) noexcept {m_budget = budget;}
+
+    /**
+     * @brief get how much work the streamer may do per update
+     * 
+     * @return const SceneStreamerBudget& the current budget
+     */
+    inline const SceneStreamerBudget& getBudget() const noexcept {return m_budget;}
+
+    /**
+     * @brief start and finish loading and unloading cells
+     * 
+     * This must be called from the thread that updates the scene, but not while the systems of the scene run.
+     */
+    void update() noexcept;
+
+    /**
+     * @brief get the cell that contains a position
+     * 
+     * @param position the position relative to the parent of the streamer
+     * @return SceneCellCoord the coordinate of the cell
+     */
+    SceneCellCoord getCell(const vec3& position) const noexcept;
+
+    /**
+     * @brief check if a cell is loaded
+     * 
+     * @param cell the coordinate of the cell
+     * @return true : the objects of the cell are in the scene
+     * @return false : the cell is not loaded or does not exist
+     */
+    bool isLoaded(const SceneCellCoord& cell) const noexcept;
+
+    /**
+     * @brief get the amount of cells whose objects are in the scene
+     * 
+     * @return uint64_t the amount of loaded cells
+     */
+    inline uint64_t getLoadedCellCount() const noexcept {return m_loadedCount;}
+
+    /**
+     * @brief get the amount of cells that are currently read or waiting to be integrated
+     * 
+     * @return uint64_t the amount of pending cells
+     */
+    inline uint64_t getPendingCellCount() const noexcept {return m_pendingCount;}
+
+    /**
+     * @brief get the amount of cells that exist in the directory
+     * 
+     * @return uint64_t the amount of known cells
+     */
+    inline uint64_t getCellCount() const noexcept {return m_cells.size();}
+
+protected:
+
+    /**
+     * @brief store the state of a single cell
+     */
+    struct Cell {
+        //the coordinate of the cell
+        SceneCellCoord coord;
+        //the asset that reads the cell (only valid while the cell is pending)
+        AssetHandle asset;
+        //the handles of the created objects in the stored order (only filled while the cell is loaded)
+        std::vector<ObjectHandle> objects;
+        //the state of the cell
+        enum State : uint8_t {
+            //the cell is not in the scene
+            UNLOADED = 0,
+            //the snapshot of the cell is read in the background
+            PENDING,
+            //the objects of the cell are in the scene
+            LOADED,
+            //the file of the cell could not be read, the cell is not loaded again
+            FAILED
+        } state = UNLOADED;
+    };
+
+    /**
+     * @brief get the path of the snapshot of a cell
+     * 
+     * @param cell the coordinate of the cell
+     * @return std::filesystem::path the path to the file of the cell
+     */
+    std::filesystem::path getCellPath(const SceneCellCoord& cell) const noexcept;
+
+    /**
+     * @brief get the smallest distance between a cell and any observer
+     * 
+     * @param cell the coordinate of the cell
+     * @return float the distance or infinity if there are no observers
+     */
+    float getDistance(const SceneCellCoord& cell) const noexcept;
+
+    /**
+     * @brief pack a cell coordinate into a single key
+     * 
+     * Every axis uses 21 bits, so cells further than about one million cells from the origin share keys.
+     * 
+     * @param cell the coordinate of the cell
+     * @return uint64_t the key of the cell
+     */
+    static inline uint64_t pack(const SceneCellCoord& cell) noexcept 
+    {return ((uint64_t)(cell.x & 0x1FFFFF) << 42) | ((uint64_t)(cell.y & 0x1FFFFF) << 21) | (uint64_t)(cell.z & 0x1FFFFF);}
+
+    /**
+     * @brief delete the objects of a loaded cell
+     * 
+     * @param cell the cell to unload
+     * @return uint64_t the amount of objects that belonged to the cell
+     */
+    uint64_t unload(Cell& cell) noexcept;
+
+    //store the scene the objects are streamed into
+    Scene* m_scene;
+    //store the object the streamed objects are attached to
+    Object m_parent;
+    //store the directory of the cells
+    std::filesystem::path m_directory;
+    //store the edge length of a cell
+    float m_cellSize;
+    //store the radius to load cells in
+    float m_loadRadius;
+    //store the radius outside of which cells are unloaded
+    float m_unloadRadius;
+    //store the budget
+    SceneStreamerBudget m_budget{.maxPendingLoads = 8, .maxLoadsPerUpdate = 4, .maxObjectsPerUpdate = 4096};
+    //store the snapshot that has the registered components
+    SceneSnapshot m_snapshot;
+    //store all known cells by the packed coordinate
+    std::unordered_map<uint64_t, Cell> m_cells;
+    //store the packed coordinates of all pending and loaded cells
+    std::vector<uint64_t> m_active;
+    //store the positions of the observers (the flag is 0 for removed observers)
+    std::vector<std::pair<vec3, byte>> m_observers;
+    //store the amount of loaded cells
+    uint64_t m_loadedCount = 0;
+    //store the amount of pending cells
+    uint64_t m_pendingCount = 0;
+
+};
+
+#endif
+
+#endif
@@ -19,6 +19,11 @@
 //include the mustache ECS
 #include "mustache/ecs/ecs.hpp"
 
+//type indices identify components and systems
+#include <typeindex>
+//vectors store the declared accesses
+#include <vector>
+
 /**
  * @brief a common base class for all systems
  */
@@ -33,6 +38,25 @@ public:
         bool active = true;
     };
 
+    /**
+     * @brief store which components a system reads and writes and which systems must run before or after it
+     * 
+     * Systems that did not declare any access are treated as if they access everything, so they never run at the same
+     * time as another system. 
+     */
+    struct Access {
+        //the components the system only reads
+        std::vector<std::type_index> reads;
+        //the components the system writes
+        std::vector<std::type_index> writes;
+        //the systems that must finish before this system starts
+        std::vector<std::type_index> after;
+        //the systems that may only start after this system finished
+        std::vector<std::type_index> before;
+        //store if any access was declared
+        bool declared = false;
+    };
+
     /**
      * @brief Construct a new ISystem
      * 
@@ -82,8 +106,52 @@ public:
      */
     virtual void execute(mustache::World& world) noexcept = 0;
 
+    /**
+     * @brief get the declared accesses of the system
+     * 
+     * @return const Access& the components the system accesses and the ordering constraints
+     */
+    inline const Access& getAccess() const noexcept {return m_system_access;}
+
 protected:
 
+    /**
+     * @brief declare that the system reads a list of components
+     * 
+     * @tparam Components the components the system reads
+     */
+    template <typename ...Components> inline void readComponents() noexcept 
+    {(m_system_access.reads.emplace_back(typeid(Components)), ...); m_system_access.declared = true;}
+
+    /**
+     * @brief declare that the system writes a list of components
+     * 
+     * @tparam Components the components the system writes
+     */
+    template <typename ...Components> inline void writeComponents() noexcept 
+    {(m_system_access.writes.emplace_back(typeid(Components)), ...); m_system_access.declared = true;}
+
+    /**
+     * @brief declare that the system must run after a list of other systems
+     * 
+     * @tparam Systems the systems that must finish before this system starts
+     */
+    template <class ...Systems> inline void runAfter() noexcept 
+    {(m_system_access.after.emplace_back(typeid(Systems)), ...);}
+
+    /**
+     * @brief declare that the system must run before a list of other systems
+     * 
+     * @tparam Systems the systems that may only start after this system finished
+     */
+    template <class ...Systems> inline void runBefore() noexcept 
+    {(m_system_access.before.emplace_back(typeid(Systems)), ...);}
+
+    /**
+     * @brief store the declared accesses of the system
+     */
+    Access m_system_access;
+
     /**
      * @brief store the settings for the system
      */
@@ -0,0 +1,214 @@
+/**
+ * @file SystemScheduler.cpp
+ * @author DM8AT
+ * @brief implement the dependency graph and the parallel execution of the system scheduler
+ * @version 0.1
+ * @date 2025-11-13
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ */
+
+//include the scheduler
+#include "SystemScheduler.h"
+//systems run on the global thread pool
+#include "../../../Threading/ThreadPool.h"
+
+//for find_if and find_first_of
+#include <algorithm>
+//for error output
+#include <iostream>
+//for the shared run state
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+
+/**
+ * @brief check if two systems may not run at the same time
+ * 
+ * @param a the accesses of the first system
+ * @param b the accesses of the second system
+ * @return true : the systems access the same data and one of them writes it (or one didn't declare its accesses)
+ * @return false : the systems can run at the same time
+ */
+static bool __conflicts(const ISystem::Access& a, const ISystem::Access& b) noexcept {
+    //undeclared systems may access anything
+    if (!a.declared || !b.declared) {return true;}
+    //check if any type of the first list is in the second list
+    auto overlaps = [](const std::vector<std::type_index>& x, const std::vector<std::type_index>& y) 
+    {return std::find_first_of(x.begin(), x.end(), y.begin(), y.end()) != x.end();};
+    return overlaps(a.writes, b.writes) || overlaps(a.writes, b.reads) || overlaps(b.writes, a.reads);
+}
+
+void SystemScheduler::add(ISystem* system, std::type_index type) noexcept {
+    m_entries.push_back(Entry{system, type});
+    m_valid = false;
+}
+
+void SystemScheduler::remove(ISystem* system) noexcept {
+    std::erase_if(m_entries, [system](const Entry& e) {return e.system == system;});
+    m_valid = false;
+}
+
+const std::vector<ISystem*>& SystemScheduler::getOrder() noexcept {
+    if (!m_valid) {build();}
+    return m_order;
+}
+
+void SystemScheduler::build() noexcept {
+    uint32_t count = (uint32_t)m_entries.size();
+
+    //find a system by its type
+    auto indexOf = [this](std::type_index type) -> uint32_t {
+        auto it = std::find_if(m_entries.begin(), m_entries.end(), [type](const Entry& e) {return e.type == type;});
+        return (it == m_entries.end()) ? UINT32_MAX : (uint32_t)(it - m_entries.begin());
+    };
+    //collect the explicit ordering constraints (first must finish before second starts)
+    std::vector<std::pair<uint32_t, uint32_t>> constraints;
+    for (uint32_t i = 0; i < count; ++i) {
+        const ISystem::Access& access = m_entries[i].system->getAccess();
+        for (std::type_index type : access.after) 
+        {if (uint32_t j = indexOf(type); j != UINT32_MAX && j != i) {constraints.emplace_back(j, i);}}
+        for (std::type_index type : access.before) 
+        {if (uint32_t j = indexOf(type); j != UINT32_MAX && j != i) {constraints.emplace_back(i, j);}}
+    }
+
+    //sort the systems by the explicit constraints. The systems are placed in the adding order, but before a system is placed
+    //all systems it has to wait for are placed first, so the order only differs from the adding order where a constraint requires it. 
+    std::vector<uint32_t> position(count, UINT32_MAX);
+    std::vector<bool> visiting(count, false);
+    uint32_t placed = 0;
+    auto place = [&](auto& self, uint32_t idx) -> void {
+        if (position[idx] != UINT32_MAX) {return;}
+        //a system that is visited again before it is placed is part of a cycle
+        if (visiting[idx]) {
+            std::cerr << "[WARNING] The ordering constraints of the systems contain a cycle. Some constraints are ignored.\n";
+            return;
+        }
+        visiting[idx] = true;
+        for (const auto& [first, second] : constraints) 
+        {if (second == idx) {self(self, first);}}
+        visiting[idx] = false;
+        //the system may have been placed while resolving a cycle
+        if (position[idx] == UINT32_MAX) {position[idx] = placed++;}
+    };
+    for (uint32_t i = 0; i < count; ++i) {place(place, i);}
+
+    //store the sorted systems
+    m_order.assign(count, NULL);
+    for (uint32_t i = 0; i < count; ++i) {m_order[position[i]] = m_entries[i].system;}
+
+    //every dependency points from an earlier to a later system of the order, so the graph can't contain cycles
+    std::vector<std::vector<bool>> depends(count, std::vector<bool>(count, false));
+    for (const auto& [first, second] : constraints) 
+    {if (position[first] < position[second]) {depends[position[first]][position[second]] = true;}}
+    for (uint32_t p = 0; p < count; ++p) {
+        for (uint32_t q = p + 1; q < count; ++q) 
+        {if (__conflicts(m_order[p]->getAccess(), m_order[q]->getAccess())) {depends[p][q] = true;}}
+    }
+
+    //store the edges
+    m_successors.assign(count, {});
+    m_dependencies.assign(count, 0);
+    for (uint32_t p = 0; p < count; ++p) {
+        for (uint32_t q = p + 1; q < count; ++q) {
+            if (!depends[p][q]) {continue;}
+            m_successors[p].push_back(q);
+            ++m_dependencies[q];
+        }
+    }
+    m_valid = true;
+}
+
+/**
+ * @brief store the state shared between all threads running the systems of a single `SystemScheduler::run` call
+ * 
+ * It is shared, so late helpers that find no more work never touch freed memory. 
+ */
+struct __SchedulerRun {
+    //the systems in the order of the graph
+    const std::vector<ISystem*>* systems;
+    //the systems that wait for every system
+    const std::vector<std::vector<uint32_t>>* successors;
+    //the world to run the systems on
+    mustache::World* world;
+    //the pool helpers are started on
+    ThreadPool* pool;
+    //the amount of systems
+    uint32_t count;
+    //the amount of unfinished dependencies of every system
+    std::vector<uint32_t> remaining;
+    //the systems that can start
+    std::vector<uint32_t> ready;
+    //the amount of finished systems
+    uint32_t finished = 0;
+    //guards the state and wakes the waiting calling thread
+    std::mutex mutex;
+    std::condition_variable changed;
+};
+
+/**
+ * @brief start systems that are ready
+ * 
+ * Helpers on the pool return as soon as no system is ready, so workers are never parked while systems run in a chain and stay
+ * free for parallel work inside of the systems. Every system that becomes ready gets its own helper. 
+ * 
+ * @param state the shared state of the run
+ * @param wait true : wait till all systems finished (only for the calling thread) | false : return when no system is ready
+ */
+static void __runSystems(const std::shared_ptr<__SchedulerRun>& state, bool wait) noexcept {
+    std::unique_lock lock(state->mutex);
+    while (true) {
+        //the calling thread waits for a system that can start or for the end
+        if (wait) {state->changed.wait(lock, [&]{return !state->ready.empty() || state->finished == state->count;});}
+        if (state->ready.empty()) {return;}
+        uint32_t idx = state->ready.back();
+        state->ready.pop_back();
+
+        //run the system without holding the lock
+        lock.unlock();
+        (*state->systems)[idx]->execute(*state->world);
+        lock.lock();
+
+        //release the systems that waited for this one. This thread continues with one of them, the others get helpers.
+        uint32_t released = 0;
+        for (uint32_t next : (*state->successors)[idx]) {
+            if (--state->remaining[next] != 0) {continue;}
+            state->ready.push_back(next);
+            if (released++ > 0) {state->pool->enqueue([state]() {__runSystems(state, false);});}
+        }
+        ++state->finished;
+        state->changed.notify_all();
+    }
+}
+
+void SystemScheduler::run(mustache::World& world) noexcept {
+    //make sure the graph is up to date
+    if (!m_valid) {build();}
+    uint32_t count = (uint32_t)m_order.size();
+    if (count == 0) {return;}
+
+    //without workers or with a single system, just run them in order
+    ThreadPool& pool = ThreadPool::getGlobal();
+    if (count == 1 || pool.getThreadCount() == 0) {
+        for (ISystem* system : m_order) {system->execute(world);}
+        return;
+    }
+
+    //store the state shared between all threads running systems
+    std::shared_ptr<__SchedulerRun> state = std::make_shared<__SchedulerRun>();
+    state->systems = &m_order;
+    state->successors = &m_successors;
+    state->world = &world;
+    state->pool = &pool;
+    state->count = count;
+    state->remaining = m_dependencies;
+    for (uint32_t i = count; i > 0; --i) 
+    {if (m_dependencies[i-1] == 0) {state->ready.push_back(i-1);}}
+
+    //start one helper per ready system (the calling thread takes one of them itself)
+    for (size_t i = 1; i < state->ready.size(); ++i) 
+    {pool.enqueue([state]() {__runSystems(state, false);});}
+    //work on this thread as well, this returns when all systems finished
+    __runSystems(state, true);
+}
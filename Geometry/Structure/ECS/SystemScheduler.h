@@ -0,0 +1,99 @@
+/**
+ * @file SystemScheduler.h
+ * @author DM8AT
+ * @brief the system scheduler runs the systems of a scene. Systems that don't access the same components run at the same time on the thread pool. 
+ * @version 0.1
+ * @date 2025-11-13
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ */
+
+//header guard
+#ifndef _GLGE_CORE_GEOMETRY_STRUCTURE_ECS_SYSTEM_SCHEDULER_
+#define _GLGE_CORE_GEOMETRY_STRUCTURE_ECS_SYSTEM_SCHEDULER_
+
+//the scheduler is only available for C++
+#if __cplusplus
+
+//include systems
+#include "System.h"
+
+/**
+ * @brief build a dependency graph from the declared accesses of systems and run them on the global thread pool
+ * 
+ * Two systems conflict if one of them writes a component the other one reads or writes, or if one of them didn't declare
+ * its accesses. Conflicting systems run in the order they were added, unless explicit ordering constraints (`runAfter` /
+ * `runBefore`) order them differently. All other systems may run at the same time. The graph is only re-built after the
+ * set of systems changed. 
+ */
+class SystemScheduler {
+public:
+
+    /**
+     * @brief Construct a new System Scheduler
+     */
+    SystemScheduler() = default;
+
+    /**
+     * @brief add a system to the schedule
+     * 
+     * @param system a pointer to the system. The scheduler does not own the system. 
+     * @param type the type of the system, used to resolve the ordering constraints of other systems
+     */
+    void add(ISystem* system, std::type_index type) noexcept;
+
+    /**
+     * @brief remove a system from the schedule
+     * 
+     * @param system a pointer to the system to remove
+     */
+    void remove(ISystem* system) noexcept;
+
+    /**
+     * @brief run all systems once. Returns when all systems finished. 
+     * 
+     * @param world the world to run the systems in
+     */
+    void run(mustache::World& world) noexcept;
+
+    /**
+     * @brief get the systems in the order they are started when running on a single thread
+     * 
+     * @return const std::vector<ISystem*>& a list of all systems where every system comes after all of its dependencies
+     */
+    const std::vector<ISystem*>& getOrder() noexcept;
+
+protected:
+
+    /**
+     * @brief re-build the dependency graph
+     */
+    void build() noexcept;
+
+    /**
+     * @brief store a single system of the schedule
+     */
+    struct Entry {
+        //the system itself
+        ISystem* system;
+        //the type of the system
+        std::type_index type;
+    };
+
+    //store all systems in the order they were added
+    std::vector<Entry> m_entries;
+    //store if the graph matches the systems
+    bool m_valid = false;
+    //store the systems sorted so all dependencies come first
+    std::vector<ISystem*> m_order;
+    //store for every system (in the sorted order) the indices of the systems that depend on it
+    std::vector<std::vector<uint32_t>> m_successors;
+    //store for every system (in the sorted order) the amount of systems it depends on
+    std::vector<uint32_t> m_dependencies;
+
+};
+
+#endif
+
+#endif
@@ -15,6 +15,8 @@
 
 //add transforms
 #include "Transform.h"
+//add cached world transforms
+#include "WorldTransform.h"
 //add entity component systems
 #include "ECS/ECS.h"
 
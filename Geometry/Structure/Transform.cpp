@@ -1,7 +1,7 @@
 /**
  * @file Transform.cpp
  * @author DM8AT
- * @brief implement the C binding for the transform
+ * @brief implement the batched matrix computation and the C binding for the transform
  * @version 0.1
  * @date 2025-10-11
  * 
@@ -12,6 +12,234 @@
 //include the transform API
 #include "Transform.h"
 
+//include intrinsics for the vectorized matrix computation
+#if defined(__AVX512F__) || defined(__AVX2__)
+    #include <immintrin.h>
+#endif
+
+//for offsetof
+#include <cstddef>
+
+//the kernel reads the transforms and writes the matrices as flat float arrays
+static_assert(sizeof(mat4) == sizeof(float)*16, "A matrix must consist of exactly 16 floats");
+static_assert(sizeof(Transform) % sizeof(float) == 0, "A transform must consist of floats only");
+
+//the offsets of the 10 inputs of the matrix computation in floats: position, rotation (w, i, j, k) and scale
+static const int32_t __TRANSFORM_INPUTS[10] = {
+    (int32_t)((offsetof(Transform, pos) + offsetof(vec3, x)) / sizeof(float)),
+    (int32_t)((offsetof(Transform, pos) + offsetof(vec3, y)) / sizeof(float)),
+    (int32_t)((offsetof(Transform, pos) + offsetof(vec3, z)) / sizeof(float)),
+    (int32_t)((offsetof(Transform, rot) + offsetof(Quaternion, w)) / sizeof(float)),
+    (int32_t)((offsetof(Transform, rot) + offsetof(Quaternion, i)) / sizeof(float)),
+    (int32_t)((offsetof(Transform, rot) + offsetof(Quaternion, j)) / sizeof(float)),
+    (int32_t)((offsetof(Transform, rot) + offsetof(Quaternion, k)) / sizeof(float)),
+    (int32_t)((offsetof(Transform, scale) + offsetof(vec3, x)) / sizeof(float)),
+    (int32_t)((offsetof(Transform, scale) + offsetof(vec3, y)) / sizeof(float)),
+    (int32_t)((offsetof(Transform, scale) + offsetof(vec3, z)) / sizeof(float))
+};
+//the distance between two transforms in floats
+static constexpr int32_t __TRANSFORM_STRIDE = (int32_t)(sizeof(Transform) / sizeof(float));
+
+/*
+ * The matrices are computed in a structure-of-arrays layout: every register holds the same input or matrix component
+ * of 16 (AVX-512) or 8 (AVX2) transforms. The inputs are gathered from the transforms, all 16 components are computed
+ * with the same formulas as the scalar fallback and the resulting registers are transposed, so every register holds
+ * a whole matrix (AVX-512) or half a matrix (AVX2) that is stored at once. The last block uses masked gathers and only
+ * stores the used matrices, so no scalar tail is needed.
+ */
+
+//scalar helpers, so the component formulas can be shared between all paths
+static inline float __add(float a, float b) noexcept {return a + b;}
+static inline float __sub(float a, float b) noexcept {return a - b;}
+static inline float __mul(float a, float b) noexcept {return a * b;}
+
+#if defined(__AVX512F__)
+static inline __m512 __add(__m512 a, __m512 b) noexcept {return _mm512_add_ps(a, b);}
+static inline __m512 __sub(__m512 a, __m512 b) noexcept {return _mm512_sub_ps(a, b);}
+static inline __m512 __mul(__m512 a, __m512 b) noexcept {return _mm512_mul_ps(a, b);}
+#endif
+
+#if defined(__AVX2__)
+static inline __m256 __add(__m256 a, __m256 b) noexcept {return _mm256_add_ps(a, b);}
+static inline __m256 __sub(__m256 a, __m256 b) noexcept {return _mm256_sub_ps(a, b);}
+static inline __m256 __mul(__m256 a, __m256 b) noexcept {return _mm256_mul_ps(a, b);}
+#endif
+
+/**
+ * @brief compute the 16 components of transformation matrices (same as Transform::getTransformMatrix)
+ * 
+ * @tparam V the type that stores the values of one or multiple transforms
+ * @param in the inputs: position x, y, z, rotation w, i, j, k and scale x, y, z
+ * @param zero a value with all elements set to 0
+ * @param one a value with all elements set to 1
+ * @param two a value with all elements set to 2
+ * @param out the 16 matrix components in row-major order
+ */
+template <typename V>
+static inline void __transformComponents(const V* in, V zero, V one, V two, V* out) noexcept {
+    //pre-compute the doubled quaternion products
+    V i2 = __mul(in[4], two), j2 = __mul(in[5], two), k2 = __mul(in[6], two);
+    V ii = __mul(in[4], i2), jj = __mul(in[5], j2), kk = __mul(in[6], k2);
+    V ij = __mul(in[4], j2), ik = __mul(in[4], k2), jk = __mul(in[5], k2);
+    V iw = __mul(in[3], i2), jw = __mul(in[3], j2), kw = __mul(in[3], k2);
+
+    //(scale * rotation) * position
+    out[0]  = __mul(in[7], __sub(one, __add(jj, kk)));
+    out[1]  = __mul(in[7], __sub(ij, kw));
+    out[2]  = __mul(in[7], __add(ik, jw));
+    out[3]  = in[0];
+    out[4]  = __mul(in[8], __add(ij, kw));
+    out[5]  = __mul(in[8], __sub(one, __add(ii, kk)));
+    out[6]  = __mul(in[8], __sub(jk, iw));
+    out[7]  = in[1];
+    out[8]  = __mul(in[9], __sub(ik, jw));
+    out[9]  = __mul(in[9], __add(jk, iw));
+    out[10] = __mul(in[9], __sub(one, __add(ii, jj)));
+    out[11] = in[2];
+    out[12] = zero;
+    out[13] = zero;
+    out[14] = zero;
+    out[15] = one;
+}
+
+#if defined(__AVX512F__)
+
+/**
+ * @brief compute the matrices of up to 16 transforms
+ * 
+ * @param transforms a pointer to the first transform
+ * @param count the amount of transforms to convert (at most 16)
+ * @param matrices a pointer to the first matrix to write
+ */
+static inline void __transformMatrices(const Transform* transforms, uint64_t count, mat4* matrices) noexcept {
+    //gather the inputs, unused lanes are set to 0
+    const __mmask16 mask = (count >= 16) ? (__mmask16)0xFFFF : (__mmask16)((1u << count) - 1);
+    const __m512i index = _mm512_mullo_epi32(_mm512_setr_epi32(0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15), _mm512_set1_epi32(__TRANSFORM_STRIDE));
+    const float* base = (const float*)transforms;
+    __m512 in[10];
+    for (uint32_t i = 0; i < 10; ++i) 
+    {in[i] = _mm512_mask_i32gather_ps(_mm512_setzero_ps(), mask, index, base + __TRANSFORM_INPUTS[i], sizeof(float));}
+
+    //compute the components
+    __m512 c[16];
+    __transformComponents(in, _mm512_setzero_ps(), _mm512_set1_ps(1.f), _mm512_set1_ps(2.f), c);
+
+    //transpose the 4x4 blocks inside the 128 bit lanes
+    __m512 a[16], b[16];
+    for (uint32_t i = 0; i < 8; ++i) {
+        a[2*i]   = _mm512_unpacklo_ps(c[2*i], c[2*i+1]);
+        a[2*i+1] = _mm512_unpackhi_ps(c[2*i], c[2*i+1]);
+    }
+    for (uint32_t i = 0; i < 16; i += 4) {
+        b[i]   = _mm512_shuffle_ps(a[i],   a[i+2], 0x44);
+        b[i+1] = _mm512_shuffle_ps(a[i],   a[i+2], 0xEE);
+        b[i+2] = _mm512_shuffle_ps(a[i+1], a[i+3], 0x44);
+        b[i+3] = _mm512_shuffle_ps(a[i+1], a[i+3], 0xEE);
+    }
+    //now lane l of b[4*r + q] holds the components 4*r to 4*r+3 of the transform 4*l + q. Move the lanes together.
+    float* out = (float*)matrices;
+    for (uint32_t q = 0; q < 4; ++q) {
+        __m512 lo = _mm512_shuffle_f32x4(b[q], b[4+q], 0x88);
+        __m512 hi = _mm512_shuffle_f32x4(b[8+q], b[12+q], 0x88);
+        __m512 loOdd = _mm512_shuffle_f32x4(b[q], b[4+q], 0xDD);
+        __m512 hiOdd = _mm512_shuffle_f32x4(b[8+q], b[12+q], 0xDD);
+        if (q < count)    {_mm512_storeu_ps(out + 16*q,      _mm512_shuffle_f32x4(lo, hi, 0x88));}
+        if (4+q < count)  {_mm512_storeu_ps(out + 16*(4+q),  _mm512_shuffle_f32x4(loOdd, hiOdd, 0x88));}
+        if (8+q < count)  {_mm512_storeu_ps(out + 16*(8+q),  _mm512_shuffle_f32x4(lo, hi, 0xDD));}
+        if (12+q < count) {_mm512_storeu_ps(out + 16*(12+q), _mm512_shuffle_f32x4(loOdd, hiOdd, 0xDD));}
+    }
+}
+
+//the amount of transforms processed at once
+static constexpr uint64_t __TRANSFORM_BLOCK = 16;
+
+#elif defined(__AVX2__)
+
+/**
+ * @brief transpose 8 registers that each hold a single component of 8 transforms and store the components per transform
+ * 
+ * @param c the 8 registers to transpose
+ * @param count the amount of transforms to store (at most 8)
+ * @param out a pointer to the first float to write. The floats of one transform are stored 16 floats apart.
+ */
+static inline void __transposeStore(const __m256* c, uint64_t count, float* out) noexcept {
+    //transpose the 4x4 blocks inside the 128 bit lanes
+    __m256 a[8], b[8];
+    for (uint32_t i = 0; i < 4; ++i) {
+        a[2*i]   = _mm256_unpacklo_ps(c[2*i], c[2*i+1]);
+        a[2*i+1] = _mm256_unpackhi_ps(c[2*i], c[2*i+1]);
+    }
+    for (uint32_t i = 0; i < 8; i += 4) {
+        b[i]   = _mm256_shuffle_ps(a[i],   a[i+2], 0x44);
+        b[i+1] = _mm256_shuffle_ps(a[i],   a[i+2], 0xEE);
+        b[i+2] = _mm256_shuffle_ps(a[i+1], a[i+3], 0x44);
+        b[i+3] = _mm256_shuffle_ps(a[i+1], a[i+3], 0xEE);
+    }
+    //now lane l of b[4*r + q] holds the components 4*r to 4*r+3 of the transform 4*l + q. Move the lanes together.
+    for (uint32_t q = 0; q < 4; ++q) {
+        if (q < count)   {_mm256_storeu_ps(out + 16*q,     _mm256_permute2f128_ps(b[q], b[4+q], 0x20));}
+        if (4+q < count) {_mm256_storeu_ps(out + 16*(4+q), _mm256_permute2f128_ps(b[q], b[4+q], 0x31));}
+    }
+}
+
+/**
+ * @brief compute the matrices of up to 8 transforms
+ * 
+ * @param transforms a pointer to the first transform
+ * @param count the amount of transforms to convert (at most 8)
+ * @param matrices a pointer to the first matrix to write
+ */
+static inline void __transformMatrices(const Transform* transforms, uint64_t count, mat4* matrices) noexcept {
+    //gather the inputs, unused lanes are set to 0
+    const __m256i lanes = _mm256_setr_epi32(0,1,2,3,4,5,6,7);
+    const __m256 mask = _mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_set1_epi32((int32_t)((count >= 8) ? 8 : count)), lanes));
+    const __m256i index = _mm256_mullo_epi32(lanes, _mm256_set1_epi32(__TRANSFORM_STRIDE));
+    const float* base = (const float*)transforms;
+    __m256 in[10];
+    for (uint32_t i = 0; i < 10; ++i) 
+    {in[i] = _mm256_mask_i32gather_ps(_mm256_setzero_ps(), base + __TRANSFORM_INPUTS[i], index, mask, sizeof(float));}
+
+    //compute the components
+    __m256 c[16];
+    __transformComponents(in, _mm256_setzero_ps(), _mm256_set1_ps(1.f), _mm256_set1_ps(2.f), c);
+
+    //store the first and the second half of every matrix
+    __transposeStore(c, count, (float*)matrices);
+    __transposeStore(c + 8, count, (float*)matrices + 8);
+}
+
+//the amount of transforms processed at once
+static constexpr uint64_t __TRANSFORM_BLOCK = 8;
+
+#else
+
+/**
+ * @brief compute the matrix of a single transform
+ * 
+ * @param transforms a pointer to the transform
+ * @param count unused, always 1
+ * @param matrices a pointer to the matrix to write
+ */
+static inline void __transformMatrices(const Transform* transforms, uint64_t, mat4* matrices) noexcept {
+    //read the inputs
+    const float* base = (const float*)transforms;
+    float in[10];
+    for (uint32_t i = 0; i < 10; ++i) {in[i] = base[__TRANSFORM_INPUTS[i]];}
+    //compute the components directly into the matrix
+    __transformComponents(in, 0.f, 1.f, 2.f, (float*)matrices);
+}
+
+//the amount of transforms processed at once
+static constexpr uint64_t __TRANSFORM_BLOCK = 1;
+
+#endif
+
+void s_Transform::getTransformMatrices(const s_Transform* transforms, uint64_t count, mat4* matrices) noexcept {
+    //process full blocks, the last block may be partial
+    for (uint64_t i = 0; i < count; i += __TRANSFORM_BLOCK) 
+    {__transformMatrices(transforms + i, count - i, matrices + i);}
+}
+
 mat4 transform_GetPositionMatrix(const Transform* transform) {return transform->getPositionMatrix();}
 
 mat4 transform_GetRotationMatrix(const Transform* transform) {return transform->getRotationMatrix();}
@@ -19,3 +247,5 @@ mat4 transform_GetRotationMatrix(const Transform* transform) {return transform->
 mat4 transform_GetScaleMatrix(const Transform* transform) {return transform->getScaleMatrix();}
 
 mat4 transform_GetTransformMatrix(const Transform* transform) {return transform->getTransformMatrix();}
+
+void transform_GetTransformMatrices(const Transform* transforms, uint64_t count, mat4* matrices) {Transform::getTransformMatrices(transforms, count, matrices);}
@@ -13,6 +13,8 @@
 #ifndef _GLGE_CORE_GEOMETRY_STRUCTURE_TRANSFORM_
 #define _GLGE_CORE_GEOMETRY_STRUCTURE_TRANSFORM_
 
+//include the type definitions
+#include "../../Types.h"
 //include math stuff (like vectors and quaternions)
 #include "../../../GLGE_Math/GLGEMath.h"
 
@@ -111,6 +113,18 @@ typedef struct s_Transform {
         );
     }
 
+    /**
+     * @brief compute the transformation matrices of a lot of transforms at once
+     * 
+     * The matrices are the same as the ones from `getTransformMatrix`, but they are computed in single precision. With AVX-512 16
+     * transforms and with AVX2 8 transforms are processed at once. The transforms are read in the same layout the scene stores them in. 
+     * 
+     * @param transforms a pointer to the transforms to convert
+     * @param count the amount of transforms to convert
+     * @param matrices a pointer to an array of at least `count` matrices to write the results to
+     */
+    static void getTransformMatrices(const s_Transform* transforms, uint64_t count, mat4* matrices) noexcept;
+
     #endif
 
 } Transform;
@@ -152,6 +166,15 @@ mat4 transform_GetScaleMatrix(const Transform* transform);
  */
 mat4 transform_GetTransformMatrix(const Transform* transform);
 
+/**
+ * @brief get the transformation matrices of a lot of transform objects at once
+ * 
+ * @param transforms a pointer to the transform objects to quarry the transformation matrices from
+ * @param count the amount of transform objects
+ * @param matrices a pointer to an array of at least `count` matrices to write the transformation matrices to
+ */
+void transform_GetTransformMatrices(const Transform* transforms, uint64_t count, mat4* matrices);
+
 //end the C section
 #if __cplusplus
 }
@@ -0,0 +1,57 @@
+/**
+ * @file WorldTransform.h
+ * @author DM8AT
+ * @brief a world transform caches the matrix that moves an object from its local space into the space of the scene. It is maintained by the scene.
+ * @version 0.1
+ * @date 2025-11-12
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ */
+
+//header guard
+#ifndef _GLGE_CORE_GEOMETRY_STRUCTURE_WORLD_TRANSFORM_
+#define _GLGE_CORE_GEOMETRY_STRUCTURE_WORLD_TRANSFORM_
+
+//include the type definitions
+#include "../../Types.h"
+//include math stuff (like vectors and matrices)
+#include "../../../GLGE_Math/GLGEMath.h"
+
+/**
+ * @brief store the cached world space matrix of an object
+ * 
+ * The matrix is the product of the transformation matrices of all parents and the transformation matrix of the object itself.
+ * It is only updated by the scene, so it is only valid after the scene was updated once since the last change of a local transform.
+ */
+typedef struct s_WorldTransform {
+    //store the matrix that moves from object space to world space
+    mat4 matrix;
+    //store if the matrix needs to be re-computed (1) or is up to date (0). Only written by the scene.
+    byte dirty;
+
+    //for C++ add non-virtual member functions
+    #if __cplusplus
+
+    /**
+     * @brief Construct a new World Transform
+     * 
+     * The matrix is initialized to identity. The scene marks the transform as dirty when the object is created.
+     */
+    inline s_WorldTransform()
+     : matrix(1,0,0,0, 0,1,0,0, 0,0,1,0, 0,0,0,1), dirty(0)
+    {}
+
+    /**
+     * @brief Get the position of the object in world space
+     * 
+     * @return vec3 the world space position
+     */
+    inline vec3 getPosition() const noexcept
+    {return vec3(matrix.m[3], matrix.m[7], matrix.m[11]);}
+
+    #endif
+
+} WorldTransform;
+
+#endif
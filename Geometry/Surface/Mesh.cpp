@@ -16,186 +16,996 @@
 #include "../Volumes/AABB.h"
 #include "../Volumes/Sphere.h"
 
+//include the thread pool for parallel processing
+#include "../../Threading/ThreadPool.h"
+
 //include memory management stuff
 #include <cstring>
+//hash maps are used to find equal vertices
+#include <unordered_map>
+//for rounding during quantization
+#include <cmath>
+//for minimum and maximum
+#include <algorithm>
+
+/**
+ * @brief copy a strided range of elements with a fixed size
+ * 
+ * The fixed size lets the compiler replace the memcpy with plain loads and stores
+ * 
+ * @tparam Size the size of a single element in bytes
+ * @param src a pointer to the first source element
+ * @param srcStride the distance between two source elements in bytes
+ * @param dst a pointer to the first destination element
+ * @param dstStride the distance between two destination elements in bytes
+ * @param count the amount of elements to copy
+ */
+template <uint64_t Size>
+static inline void __copyElements(const uint8_t* src, uint64_t srcStride, uint8_t* dst, uint64_t dstStride, uint64_t count) noexcept {
+    for (uint64_t i = 0; i < count; ++i) 
+    {memcpy(dst + i*dstStride, src + i*srcStride, Size);}
+}
 
-Mesh::Mesh(void* vertices, uint64_t vertexCount, const VertexLayout& layout, index_t* indices, uint64_t indexCount)
- : m_layout(layout), m_vertexCount(vertexCount), m_vertices(new uint8_t[vertexCount * m_layout.m_size])
+/**
+ * @brief copy a strided range of elements
+ * 
+ * @param src a pointer to the first source element
+ * @param srcStride the distance between two source elements in bytes
+ * @param dst a pointer to the first destination element
+ * @param dstStride the distance between two destination elements in bytes
+ * @param count the amount of elements to copy
+ * @param size the size of a single element in bytes
+ */
+static void __copyElements(const uint8_t* src, uint64_t srcStride, uint8_t* dst, uint64_t dstStride, uint64_t count, uint64_t size) noexcept {
+    //dispatch the common element sizes to the fixed size copies
+    switch (size)
+    {
+    case 4: __copyElements<4>(src, srcStride, dst, dstStride, count); break;
+    case 8: __copyElements<8>(src, srcStride, dst, dstStride, count); break;
+    case 12: __copyElements<12>(src, srcStride, dst, dstStride, count); break;
+    case 16: __copyElements<16>(src, srcStride, dst, dstStride, count); break;
+    default:
+        //fall back to a generic copy for all other sizes
+        for (uint64_t i = 0; i < count; ++i) 
+        {memcpy(dst + i*dstStride, src + i*srcStride, size);}
+        break;
+    }
+}
+
+/**
+ * @brief store how a single element of all vertices can be accessed
+ */
+struct __ElementAccess {
+    //a pointer to the element of the first vertex
+    uint8_t* base = nullptr;
+    //the distance between the element of two vertices in bytes
+    uint64_t stride = 0;
+    //the size of the element in bytes
+    uint64_t size = 0;
+    //the size of a single floating point component in bytes or 0 if the element is not a floating point type
+    uint64_t floatSize = 0;
+};
+
+/**
+ * @brief get the size of a single component of a floating point data type
+ * 
+ * @param type the data type to check
+ * @return uint64_t the size of a component in bytes or 0 if the data type is not a floating point type
+ */
+static inline uint64_t __floatComponentSize(VertexElementDataType type) noexcept {
+    switch (type)
+    {
+    case VERTEX_ELEMENT_DATA_TYPE_HALF:
+    case VERTEX_ELEMENT_DATA_TYPE_HALF_VEC2:
+    case VERTEX_ELEMENT_DATA_TYPE_HALF_VEC3:
+    case VERTEX_ELEMENT_DATA_TYPE_HALF_VEC4:
+        return 2;
+    case VERTEX_ELEMENT_DATA_TYPE_FLOAT:
+    case VERTEX_ELEMENT_DATA_TYPE_FLOAT_VEC2:
+    case VERTEX_ELEMENT_DATA_TYPE_FLOAT_VEC3:
+    case VERTEX_ELEMENT_DATA_TYPE_FLOAT_VEC4:
+        return 4;
+    case VERTEX_ELEMENT_DATA_TYPE_DOUBLE:
+    case VERTEX_ELEMENT_DATA_TYPE_DOUBLE_VEC2:
+    case VERTEX_ELEMENT_DATA_TYPE_DOUBLE_VEC3:
+    case VERTEX_ELEMENT_DATA_TYPE_DOUBLE_VEC4:
+        return 8;
+    default:
+        return 0;
+    }
+}
+
+/**
+ * @brief get the access information for a single element of a vertex buffer
+ * 
+ * @param vertices a pointer to the vertex buffer
+ * @param vertexCount the amount of vertices in the buffer
+ * @param layout the layout of a single vertex
+ * @param storage the way the vertices are arranged in memory
+ * @param idx the index of the element in the layout
+ * @return __ElementAccess the information required to access the element of any vertex
+ */
+static inline __ElementAccess __getElementAccess(void* vertices, uint64_t vertexCount, const VertexLayout& layout, VertexStorageMode storage, uint64_t idx) noexcept {
+    __ElementAccess access;
+    access.size = layout.getElementSize(idx);
+    access.floatSize = __floatComponentSize(layout.m_elements[idx].data);
+    //the start and the stride depend on the storage mode
+    if (storage == VERTEX_STORAGE_MODE_SEPARATE) {
+        access.base = ((uint8_t*)vertices) + layout.getStreamOffsetOf(idx, vertexCount);
+        access.stride = access.size;
+    } else {
+        access.base = ((uint8_t*)vertices) + layout.getOffsetOf(idx);
+        access.stride = layout.m_size;
+    }
+    return access;
+}
+
+/**
+ * @brief snap a single floating point component to a grid
+ * 
+ * @param ptr a pointer to the component
+ * @param floatSize the size of the component in bytes
+ * @param invEpsilon the inverse of the grid cell size
+ * @return int64_t the index of the grid cell the component falls into
+ */
+static inline int64_t __quantizeComponent(const uint8_t* ptr, uint64_t floatSize, double invEpsilon) noexcept {
+    //read the component as a double
+    double value = 0.;
+    switch (floatSize)
+    {
+    case 2: {half v; memcpy(&v, ptr, sizeof(v)); value = (double)(float)v; break;}
+    case 4: {float v; memcpy(&v, ptr, sizeof(v)); value = (double)v; break;}
+    default: {memcpy(&value, ptr, sizeof(value)); break;}
+    }
+    //snap to the closest cell (this also merges +0 and -0)
+    return (int64_t)std::floor(value * invEpsilon + 0.5);
+}
+
+/**
+ * @brief mix a new value into a hash
+ * 
+ * @param hash the current hash
+ * @param value the value to add
+ * @return uint64_t the new hash
+ */
+static inline uint64_t __hashMix(uint64_t hash, uint64_t value) noexcept {
+    hash ^= value * 0x9E3779B97F4A7C15ull;
+    hash = (hash << 31) | (hash >> 33);
+    return hash * 0xBF58476D1CE4E5B9ull;
+}
+
+/**
+ * @brief convert indices from one index type to another
+ * 
+ * @param src a pointer to the indices to convert
+ * @param srcType the type of the source indices
+ * @param dst a pointer to the buffer to write the converted indices to (may be the source if the types are equal)
+ * @param dstType the type of the converted indices
+ * @param count the amount of indices to convert
+ */
+static void __convertIndices(const void* src, IndexType srcType, void* dst, IndexType dstType, uint64_t count) noexcept {
+    //equal types are just copied
+    if (srcType == dstType) {
+        if (src != dst) {memcpy(dst, src, count * (uint64_t)srcType);}
+        return;
+    }
+    //widen or narrow every index
+    if (srcType == INDEX_TYPE_UINT16) {
+        for (uint64_t i = 0; i < count; ++i) {((uint32_t*)dst)[i] = ((const uint16_t*)src)[i];}
+    } else {
+        for (uint64_t i = 0; i < count; ++i) {((uint16_t*)dst)[i] = (uint16_t)((const uint32_t*)src)[i];}
+    }
+}
+
+Mesh::Mesh(const void* vertices, uint64_t vertexCount, const VertexLayout& layout, const void* indices, uint64_t indexCount, IndexType indexType, VertexStorageMode storage)
+ : m_layout(layout), m_storage(storage), m_vertexCount(vertexCount), m_vertices(MeshBuffer::allocate(vertexCount * m_layout.m_size)), m_indexType(getIndexTypeFor(vertexCount))
 {
     //allocate the internal vertex buffer
-    if (!m_vertices) {
+    if (!m_vertices.data() && ((m_vertexCount * m_layout.m_size) > 0)) {
         //error - allocation failed
         printf("[ERROR] Failed to allocate the the vertex buffer for a mesh. Requested size: %lu bytes\n", m_vertexCount * m_layout.m_size);
         return;
     }
     //copy the data over
-    memcpy(m_vertices, vertices, m_vertexCount * m_layout.m_size);
+    if (m_vertices.data()) {memcpy(m_vertices.data(), vertices, m_vertexCount * m_layout.m_size);}
 
-    //resize the index buffer and copy the data over
-    m_indices.resize(indexCount);
-    memcpy(m_indices.data(), indices, m_indices.size() * sizeof(index_t));
+    //allocate the index buffer and copy the data over using the smallest fitting index type
+    m_indices = MeshBuffer::allocate(indexCount * (uint64_t)m_indexType);
+    if (indexCount) {__convertIndices(indices, indexType, m_indices.data(), m_indexType, indexCount);}
 }
 
-Mesh::~Mesh()
+Mesh::Mesh(MeshBuffer&& vertices, uint64_t vertexCount, const VertexLayout& layout, MeshBuffer&& indices, IndexType indexType, VertexStorageMode storage) noexcept
+ : m_layout(layout), m_storage(storage), m_vertexCount(vertexCount), m_vertices(std::move(vertices)), m_indexType(indexType), m_indices(std::move(indices))
 {
-    //if the vertices exist, delete the array
-    if (m_vertices) {
-        delete[] (uint8_t*)m_vertices;
-        m_vertices = NULL;
+    //the buffer must be large enough for all vertices
+    if (m_vertices.size() < m_vertexCount * m_layout.m_size) {
+        printf("[ERROR] The vertex buffer of a mesh is too small: %lu bytes are required but only %lu bytes are given\n", m_vertexCount * m_layout.m_size, m_vertices.size());
+        m_vertices = MeshBuffer();
+        m_indices = MeshBuffer();
+        m_vertexCount = 0;
     }
 }
 
-template <> AABB Mesh::getBoundingVolume<AABB>() const noexcept {
-    //store the AABB to return
-    AABB ret;
-    //calculate the offset of the position element
-    uint64_t idx = m_layout.getIndexOfElement(VERTEX_ELEMENT_TYPE_POSITION);
-    //if no position exists, what?
-    if (idx == UINT64_MAX) {return AABB{};}
-    //get the offset in bytes of the element
-    uint64_t offs = m_layout.getOffsetOf(idx);
-    //get the type of the element
-    VertexElementDataType dat = m_layout.m_elements[idx].data;
-    //iterate over all vertices (indices are not important, only positions matter)
-    for (size_t i = 0; i < m_vertexCount; ++i) {
-        //get the element position
-        uint8_t* pos_ptr = &(((uint8_t*)m_vertices)[i*m_layout.m_size + offs]);
-
-        //store the position as a 3D vector
-        vec3 pos;
-        switch (dat)
-        {
-            case VERTEX_ELEMENT_DATA_TYPE_INT8:
-            {
-                int32_t v = *((int8_t*)pos_ptr);
-                pos = vectorCast<vec3>(v);
-                break;
-            }
-            case VERTEX_ELEMENT_DATA_TYPE_UINT8:
-            {
-                uint32_t v = *((uint8_t*)pos_ptr);
-                pos = vectorCast<vec3>(v);
-                break;
-            }
-            case VERTEX_ELEMENT_DATA_TYPE_INT16:
-            {
-                int32_t v = *((int16_t*)pos_ptr);
-                pos = vectorCast<vec3>(v);
-                break;
-            }
-            case VERTEX_ELEMENT_DATA_TYPE_UINT16:
-            {
-                uint32_t v = *((uint16_t*)pos_ptr);
-                pos = vectorCast<vec3>(v);
-                break;
-            }
-            case VERTEX_ELEMENT_DATA_TYPE_INT32:
-            {
-                int32_t v = *((int32_t*)pos_ptr);
-                pos = vectorCast<vec3>(v);
-                break;
-            }
-            case VERTEX_ELEMENT_DATA_TYPE_UINT32:
-            {
-                uint32_t v = *((uint32_t*)pos_ptr);
-                pos = vectorCast<vec3>(v);
-                break;
-            }
-            case VERTEX_ELEMENT_DATA_TYPE_FLOAT:
-            {
-                float v = *((float*)pos_ptr);
-                pos = vectorCast<vec3>(v);
-                break;
-            }
-            case VERTEX_ELEMENT_DATA_TYPE_DOUBLE:
-            {
-                double v = *((double*)pos_ptr);
-                pos = vectorCast<vec3>(v);
-                break;
-            }
-            case VERTEX_ELEMENT_DATA_TYPE_FLOAT_VEC2:
-            {
-                float* v = (float*)pos_ptr;
-                pos = vectorCast<vec3>(vec2(v[0], v[1]));
-                break;
-            }
-            case VERTEX_ELEMENT_DATA_TYPE_FLOAT_VEC3:
-            {
-                pos = *((vec3*)pos_ptr);
-                break;
-            }
-            case VERTEX_ELEMENT_DATA_TYPE_FLOAT_VEC4:
-            {
-                float* v = (float*)pos_ptr;
-                pos = vectorCast<vec3>(vec4(v[0], v[1], v[2], v[3]));
-                break;
-            }
-            case VERTEX_ELEMENT_DATA_TYPE_DOUBLE_VEC2:
-            {
-                double* v = (double*)pos_ptr;
-                pos = vectorCast<vec3>(vec2((float)v[0], (float)v[1]));
-                break;
+bool Mesh::setIndexType(IndexType type) noexcept
+{
+    //nothing to do
+    if (type == m_indexType) {return true;}
+    //check if all vertices can be addressed
+    if ((type == INDEX_TYPE_UINT16) && (getIndexTypeFor(m_vertexCount) != INDEX_TYPE_UINT16)) {return false;}
+
+    //convert the indices to a new buffer
+    uint64_t count = getIndexCount();
+    MeshBuffer converted = MeshBuffer::allocate(count * (uint64_t)type);
+    if (count) {__convertIndices(m_indices.data(), m_indexType, converted.data(), type, count);}
+    m_indices = std::move(converted);
+    m_indexType = type;
+    return true;
+}
+
+void Mesh::setStorageMode(VertexStorageMode mode) noexcept
+{
+    //if the mode is allready set, nothing needs to happen
+    if (mode == m_storage) {return;}
+    //without vertices only the mode needs to be stored
+    if (m_vertices.empty() || (m_vertexCount == 0)) {
+        m_storage = mode;
+        return;
+    }
+
+    //the conversion can't happen in place, so create a new buffer to re-arrange into
+    //referenced memory is never modified, the mesh just switches to the new, owned buffer
+    MeshBuffer converted = MeshBuffer::allocate(m_vertexCount * m_layout.m_size);
+    if (mode == VERTEX_STORAGE_MODE_SEPARATE)
+    {deinterleave(m_vertices.data(), converted.data(), m_vertexCount, m_layout);}
+    else
+    {interleave(m_vertices.data(), converted.data(), m_vertexCount, m_layout);}
+
+    //swap the buffers and store the new mode
+    m_vertices = std::move(converted);
+    m_storage = mode;
+}
+
+const void* Mesh::getElementStream(VertexElementType type) const noexcept
+{
+    //streams only exist for separate storage
+    if ((m_storage != VERTEX_STORAGE_MODE_SEPARATE) || m_vertices.empty()) {return NULL;}
+    //get the element
+    uint64_t idx = m_layout.getIndexOfElement(type);
+    if (idx == UINT64_MAX) {return NULL;}
+    //the stream starts behind all streams of the previous elements
+    return m_vertices.data() + m_layout.getStreamOffsetOf(idx, m_vertexCount);
+}
+
+void Mesh::deinterleave(const void* src, void* dst, uint64_t vertexCount, const VertexLayout& layout) noexcept
+{
+    //iterate over all elements and scatter them into their own streams
+    for (uint64_t i = 0; i < VERTEX_ELEMENT_TYPE_COUNT; ++i) {
+        //skip empty elements
+        uint64_t size = layout.getElementSize(i);
+        if (size == 0) {continue;}
+        //copy the element from all vertices to the stream
+        __copyElements(((const uint8_t*)src) + layout.getOffsetOf(i), layout.m_size, 
+                       ((uint8_t*)dst) + layout.getStreamOffsetOf(i, vertexCount), size, vertexCount, size);
+    }
+}
+
+void Mesh::interleave(const void* src, void* dst, uint64_t vertexCount, const VertexLayout& layout) noexcept
+{
+    //iterate over all elements and gather them from their streams
+    for (uint64_t i = 0; i < VERTEX_ELEMENT_TYPE_COUNT; ++i) {
+        //skip empty elements
+        uint64_t size = layout.getElementSize(i);
+        if (size == 0) {continue;}
+        //copy the element from the stream into all vertices
+        __copyElements(((const uint8_t*)src) + layout.getStreamOffsetOf(i, vertexCount), size, 
+                       ((uint8_t*)dst) + layout.getOffsetOf(i), layout.m_size, vertexCount, size);
+    }
+}
+
+//check if a component of a vector can be read as a coordinate of a position
+template <typename T> inline constexpr bool __IS_VEC3_COMPONENT = std::is_same_v<T, float> || std::is_same_v<T, double> ||
+                                                                  std::is_same_v<T, int32_t> || std::is_same_v<T, uint32_t>;
+
+/**
+ * @brief describe how a C++ element type is converted to a 3D float vector
+ * 
+ * The supported types are the same that __readVec3 supports: all scalars up to 32 bit, floats and doubles (the value is used
+ * for all axes) and vectors of floats, doubles and 32 bit integers (missing axes are 0, a 4th axis is dropped)
+ * 
+ * @tparam T the C++ type of the element
+ */
+template <typename T> struct __Vec3Source {
+    static constexpr bool supported = __IS_VEC3_COMPONENT<T> || std::is_same_v<T, int8_t> || std::is_same_v<T, uint8_t> ||
+                                      std::is_same_v<T, int16_t> || std::is_same_v<T, uint16_t>;
+    static constexpr uint32_t count = 1;
+    using Component = T;
+};
+template <typename C, size_t N> struct __Vec3Source<std::array<C, N>> {
+    static constexpr bool supported = __IS_VEC3_COMPONENT<C>;
+    static constexpr uint32_t count = N;
+    using Component = C;
+};
+template <> struct __Vec3Source<vec2> {static constexpr bool supported = true; static constexpr uint32_t count = 2; using Component = float;};
+template <> struct __Vec3Source<vec3> {static constexpr bool supported = true; static constexpr uint32_t count = 3; using Component = float;};
+template <> struct __Vec3Source<vec4> {static constexpr bool supported = true; static constexpr uint32_t count = 4; using Component = float;};
+
+/**
+ * @brief convert an element to a 3D float vector
+ * 
+ * @tparam T the C++ type of the element (must be supported by __Vec3Source)
+ * @param value the value of the element
+ * @return vec3 the converted vector
+ */
+template <typename T> static inline vec3 __toVec3(const T& value) noexcept {
+    using Source = __Vec3Source<T>;
+    if constexpr (Source::count == 1) {return vec3((float)value);}
+    else {
+        typename Source::Component c[Source::count];
+        memcpy(c, &value, sizeof(c));
+        vec3 out(0.f);
+        out.x = (float)c[0];
+        out.y = (float)c[1];
+        if constexpr (Source::count > 2) {out.z = (float)c[2];}
+        return out;
+    }
+}
+
+/**
+ * @brief read a vertex element as a 3D float vector
+ * 
+ * Missing components are filled with 0, additional components are dropped
+ * 
+ * @param pos_ptr a pointer to the element to read
+ * @param dat the data type of the element
+ * @param pos the vector to write the result to
+ * @return true : the element was converted successfully
+ * @return false : the data type is not supported
+ */
+static inline bool __readVec3(const uint8_t* pos_ptr, VertexElementDataType dat, vec3& pos) noexcept {
+    switch (dat)
+    {
+        case VERTEX_ELEMENT_DATA_TYPE_INT8:
+        {
+            int32_t v = *((int8_t*)pos_ptr);
+            pos = vectorCast<vec3>(v);
+            break;
+        }
+        case VERTEX_ELEMENT_DATA_TYPE_UINT8:
+        {
+            uint32_t v = *((uint8_t*)pos_ptr);
+            pos = vectorCast<vec3>(v);
+            break;
+        }
+        case VERTEX_ELEMENT_DATA_TYPE_INT16:
+        {
+            int32_t v = *((int16_t*)pos_ptr);
+            pos = vectorCast<vec3>(v);
+            break;
+        }
+        case VERTEX_ELEMENT_DATA_TYPE_UINT16:
+        {
+            uint32_t v = *((uint16_t*)pos_ptr);
+            pos = vectorCast<vec3>(v);
+            break;
+        }
+        case VERTEX_ELEMENT_DATA_TYPE_INT32:
+        {
+            int32_t v = *((int32_t*)pos_ptr);
+            pos = vectorCast<vec3>(v);
+            break;
+        }
+        case VERTEX_ELEMENT_DATA_TYPE_UINT32:
+        {
+            uint32_t v = *((uint32_t*)pos_ptr);
+            pos = vectorCast<vec3>(v);
+            break;
+        }
+        case VERTEX_ELEMENT_DATA_TYPE_FLOAT:
+        {
+            float v = *((float*)pos_ptr);
+            pos = vectorCast<vec3>(v);
+            break;
+        }
+        case VERTEX_ELEMENT_DATA_TYPE_DOUBLE:
+        {
+            double v = *((double*)pos_ptr);
+            pos = vectorCast<vec3>(v);
+            break;
+        }
+        case VERTEX_ELEMENT_DATA_TYPE_FLOAT_VEC2:
+        {
+            float* v = (float*)pos_ptr;
+            pos = vectorCast<vec3>(vec2(v[0], v[1]));
+            break;
+        }
+        case VERTEX_ELEMENT_DATA_TYPE_FLOAT_VEC3:
+        {
+            pos = *((vec3*)pos_ptr);
+            break;
+        }
+        case VERTEX_ELEMENT_DATA_TYPE_FLOAT_VEC4:
+        {
+            float* v = (float*)pos_ptr;
+            pos = vectorCast<vec3>(vec4(v[0], v[1], v[2], v[3]));
+            break;
+        }
+        case VERTEX_ELEMENT_DATA_TYPE_DOUBLE_VEC2:
+        {
+            double* v = (double*)pos_ptr;
+            pos = vectorCast<vec3>(vec2((float)v[0], (float)v[1]));
+            break;
+        }
+        case VERTEX_ELEMENT_DATA_TYPE_DOUBLE_VEC3:
+        {
+            double* v = (double*)pos_ptr;
+            pos = vectorCast<vec3>(vec3((float)v[0], (float)v[1], (float)v[2]));
+            break;
+        }
+        case VERTEX_ELEMENT_DATA_TYPE_DOUBLE_VEC4:
+        {
+            double* v = (double*)pos_ptr;
+            pos = vectorCast<vec3>(vec4((float)v[0], (float)v[1], (float)v[2], (float)v[3]));
+            break;
+        }
+        case VERTEX_ELEMENT_DATA_TYPE_INT32_VEC2:
+        {
+            int32_t* v = (int32_t*)pos_ptr;
+            pos = vectorCast<vec3>(vec2(v[0], v[1]));
+            break;
+        }
+        case VERTEX_ELEMENT_DATA_TYPE_INT32_VEC3:
+        {
+            int32_t* v = (int32_t*)pos_ptr;
+            pos = vectorCast<vec3>(vec3(v[0], v[1], v[2]));
+            break;
+        }
+        case VERTEX_ELEMENT_DATA_TYPE_INT32_VEC4:
+        {
+            int32_t* v = (int32_t*)pos_ptr;
+            pos = vectorCast<vec3>(vec4(v[0], v[1], v[2], v[3]));
+            break;
+        }
+        case VERTEX_ELEMENT_DATA_TYPE_UINT32_VEC2:
+        {
+            uint32_t* v = (uint32_t*)pos_ptr;
+            pos = vectorCast<vec3>(vec2(v[0], v[1]));
+            break;
+        }
+        case VERTEX_ELEMENT_DATA_TYPE_UINT32_VEC3:
+        {
+            uint32_t* v = (uint32_t*)pos_ptr;
+            pos = vectorCast<vec3>(vec3(v[0], v[1], v[2]));
+            break;
+        }
+        case VERTEX_ELEMENT_DATA_TYPE_UINT32_VEC4:
+        {
+            uint32_t* v = (uint32_t*)pos_ptr;
+            pos = vectorCast<vec3>(vec4(v[0], v[1], v[2], v[3]));
+            break;
+        }
+    
+    default:
+        //the data type is not supported
+        return false;
+    }
+
+    //the element was read successfully
+    return true;
+}
+
+uint64_t Mesh::weld(float epsilon) noexcept
+{
+    //nothing to weld
+    if (m_vertices.empty() || (m_vertexCount < 2)) {return 0;}
+    //the new indices must fit into the index type
+    if (m_vertexCount > (uint64_t)UINT32_MAX) {
+        printf("[ERROR] Can't weld a mesh with %lu vertices: the vertex indices don't fit into the index type\n", m_vertexCount);
+        return 0;
+    }
+
+    //collect the access information for all used elements
+    __ElementAccess elements[VERTEX_ELEMENT_TYPE_COUNT];
+    uint64_t elementCount = 0;
+    for (uint64_t i = 0; i < VERTEX_ELEMENT_TYPE_COUNT; ++i) {
+        if (m_layout.getElementSize(i) == 0) {continue;}
+        elements[elementCount++] = __getElementAccess(m_vertices.data(), m_vertexCount, m_layout, m_storage, i);
+    }
+    //only quantize if an epsilon is given
+    bool quantize = epsilon > 0.f;
+    double invEpsilon = quantize ? (1. / (double)epsilon) : 0.;
+
+    //a function to hash a single vertex
+    auto hashVertex = [&](uint64_t v) -> uint64_t {
+        uint64_t hash = 0xCBF29CE484222325ull;
+        for (uint64_t e = 0; e < elementCount; ++e) {
+            const uint8_t* ptr = elements[e].base + v*elements[e].stride;
+            if (quantize && elements[e].floatSize) {
+                //hash the grid cells of all components
+                for (uint64_t c = 0; c < elements[e].size; c += elements[e].floatSize)
+                {hash = __hashMix(hash, (uint64_t)__quantizeComponent(ptr + c, elements[e].floatSize, invEpsilon));}
+            } else {
+                //hash the raw bytes in 8 byte words
+                for (uint64_t b = 0; b < elements[e].size; b += 8) {
+                    uint64_t word = 0;
+                    memcpy(&word, ptr + b, std::min<uint64_t>(8, elements[e].size - b));
+                    hash = __hashMix(hash, word);
+                }
             }
-            case VERTEX_ELEMENT_DATA_TYPE_DOUBLE_VEC3:
-            {
-                double* v = (double*)pos_ptr;
-                pos = vectorCast<vec3>(vec3((float)v[0], (float)v[1], (float)v[2]));
-                break;
+        }
+        //final avalanche so the upper bits can be used for partitioning
+        hash ^= hash >> 31;
+        hash *= 0x94D049BB133111EBull;
+        return hash ^ (hash >> 29);
+    };
+    //a function to check if two vertices are equal
+    auto isEqual = [&](uint64_t a, uint64_t b) -> bool {
+        for (uint64_t e = 0; e < elementCount; ++e) {
+            const uint8_t* pa = elements[e].base + a*elements[e].stride;
+            const uint8_t* pb = elements[e].base + b*elements[e].stride;
+            if (quantize && elements[e].floatSize) {
+                for (uint64_t c = 0; c < elements[e].size; c += elements[e].floatSize) {
+                    if (__quantizeComponent(pa + c, elements[e].floatSize, invEpsilon) != __quantizeComponent(pb + c, elements[e].floatSize, invEpsilon))
+                    {return false;}
+                }
+            } else if (memcmp(pa, pb, elements[e].size) != 0) {return false;}
+        }
+        return true;
+    };
+
+    ThreadPool& pool = ThreadPool::getGlobal();
+    //the granularity of the parallel loops over vertices
+    constexpr uint64_t GRAIN = 16384;
+
+    //Step 1: hash all vertices in parallel
+    std::vector<uint64_t> hashes(m_vertexCount);
+    pool.parallelFor(m_vertexCount, GRAIN, [&](uint64_t begin, uint64_t end) {
+        for (uint64_t v = begin; v < end; ++v) {hashes[v] = hashVertex(v);}
+    });
+
+    //Step 2: sort the vertices into partitions using the upper bits of the hash
+    //equal vertices have equal hashes, so they always end up in the same partition
+    constexpr uint64_t PARTITION_BITS = 6;
+    constexpr uint64_t PARTITION_COUNT = 1ull << PARTITION_BITS;
+    std::vector<uint64_t> partitionStart(PARTITION_COUNT + 1, 0);
+    for (uint64_t v = 0; v < m_vertexCount; ++v) {++partitionStart[(hashes[v] >> (64 - PARTITION_BITS)) + 1];}
+    for (uint64_t p = 0; p < PARTITION_COUNT; ++p) {partitionStart[p+1] += partitionStart[p];}
+    std::vector<index_t> order(m_vertexCount);
+    {
+        std::vector<uint64_t> fill(partitionStart.begin(), partitionStart.end() - 1);
+        for (uint64_t v = 0; v < m_vertexCount; ++v) {order[fill[hashes[v] >> (64 - PARTITION_BITS)]++] = (index_t)v;}
+    }
+
+    //Step 3: find the representative of every vertex. Each partition is processed by a single thread. 
+    //the vertices of a partition are sorted by index, so the first vertex of each group becomes the representative
+    constexpr index_t NO_VERTEX = UINT32_MAX;
+    std::vector<index_t> remap(m_vertexCount);
+    std::vector<index_t> chain(m_vertexCount, NO_VERTEX);
+    pool.parallelFor(PARTITION_COUNT, 1, [&](uint64_t begin, uint64_t end) {
+        for (uint64_t p = begin; p < end; ++p) {
+            //map the hash to the latest representative with that hash, older ones are chained behind it
+            std::unordered_map<uint64_t, index_t> heads;
+            heads.reserve(partitionStart[p+1] - partitionStart[p]);
+            for (uint64_t i = partitionStart[p]; i < partitionStart[p+1]; ++i) {
+                index_t v = order[i];
+                auto [it, inserted] = heads.try_emplace(hashes[v], v);
+                if (!inserted) {
+                    //search all representatives with the same hash for an equal vertex
+                    index_t rep = it->second;
+                    while ((rep != NO_VERTEX) && !isEqual(rep, v)) {rep = chain[rep];}
+                    if (rep != NO_VERTEX) {
+                        remap[v] = rep;
+                        continue;
+                    }
+                    //hash collision without an equal vertex -> new representative
+                    chain[v] = it->second;
+                    it->second = v;
+                }
+                remap[v] = v;
             }
-            case VERTEX_ELEMENT_DATA_TYPE_DOUBLE_VEC4:
-            {
-                double* v = (double*)pos_ptr;
-                pos = vectorCast<vec3>(vec4((float)v[0], (float)v[1], (float)v[2], (float)v[3]));
-                break;
+        }
+    });
+    //the hashes and partitions are not needed anymore
+    hashes = std::vector<uint64_t>();
+    order = std::vector<index_t>();
+    chain = std::vector<index_t>();
+
+    //Step 4: assign the new, compact indices to the representatives
+    std::vector<index_t> newIndex(m_vertexCount);
+    uint64_t newCount = 0;
+    for (uint64_t v = 0; v < m_vertexCount; ++v) 
+    {if (remap[v] == v) {newIndex[v] = (index_t)newCount++;}}
+    //if nothing was merged, stop
+    if (newCount == m_vertexCount) {return 0;}
+
+    //Step 5: copy the representatives to the new vertex buffer
+    //the welded data is written to new buffers, so referenced memory is never modified
+    MeshBuffer welded = MeshBuffer::allocate(newCount * m_layout.m_size);
+    __ElementAccess target[VERTEX_ELEMENT_TYPE_COUNT];
+    for (uint64_t i = 0, e = 0; i < VERTEX_ELEMENT_TYPE_COUNT; ++i) {
+        if (m_layout.getElementSize(i) == 0) {continue;}
+        target[e++] = __getElementAccess(welded.data(), newCount, m_layout, m_storage, i);
+    }
+    pool.parallelFor(m_vertexCount, GRAIN, [&](uint64_t begin, uint64_t end) {
+        for (uint64_t v = begin; v < end; ++v) {
+            if (remap[v] != v) {continue;}
+            for (uint64_t e = 0; e < elementCount; ++e) 
+            {memcpy(target[e].base + newIndex[v]*target[e].stride, elements[e].base + v*elements[e].stride, elements[e].size);}
+        }
+    });
+
+    //Step 6: remap the index buffer. A mesh without indices gets one that references the welded vertices. 
+    //less vertices may fit into a smaller index type
+    bool indexed = !m_indices.empty();
+    uint64_t indexCount = indexed ? getIndexCount() : m_vertexCount;
+    IndexType newType = getIndexTypeFor(newCount);
+    MeshBuffer remapped = MeshBuffer::allocate(indexCount * (uint64_t)newType);
+    pool.parallelFor(indexCount, GRAIN, [&](uint64_t begin, uint64_t end) {
+        for (uint64_t i = begin; i < end; ++i) {
+            index_t idx = newIndex[remap[indexed ? getIndex(i) : i]];
+            if (newType == INDEX_TYPE_UINT16) {((uint16_t*)remapped.data())[i] = (uint16_t)idx;}
+            else {((uint32_t*)remapped.data())[i] = idx;}
+        }
+    });
+    m_indices = std::move(remapped);
+    m_indexType = newType;
+
+    //store the new vertices
+    uint64_t removed = m_vertexCount - newCount;
+    m_vertices = std::move(welded);
+    m_vertexCount = newCount;
+    return removed;
+}
+
+/**
+ * @brief write a 3D vector to a floating point vertex element
+ * 
+ * @param ptr a pointer to the element to write to
+ * @param dat the data type of the element
+ * @param v the vector to write
+ * @param w the value of the 4th component if the element has 4 components
+ */
+static inline void __writeVec3(uint8_t* ptr, VertexElementDataType dat, const vec3& v, float w) noexcept {
+    float data[4] = {v.x, v.y, v.z, w};
+    //memcpy is used because the elements are not required to be aligned
+    memcpy(ptr, data, (dat == VERTEX_ELEMENT_DATA_TYPE_FLOAT_VEC4) ? sizeof(float)*4 : sizeof(float)*3);
+}
+
+/**
+ * @brief check if an element can be written by __writeVec3
+ * 
+ * @param dat the data type of the element
+ * @return true : the element is a 3D or 4D float vector
+ * @return false : the element has a different type
+ */
+static inline bool __isWritableVec3(VertexElementDataType dat) noexcept 
+{return (dat == VERTEX_ELEMENT_DATA_TYPE_FLOAT_VEC3) || (dat == VERTEX_ELEMENT_DATA_TYPE_FLOAT_VEC4);}
+
+/**
+ * @brief build a table that stores for every vertex which triangle corners reference it
+ * 
+ * The corners of a vertex are stored in ascending order, so sums over them don't depend on the amount of threads
+ * 
+ * @tparam VertexOf the type of the function that maps a corner to its vertex
+ * @param vertexOf a function that gets the index of a corner and returns the index of the vertex it references
+ * @param cornerCount the amount of triangle corners (3 per triangle)
+ * @param vertexCount the amount of vertices
+ * @param start filled with the first entry in corners for every vertex. Has one more element than vertices. 
+ * @param corners filled with the corners grouped by vertex
+ * @return true : the table was build successfully
+ * @return false : an index references a vertex that does not exist
+ */
+template <typename VertexOf>
+static bool __buildVertexCorners(const VertexOf& vertexOf, uint64_t cornerCount, uint64_t vertexCount, std::vector<uint64_t>& start, std::vector<uint64_t>& corners) noexcept {
+    start.assign(vertexCount + 1, 0);
+    corners.resize(cornerCount);
+    //count the corners of all vertices
+    for (uint64_t c = 0; c < cornerCount; ++c) {
+        uint64_t v = vertexOf(c);
+        if (v >= vertexCount) {return false;}
+        ++start[v + 1];
+    }
+    //turn the counts into start offsets
+    for (uint64_t v = 0; v < vertexCount; ++v) {start[v+1] += start[v];}
+    //sort the corners into their vertices
+    std::vector<uint64_t> fill(start.begin(), start.end() - 1);
+    for (uint64_t c = 0; c < cornerCount; ++c) {corners[fill[vertexOf(c)]++] = c;}
+    return true;
+}
+
+/**
+ * @brief calculate the angle between two edges of a triangle corner
+ * 
+ * @param a the first edge leaving the corner
+ * @param b the second edge leaving the corner
+ * @return float the angle in radians or 0 if one of the edges has no length
+ */
+static inline float __cornerAngle(const vec3& a, const vec3& b) noexcept {
+    float len = length(a) * length(b);
+    if (len <= 0.f) {return 0.f;}
+    return std::acos(std::clamp(dot(a, b) / len, -1.f, 1.f));
+}
+
+bool Mesh::recalculateNormals(NormalWeighting weighting) noexcept
+{
+    //get the required elements
+    uint64_t posIdx = m_layout.getIndexOfElement(VERTEX_ELEMENT_TYPE_POSITION);
+    uint64_t norIdx = m_layout.getIndexOfElement(VERTEX_ELEMENT_TYPE_NORMAL);
+    if ((posIdx == UINT64_MAX) || (norIdx == UINT64_MAX)) {return false;}
+    VertexElementDataType posType = m_layout.m_elements[posIdx].data;
+    VertexElementDataType norType = m_layout.m_elements[norIdx].data;
+    if (!__isWritableVec3(norType)) {return false;}
+    //nothing to do
+    if (m_vertices.empty() || (m_vertexCount == 0)) {return true;}
+    //the normals are written in place, so referenced memory must be copied first
+    m_vertices.makeUnique();
+    __ElementAccess pos = __getElementAccess(m_vertices.data(), m_vertexCount, m_layout, m_storage, posIdx);
+    __ElementAccess nor = __getElementAccess(m_vertices.data(), m_vertexCount, m_layout, m_storage, norIdx);
+    //the type of the position is the same for all vertices, so probing the first one is enough
+    vec3 probe;
+    if (!__readVec3(pos.base, posType, probe)) {return false;}
+
+    //without indices every 3 vertices form a triangle
+    bool indexed = !m_indices.empty();
+    auto vertexOf = [&](uint64_t c) -> uint64_t {return indexed ? getIndex(c) : c;};
+    uint64_t cornerCount = indexed ? getIndexCount() : m_vertexCount;
+    cornerCount -= cornerCount % 3;
+    std::vector<uint64_t> start, corners;
+    if (!__buildVertexCorners(vertexOf, cornerCount, m_vertexCount, start, corners)) {return false;}
+
+    ThreadPool& pool = ThreadPool::getGlobal();
+    //the granularity of the parallel loops
+    constexpr uint64_t GRAIN = 8192;
+
+    //Step 1: calculate the weighted face normal of every triangle corner in parallel
+    //every triangle only writes its own corners, so no synchronization is needed
+    std::vector<vec3> cornerNormals(cornerCount);
+    pool.parallelFor(cornerCount / 3, GRAIN, [&](uint64_t begin, uint64_t end) {
+        for (uint64_t t = begin; t < end; ++t) {
+            vec3 p[3];
+            for (uint64_t i = 0; i < 3; ++i) {
+                uint64_t v = vertexOf(t*3 + i);
+                __readVec3(pos.base + v*pos.stride, posType, p[i]);
             }
-            case VERTEX_ELEMENT_DATA_TYPE_INT32_VEC2:
-            {
-                int32_t* v = (int32_t*)pos_ptr;
-                pos = vectorCast<vec3>(vec2(v[0], v[1]));
-                break;
+            //the length of the cross product is twice the area of the triangle
+            vec3 n = cross(p[1] - p[0], p[2] - p[0]);
+            if (weighting == NORMAL_WEIGHTING_AREA) {
+                for (uint64_t i = 0; i < 3; ++i) {cornerNormals[t*3 + i] = n;}
+                continue;
             }
-            case VERTEX_ELEMENT_DATA_TYPE_INT32_VEC3:
-            {
-                int32_t* v = (int32_t*)pos_ptr;
-                pos = vectorCast<vec3>(vec3(v[0], v[1], v[2]));
-                break;
+            //angle weighting uses the normalized face normal
+            float len = length(n);
+            if (len > 0.f) {n = n / len;}
+            for (uint64_t i = 0; i < 3; ++i) 
+            {cornerNormals[t*3 + i] = n * __cornerAngle(p[(i+1)%3] - p[i], p[(i+2)%3] - p[i]);}
+        }
+    });
+
+    //Step 2: sum up the corners of every vertex in parallel
+    //each vertex is owned by exactly one thread, so the writes never overlap
+    pool.parallelFor(m_vertexCount, GRAIN, [&](uint64_t begin, uint64_t end) {
+        for (uint64_t v = begin; v < end; ++v) {
+            vec3 n(0.f);
+            for (uint64_t c = start[v]; c < start[v+1]; ++c) {n += cornerNormals[corners[c]];}
+            float len = length(n);
+            //vertices that are not used by any triangle get an up facing normal
+            n = (len > 0.f) ? (n / len) : vec3(0.f, 1.f, 0.f);
+            __writeVec3(nor.base + v*nor.stride, norType, n, 0.f);
+        }
+    });
+    return true;
+}
+
+bool Mesh::recalculateTangents() noexcept
+{
+    //get the required elements
+    uint64_t posIdx = m_layout.getIndexOfElement(VERTEX_ELEMENT_TYPE_POSITION);
+    uint64_t norIdx = m_layout.getIndexOfElement(VERTEX_ELEMENT_TYPE_NORMAL);
+    uint64_t uvIdx = m_layout.getIndexOfElement(VERTEX_ELEMENT_TYPE_TEXTURE_COORDINATE0);
+    uint64_t tanIdx = m_layout.getIndexOfElement(VERTEX_ELEMENT_TYPE_TANGENT);
+    uint64_t bitIdx = m_layout.getIndexOfElement(VERTEX_ELEMENT_TYPE_BITANGENT);
+    if ((posIdx == UINT64_MAX) || (norIdx == UINT64_MAX) || (uvIdx == UINT64_MAX) || (tanIdx == UINT64_MAX)) {return false;}
+    VertexElementDataType posType = m_layout.m_elements[posIdx].data;
+    VertexElementDataType norType = m_layout.m_elements[norIdx].data;
+    VertexElementDataType uvType = m_layout.m_elements[uvIdx].data;
+    VertexElementDataType tanType = m_layout.m_elements[tanIdx].data;
+    if (!__isWritableVec3(tanType)) {return false;}
+    //the bitangent is only written if it can be stored
+    bool writeBitangent = (bitIdx != UINT64_MAX) && (m_layout.m_elements[bitIdx].data == VERTEX_ELEMENT_DATA_TYPE_FLOAT_VEC3);
+    //nothing to do
+    if (m_vertices.empty() || (m_vertexCount == 0)) {return true;}
+    //the tangents are written in place, so referenced memory must be copied first
+    m_vertices.makeUnique();
+    __ElementAccess pos = __getElementAccess(m_vertices.data(), m_vertexCount, m_layout, m_storage, posIdx);
+    __ElementAccess nor = __getElementAccess(m_vertices.data(), m_vertexCount, m_layout, m_storage, norIdx);
+    __ElementAccess uv = __getElementAccess(m_vertices.data(), m_vertexCount, m_layout, m_storage, uvIdx);
+    __ElementAccess tan = __getElementAccess(m_vertices.data(), m_vertexCount, m_layout, m_storage, tanIdx);
+    __ElementAccess bit = writeBitangent ? __getElementAccess(m_vertices.data(), m_vertexCount, m_layout, m_storage, bitIdx) : __ElementAccess{};
+    //the element types are the same for all vertices, so probing the first one is enough
+    vec3 probe;
+    if (!__readVec3(pos.base, posType, probe) || !__readVec3(nor.base, norType, probe) || !__readVec3(uv.base, uvType, probe)) {return false;}
+
+    //without indices every 3 vertices form a triangle
+    bool indexed = !m_indices.empty();
+    auto vertexOf = [&](uint64_t c) -> uint64_t {return indexed ? getIndex(c) : c;};
+    uint64_t cornerCount = indexed ? getIndexCount() : m_vertexCount;
+    cornerCount -= cornerCount % 3;
+    std::vector<uint64_t> start, corners;
+    if (!__buildVertexCorners(vertexOf, cornerCount, m_vertexCount, start, corners)) {return false;}
+
+    ThreadPool& pool = ThreadPool::getGlobal();
+    //the granularity of the parallel loops
+    constexpr uint64_t GRAIN = 8192;
+
+    //Step 1: calculate the tangent frame of every triangle corner in parallel
+    //like MikkTSpace, the face tangent is projected onto the tangent plane of the corner's vertex normal and weighted by the corner angle
+    std::vector<vec3> cornerTangents(cornerCount);
+    std::vector<vec3> cornerBitangents(cornerCount);
+    pool.parallelFor(cornerCount / 3, GRAIN, [&](uint64_t begin, uint64_t end) {
+        for (uint64_t t = begin; t < end; ++t) {
+            vec3 p[3], n[3], st[3];
+            for (uint64_t i = 0; i < 3; ++i) {
+                uint64_t v = vertexOf(t*3 + i);
+                __readVec3(pos.base + v*pos.stride, posType, p[i]);
+                __readVec3(nor.base + v*nor.stride, norType, n[i]);
+                __readVec3(uv.base + v*uv.stride, uvType, st[i]);
             }
-            case VERTEX_ELEMENT_DATA_TYPE_INT32_VEC4:
-            {
-                int32_t* v = (int32_t*)pos_ptr;
-                pos = vectorCast<vec3>(vec4(v[0], v[1], v[2], v[3]));
-                break;
+            //solve for the directions in which the texture coordinates grow
+            vec3 e1 = p[1] - p[0];
+            vec3 e2 = p[2] - p[0];
+            float du1 = st[1].x - st[0].x, dv1 = st[1].y - st[0].y;
+            float du2 = st[2].x - st[0].x, dv2 = st[2].y - st[0].y;
+            float det = du1*dv2 - du2*dv1;
+            //triangles with degenerated texture coordinates don't contribute
+            if (std::abs(det) <= 1e-20f) {
+                for (uint64_t i = 0; i < 3; ++i) {cornerTangents[t*3 + i] = vec3(0.f); cornerBitangents[t*3 + i] = vec3(0.f);}
+                continue;
             }
-            case VERTEX_ELEMENT_DATA_TYPE_UINT32_VEC2:
-            {
-                uint32_t* v = (uint32_t*)pos_ptr;
-                pos = vectorCast<vec3>(vec2(v[0], v[1]));
-                break;
+            vec3 sdir = (e1*dv2 - e2*dv1) / det;
+            vec3 tdir = (e2*du1 - e1*du2) / det;
+            for (uint64_t i = 0; i < 3; ++i) {
+                float angle = __cornerAngle(p[(i+1)%3] - p[i], p[(i+2)%3] - p[i]);
+                vec3 ts = sdir - n[i] * dot(n[i], sdir);
+                float len = length(ts);
+                cornerTangents[t*3 + i] = (len > 0.f) ? (ts * (angle / len)) : vec3(0.f);
+                cornerBitangents[t*3 + i] = tdir * angle;
             }
-            case VERTEX_ELEMENT_DATA_TYPE_UINT32_VEC3:
-            {
-                uint32_t* v = (uint32_t*)pos_ptr;
-                pos = vectorCast<vec3>(vec3(v[0], v[1], v[2]));
-                break;
+        }
+    });
+
+    //Step 2: sum up the corners of every vertex in parallel and orthogonalize the result
+    pool.parallelFor(m_vertexCount, GRAIN, [&](uint64_t begin, uint64_t end) {
+        for (uint64_t v = begin; v < end; ++v) {
+            vec3 t(0.f), b(0.f), n;
+            __readVec3(nor.base + v*nor.stride, norType, n);
+            for (uint64_t c = start[v]; c < start[v+1]; ++c) {
+                t += cornerTangents[corners[c]];
+                b += cornerBitangents[corners[c]];
             }
-            case VERTEX_ELEMENT_DATA_TYPE_UINT32_VEC4:
-            {
-                uint32_t* v = (uint32_t*)pos_ptr;
-                pos = vectorCast<vec3>(vec4(v[0], v[1], v[2], v[3]));
-                break;
+            //Gram-Schmidt against the normal
+            t = t - n * dot(n, t);
+            float len = length(t);
+            if (len > 0.f) {
+                t = t / len;
+            } else {
+                //no usable texture coordinates: pick any direction orthogonal to the normal
+                t = cross(n, (std::abs(n.x) < 0.9f) ? vec3(1.f, 0.f, 0.f) : vec3(0.f, 1.f, 0.f));
+                len = length(t);
+                t = (len > 0.f) ? (t / len) : vec3(1.f, 0.f, 0.f);
             }
-        
-        default:
-            //return the default AABB for an unsupported type
-            return AABB{};
+            //the handedness says if the bitangent points along or against cross(normal, tangent)
+            float handedness = (dot(cross(n, t), b) < 0.f) ? -1.f : 1.f;
+            __writeVec3(tan.base + v*tan.stride, tanType, t, handedness);
+            if (writeBitangent) {__writeVec3(bit.base + v*bit.stride, VERTEX_ELEMENT_DATA_TYPE_FLOAT_VEC3, cross(n, t) * handedness, 0.f);}
         }
+    });
+    return true;
+}
 
-        //merge the point to the AABB
-        ret.merge(pos);
-    }
+bool Mesh::applyTransform(const Transform& transform, uint64_t firstVertex, uint64_t vertexCount) noexcept
+{
+    //the position is required, the direction elements are optional
+    uint64_t posIdx = m_layout.getIndexOfElement(VERTEX_ELEMENT_TYPE_POSITION);
+    if (posIdx == UINT64_MAX) {return false;}
+    uint64_t norIdx = m_layout.getIndexOfElement(VERTEX_ELEMENT_TYPE_NORMAL);
+    uint64_t tanIdx = m_layout.getIndexOfElement(VERTEX_ELEMENT_TYPE_TANGENT);
+    uint64_t bitIdx = m_layout.getIndexOfElement(VERTEX_ELEMENT_TYPE_BITANGENT);
+    //all elements that are changed must be writable
+    for (uint64_t idx : {posIdx, norIdx, tanIdx, bitIdx}) 
+    {if ((idx != UINT64_MAX) && !__isWritableVec3(m_layout.m_elements[idx].data)) {return false;}}
+    //nothing to do
+    if (firstVertex >= m_vertexCount) {return true;}
+    vertexCount = std::min(vertexCount, m_vertexCount - firstVertex);
+
+    //the vertices are modified in place
+    m_vertices.makeUnique();
+
+    //build the rows of the rotation matrix (same as Transform::getRotationMatrix)
+    const Quaternion& q = transform.rot;
+    const vec3 r0(1.f - 2.f*(q.j*q.j + q.k*q.k), 2.f*(q.i*q.j - q.k*q.w), 2.f*(q.i*q.k + q.j*q.w));
+    const vec3 r1(2.f*(q.i*q.j + q.k*q.w), 1.f - 2.f*(q.i*q.i + q.k*q.k), 2.f*(q.j*q.k - q.i*q.w));
+    const vec3 r2(2.f*(q.i*q.k - q.j*q.w), 2.f*(q.j*q.k + q.i*q.w), 1.f - 2.f*(q.i*q.i + q.j*q.j));
+    const vec3 s = transform.scale;
+    //normals use the cofactors of the scale instead of its inverse, so a zero scale component doesn't divide by zero
+    //the sign of the determinant is removed again, so mirrored normals still point away from the surface
+    vec3 ns(s.y*s.z, s.x*s.z, s.x*s.y);
+    if ((s.x*s.y*s.z) < 0.f) {ns = ns * -1.f;}
+    //scale a vector, rotate it and optionally normalize it
+    auto apply = [&](const vec3& v, const vec3& scale) -> vec3 {
+        vec3 sv(v.x*scale.x, v.y*scale.y, v.z*scale.z);
+        return vec3(dot(r0, sv), dot(r1, sv), dot(r2, sv));
+    };
+    auto normalize = [](const vec3& v) -> vec3 {
+        float len = length(v);
+        return (len > 0.f) ? (v / len) : v;
+    };
+
+    //get the access information for all elements
+    __ElementAccess pos = __getElementAccess(m_vertices.data(), m_vertexCount, m_layout, m_storage, posIdx);
+    __ElementAccess nor, tan, bit;
+    if (norIdx != UINT64_MAX) {nor = __getElementAccess(m_vertices.data(), m_vertexCount, m_layout, m_storage, norIdx);}
+    if (tanIdx != UINT64_MAX) {tan = __getElementAccess(m_vertices.data(), m_vertexCount, m_layout, m_storage, tanIdx);}
+    if (bitIdx != UINT64_MAX) {bit = __getElementAccess(m_vertices.data(), m_vertexCount, m_layout, m_storage, bitIdx);}
+    VertexElementDataType posType = m_layout.m_elements[posIdx].data;
+
+    //every vertex is independent, so the range is simply split between the threads
+    constexpr uint64_t GRAIN = 16384;
+    ThreadPool::getGlobal().parallelFor(vertexCount, GRAIN, [&](uint64_t begin, uint64_t end) {
+        //transform a direction element while keeping its 4th component
+        auto direction = [&](const __ElementAccess& acc, uint64_t idx, uint64_t v, const vec3& scale) {
+            if (!acc.base) {return;}
+            uint8_t* ptr = acc.base + v*acc.stride;
+            VertexElementDataType dat = m_layout.m_elements[idx].data;
+            float w = 0.f;
+            if (dat == VERTEX_ELEMENT_DATA_TYPE_FLOAT_VEC4) {memcpy(&w, ptr + sizeof(float)*3, sizeof(float));}
+            vec3 d;
+            __readVec3(ptr, dat, d);
+            __writeVec3(ptr, dat, normalize(apply(d, scale)), w);
+        };
+        for (uint64_t v = firstVertex + begin; v < firstVertex + end; ++v) {
+            //positions keep their 4th component as well
+            uint8_t* ptr = pos.base + v*pos.stride;
+            float w = 1.f;
+            if (posType == VERTEX_ELEMENT_DATA_TYPE_FLOAT_VEC4) {memcpy(&w, ptr + sizeof(float)*3, sizeof(float));}
+            vec3 p;
+            __readVec3(ptr, posType, p);
+            __writeVec3(ptr, posType, apply(p, s) + transform.pos, w);
+            direction(nor, norIdx, v, ns);
+            direction(tan, tanIdx, v, s);
+            direction(bit, bitIdx, v, s);
+        }
+    });
+    return true;
+}
+
+std::vector<vec3> Mesh::getPositions() const noexcept
+{
+    std::vector<vec3> positions;
+    //the data type is checked once, the loop itself is specialized for the type
+    visitAttribute(VERTEX_ELEMENT_TYPE_POSITION, [&](auto view) {
+        using Value = typename decltype(view)::Value;
+        if constexpr (__Vec3Source<Value>::supported) {
+            positions.resize(view.size());
+            for (uint64_t i = 0; i < view.size(); ++i) {positions[i] = __toVec3(view[i]);}
+        }
+    });
+    return positions;
+}
 
-    //return the finished AABB
-    return ret;
+template <> AABB Mesh::getBoundingVolume<AABB>() const noexcept {
+    //store the AABB to return
+    AABB ret;
+    //dispatch the data type of the positions once instead of once per vertex
+    bool supported = false;
+    visitAttribute(VERTEX_ELEMENT_TYPE_POSITION, [&](auto view) {
+        using Value = typename decltype(view)::Value;
+        if constexpr (__Vec3Source<Value>::supported) {
+            supported = true;
+            //iterate over all vertices (indices are not important, only positions matter)
+            for (uint64_t i = 0; i < view.size(); ++i) {ret.merge(__toVec3(view[i]));}
+        }
+    });
+    //return the default AABB if no position exists or the type is unsupported
+    return supported ? ret : AABB{};
 }
 
 template <> Sphere Mesh::getBoundingVolume<Sphere>() const noexcept {
@@ -210,14 +1020,33 @@ template <> Sphere Mesh::getBoundingVolume<Sphere>() const noexcept {
 Mesh* mesh_Create(void* vertices, uint64_t vertexCount, const VertexLayout* layout, index_t* indices, uint64_t indexCount)
 {return new Mesh(vertices, vertexCount, *layout, indices, indexCount);}
 
+Mesh* mesh_CreateView(void* vertices, uint64_t vertexCount, const VertexLayout* layout, void* indices, uint64_t indexCount, IndexType indexType)
+{return new Mesh(MeshBuffer::view(vertices, vertexCount * layout->m_size), vertexCount, *layout, MeshBuffer::view(indices, indexCount * (uint64_t)indexType), indexType);}
+
 void mesh_Delete(Mesh* mesh) {delete mesh;}
 
 const VertexLayout* mesh_GetVertexLayout(Mesh* mesh) {return &mesh->getVertexLayout();}
 
+VertexStorageMode mesh_GetStorageMode(Mesh* mesh) {return mesh->getStorageMode();}
+
+void mesh_SetStorageMode(Mesh* mesh, VertexStorageMode mode) {mesh->setStorageMode(mode);}
+
+void* mesh_GetElementStream(Mesh* mesh, VertexElementType type) {return mesh->getElementStream(type);}
+
+uint64_t mesh_Weld(Mesh* mesh, float epsilon) {return mesh->weld(epsilon);}
+
+bool mesh_RecalculateNormals(Mesh* mesh, NormalWeighting weighting) {return mesh->recalculateNormals(weighting);}
+
+bool mesh_RecalculateTangents(Mesh* mesh) {return mesh->recalculateTangents();}
+
+bool mesh_ApplyTransform(Mesh* mesh, const Transform* transform) {return mesh->applyTransform(*transform);}
+
 void* mesh_GetVertices(Mesh* mesh) {return mesh->getVertices();}
 
 uint64_t mesh_GetVertexCount(Mesh* mesh) {return mesh->getVertexCount();}
 
-index_t* mesh_GetIndices(Mesh* mesh) {return mesh->getIndices();}
+void* mesh_GetIndices(Mesh* mesh) {return mesh->getIndices();}
+
+IndexType mesh_GetIndexType(Mesh* mesh) {return mesh->getIndexType();}
 
 uint64_t mesh_GetIndexCount(Mesh* mesh) {return mesh->getIndexCount();}
@@ -19,15 +19,47 @@
 //define the type for indices
 typedef uint32_t index_t;
 
+/**
+ * @brief define the data type a mesh stores its indices with
+ * 
+ * The value of an index type is the size of a single index in bytes
+ */
+typedef enum e_IndexType {
+    //16 bit unsigned indices. Used if all vertices can be addressed with 16 bits. 
+    INDEX_TYPE_UINT16 = 2,
+    //32 bit unsigned indices
+    INDEX_TYPE_UINT32 = 4
+} IndexType;
+
 //include vertex layouts
 #include "VertexLayout.h"
+//include typed views onto the vertex elements
+#include "VertexAttribute.h"
+//include the buffers that store the mesh data
+#include "MeshBuffer.h"
+//include transforms to move the vertices around
+#include "../Structure/Transform.h"
+
+/**
+ * @brief define how the normals of the faces around a vertex are weighted when computing the vertex normal
+ */
+typedef enum e_NormalWeighting {
+    //each face is weighted by its area. Large faces dominate the normal. 
+    NORMAL_WEIGHTING_AREA = 0,
+    //each face is weighted by the angle of its corner at the vertex. This is independent of the tessellation. 
+    NORMAL_WEIGHTING_ANGLE
+} NormalWeighting;
 
 #if __cplusplus
 
 //include resizable containers
 #include <vector>
+//include typed views for the element streams
+#include <span>
 //include stuff for memcpy
 #include <cstring>
+//as_const selects the read only accessors
+#include <utility>
 
 /**
  * @brief store a simple mesh
@@ -43,6 +75,21 @@ public:
      */
     Mesh() = default;
 
+    /**
+     * @brief Construct a new Mesh
+     * 
+     * The indices are stored with the smallest index type that can address all vertices, independent of the inputted type
+     * 
+     * @param vertices a C array containing some form of vertex structure
+     * @param vertexCount the amount of vertices contained in the array
+     * @param layout the layout of a vertex element
+     * @param indices a pointer to an array of indices
+     * @param indexCount the amount of indices in the index array
+     * @param indexType the type of the inputted indices
+     * @param storage the way the inputted vertices are arranged in memory. The mesh keeps this storage mode. 
+     */
+    Mesh(const void* vertices, uint64_t vertexCount, const VertexLayout& layout, const void* indices, uint64_t indexCount, IndexType indexType, VertexStorageMode storage = VERTEX_STORAGE_MODE_INTERLEAVED);
+
     /**
      * @brief Construct a new Mesh
      * 
@@ -51,8 +98,11 @@ public:
      * @param layout the layout of a vertex element
      * @param indices a pointer to an array of index types
      * @param indexCount the amount of indices in the index array
+     * @param storage the way the inputted vertices are arranged in memory. The mesh keeps this storage mode. 
      */
-    Mesh(void* vertices, uint64_t vertexCount, const VertexLayout& layout, index_t* indices, uint64_t indexCount);
+    inline Mesh(const void* vertices, uint64_t vertexCount, const VertexLayout& layout, index_t* indices, uint64_t indexCount, VertexStorageMode storage = VERTEX_STORAGE_MODE_INTERLEAVED)
+     : Mesh(vertices, vertexCount, layout, (const void*)indices, indexCount, INDEX_TYPE_UINT32, storage)
+    {}
 
     /**
      * @brief Construct a new Mesh
@@ -61,31 +111,35 @@ public:
      * @param vertexCount the amount of vertices contained in the array
      * @param layout the layout of a vertex element
      * @param indices a std::vector of index_t types for the indices
+     * @param storage the way the inputted vertices are arranged in memory. The mesh keeps this storage mode. 
      */
-    inline Mesh(void* vertices, uint64_t vertexCount, const VertexLayout& layout, std::vector<index_t> indices)
-     : Mesh(vertices, vertexCount, layout, indices.data(), indices.size())
+    inline Mesh(const void* vertices, uint64_t vertexCount, const VertexLayout& layout, std::vector<index_t> indices, VertexStorageMode storage = VERTEX_STORAGE_MODE_INTERLEAVED)
+     : Mesh(vertices, vertexCount, layout, indices.data(), indices.size(), storage)
     {}
 
+    /**
+     * @brief Construct a new Mesh from existing buffers without copying the data
+     * 
+     * The buffers keep their ownership: owned buffers are moved into the mesh, referenced memory stays referenced. 
+     * Referenced memory is copied before the mesh modifies it in place. The index type is kept as it is. 
+     * 
+     * @param vertices the buffer containing the vertices. It must contain at least vertexCount vertices. 
+     * @param vertexCount the amount of vertices in the buffer
+     * @param layout the layout of a vertex element
+     * @param indices the buffer containing the indices
+     * @param indexType the type of the indices in the index buffer
+     * @param storage the way the vertices are arranged in memory
+     */
+    Mesh(MeshBuffer&& vertices, uint64_t vertexCount, const VertexLayout& layout, MeshBuffer&& indices, IndexType indexType, VertexStorageMode storage = VERTEX_STORAGE_MODE_INTERLEAVED) noexcept;
+
     /**
      * @brief Construct a new Mesh by copying another mesh
      * 
+     * Owned data is copied, referenced data is referenced by the copy as well
+     * 
      * @param other the other mesh to copy
      */
-    Mesh(const Mesh& other)
-     : m_layout(other.m_layout),
-       m_vertexCount(other.m_vertexCount),
-       m_vertices(nullptr),
-       m_indices(other.m_indices)
-    {
-        //calculate the amount of bytes to allocate
-        size_t totalBytes = m_vertexCount * m_layout.m_size;
-        if (totalBytes > 0)
-        {
-            //if the amount is sane, allocate the new vertex array and copy the data over
-            m_vertices = new uint8_t[totalBytes];
-            memcpy(m_vertices, other.m_vertices, totalBytes);
-        }
-    }
+    Mesh(const Mesh& other) = default;
 
     /**
      * @brief Construct a new Mesh by moving from another mesh
@@ -94,21 +148,47 @@ public:
      */
     Mesh(Mesh&& other) noexcept
     : m_layout(std::move(other.m_layout)),
+      m_storage(other.m_storage),
       m_vertexCount(other.m_vertexCount),
-      m_vertices(other.m_vertices),
+      m_vertices(std::move(other.m_vertices)),
+      m_indexType(other.m_indexType),
       m_indices(std::move(other.m_indices))
     {
-        //Null out other's data to avoid double deletion
-        //do not free it, this element now owns it
-        other.m_vertices = nullptr;
+        //the other mesh is empty now
         other.m_vertexCount = 0;
     }
 
+    /**
+     * @brief copy another mesh into this mesh
+     * 
+     * @param other the mesh to copy
+     * @return Mesh& a reference to this mesh
+     */
+    Mesh& operator=(const Mesh& other) = default;
+
+    /**
+     * @brief move another mesh into this mesh
+     * 
+     * @param other the mesh to move from
+     * @return Mesh& a reference to this mesh
+     */
+    inline Mesh& operator=(Mesh&& other) noexcept {
+        if (this == &other) {return *this;}
+        m_layout = other.m_layout;
+        m_storage = other.m_storage;
+        m_vertexCount = other.m_vertexCount;
+        m_vertices = std::move(other.m_vertices);
+        m_indexType = other.m_indexType;
+        m_indices = std::move(other.m_indices);
+        //the other mesh is empty now
+        other.m_vertexCount = 0;
+        return *this;
+    }
 
     /**
      * @brief Destroy the Mesh
      */
-    ~Mesh();
+    ~Mesh() = default;
 
     /**
      * @brief Get the Bounding Volume of the mesh
@@ -118,6 +198,73 @@ public:
      */
     template <typename T> T getBoundingVolume() const noexcept;
 
+    /**
+     * @brief read the positions of all vertices as 3D float vectors
+     * 
+     * @return std::vector<vec3> the positions or an empty vector if the layout has no position element of a supported type
+     */
+    std::vector<vec3> getPositions() const noexcept;
+
+    /**
+     * @brief merge all vertices that are equal or close to each other into a single vertex
+     * 
+     * The vertices are compared using a hash over all of their elements. The hashing and merging runs in parallel on the 
+     * global thread pool. With an epsilon of 0 only bit-identical vertices are merged. With a larger epsilon all floating 
+     * point elements are snapped to a grid with that cell size before comparing, so vertices that fall into the same cell 
+     * are merged. The first vertex of each group is kept and the index buffer is remapped (or created if the mesh had none). 
+     * 
+     * @param epsilon the grid cell size used to quantize floating point elements. 0 means bit-identical comparison. 
+     * @return uint64_t the amount of removed vertices
+     */
+    uint64_t weld(float epsilon = 0.f) noexcept;
+
+    /**
+     * @brief re-compute the normals of all vertices from the triangles of the mesh
+     * 
+     * The face normals are computed per triangle and gathered per vertex, both in parallel on the global thread pool. 
+     * Each vertex only sums up its own faces, so no atomics or locks are required. 
+     * 
+     * @warning the normal element must be stored as a 3D or 4D float vector (the 4th component is set to 0)
+     * 
+     * @param weighting the way the faces around a vertex are weighted
+     * @return true : the normals were re-computed
+     * @return false : the layout has no position or no normal element of a supported type
+     */
+    bool recalculateNormals(NormalWeighting weighting = NORMAL_WEIGHTING_AREA) noexcept;
+
+    /**
+     * @brief re-compute the tangents of all vertices from the triangles, normals and first texture coordinates
+     * 
+     * The tangents follow the MikkTSpace conventions: the per-face tangents are angle weighted, orthogonalized against 
+     * the vertex normal and a 4D tangent stores the handedness of the bitangent in w (bitangent = w * cross(normal, tangent)). 
+     * If the layout has a bitangent element stored as a 3D float vector, it is written as well. 
+     * 
+     * @warning vertices are not split along texture seams, so the result is not bit-exact to the MikkTSpace reference implementation
+     * 
+     * @return true : the tangents were re-computed
+     * @return false : the layout is missing the position, normal, texture coordinate or tangent element or one of them has an unsupported type
+     */
+    bool recalculateTangents() noexcept;
+
+    /**
+     * @brief apply a transform to a range of vertices
+     * 
+     * Positions are scaled, rotated and moved. Normals are multiplied with the inverse transpose (rotation and inverse scale) 
+     * and tangents and bitangents with the rotation and scale, all three are re-normalized afterwards. The 4th component of a 
+     * tangent (the handedness) is kept. Elements of other types are not changed. 
+     * Transforming disjoint ranges of a mesh that owns its vertices from multiple threads at the same time is safe. 
+     * 
+     * @warning the position, normal, tangent and bitangent elements must be stored as 3D or 4D float vectors
+     * @warning a transform that mirrors the mesh (an odd amount of negative scale components) does not change the triangle winding
+     * 
+     * @param transform the transform to apply
+     * @param firstVertex the index of the first vertex to transform
+     * @param vertexCount the amount of vertices to transform. Clamped to the end of the mesh. 
+     * @return true : the vertices were transformed
+     * @return false : the layout has no position element or one of the elements has an unsupported type
+     */
+    bool applyTransform(const Transform& transform, uint64_t firstVertex = 0, uint64_t vertexCount = UINT64_MAX) noexcept;
+
     /**
      * @brief Get the Vertex Layout of the mesh
      * 
@@ -125,20 +272,227 @@ public:
      */
     inline constexpr const VertexLayout& getVertexLayout() const noexcept {return m_layout;}
 
+    /**
+     * @brief Get the way the vertices are arranged in memory
+     * 
+     * @return constexpr VertexStorageMode the storage mode of the vertex data
+     */
+    inline constexpr VertexStorageMode getStorageMode() const noexcept {return m_storage;}
+
+    /**
+     * @brief re-arrange the vertex data to follow a different storage mode
+     * 
+     * If the mesh allready uses the requested mode, nothing happens. 
+     * 
+     * @warning this invalidates all pointers to the vertex data and to the element streams
+     * 
+     * @param mode the new storage mode of the vertex data
+     */
+    void setStorageMode(VertexStorageMode mode) noexcept;
+
+    /**
+     * @brief store all elements of a vertex next to each other
+     */
+    inline void interleave() noexcept {setStorageMode(VERTEX_STORAGE_MODE_INTERLEAVED);}
+
+    /**
+     * @brief store all elements of a type in an own, tightly packed stream
+     */
+    inline void deinterleave() noexcept {setStorageMode(VERTEX_STORAGE_MODE_SEPARATE);}
+
+    /**
+     * @brief Get the stream of a specific element
+     * 
+     * @warning this only works for separately stored vertices
+     * 
+     * @param type the type of the element to quarry the stream for
+     * @return const void* a read only pointer to the first element of the stream or NULL if the element does not exist or the vertices are interleaved
+     */
+    const void* getElementStream(VertexElementType type) const noexcept;
+
+    /**
+     * @brief Get the writable stream of a specific element
+     * 
+     * Referenced vertex data is copied to memory owned by the mesh first, so writing never modifies external memory.
+     * 
+     * @warning this only works for separately stored vertices
+     * 
+     * @param type the type of the element to quarry the stream for
+     * @return void* a pointer to the first element of the stream or NULL if the element does not exist or the vertices are interleaved
+     */
+    inline void* getElementStream(VertexElementType type) noexcept {
+        m_vertices.makeUnique();
+        return (void*)std::as_const(*this).getElementStream(type);
+    }
+
+    /**
+     * @brief Get a typed, read only view onto the stream of a specific element
+     * 
+     * @warning this only works for separately stored vertices
+     * 
+     * @tparam T the type of a single element (the size must match the size of the element's data type)
+     * @param type the type of the element to quarry the stream for
+     * @return std::span<const T> a span over the element stream or an empty span if the stream is not available
+     */
+    template <typename T> inline std::span<const T> getElementStream(VertexElementType type) const noexcept {
+        //the size of the requested type must match the stored data
+        uint64_t idx = m_layout.getIndexOfElement(type);
+        if ((idx == UINT64_MAX) || (m_layout.getElementSize(idx) != sizeof(T))) {return {};}
+        //get the stream and wrap it
+        const T* stream = (const T*)getElementStream(type);
+        return stream ? std::span<const T>(stream, m_vertexCount) : std::span<const T>();
+    }
+
+    /**
+     * @brief Get a typed, writable view onto the stream of a specific element
+     * 
+     * Referenced vertex data is copied to memory owned by the mesh first, so writing never modifies external memory.
+     * 
+     * @warning this only works for separately stored vertices
+     * 
+     * @tparam T the type of a single element (the size must match the size of the element's data type)
+     * @param type the type of the element to quarry the stream for
+     * @return std::span<T> a span over the element stream or an empty span if the stream is not available
+     */
+    template <typename T> inline std::span<T> getElementStream(VertexElementType type) noexcept {
+        //the size of the requested type must match the stored data
+        uint64_t idx = m_layout.getIndexOfElement(type);
+        if ((idx == UINT64_MAX) || (m_layout.getElementSize(idx) != sizeof(T))) {return {};}
+        //get the writable stream and wrap it
+        T* stream = (T*)getElementStream(type);
+        return stream ? std::span<T>(stream, m_vertexCount) : std::span<T>();
+    }
+
+    /**
+     * @brief Get a typed view onto an element of all vertices for a vertex layout that is known at compile time
+     * 
+     * The offset, the stride and the type of the element are resolved while compiling, so no data type has to be checked
+     * per vertex. Works for interleaved and separately stored vertices.
+     * 
+     * @tparam Layout the layout the mesh is expected to have (like GLGE_VERTEX_LAYOUT_VERTEX)
+     * @tparam Type the type of the element to access
+     * @return VertexAttributeView<const typename VertexLayoutElement<Layout, Type>::Value> a read only view onto the element or an empty view if the mesh uses a different layout
+     */
+    template <VertexLayout Layout, VertexElementType Type>
+    inline VertexAttributeView<const typename VertexLayoutElement<Layout, Type>::Value> getAttribute() const noexcept {
+        using Element = VertexLayoutElement<Layout, Type>;
+        if ((m_layout != Layout) || !m_vertices.data()) {return {};}
+        return Element::template view<const typename Element::Value>(m_vertices.data(), m_vertexCount, m_storage);
+    }
+
+    /**
+     * @brief Get a writable typed view onto an element of all vertices for a vertex layout that is known at compile time
+     * 
+     * Referenced vertex data is copied to memory owned by the mesh first, so writing never modifies external memory.
+     * 
+     * @tparam Layout the layout the mesh is expected to have (like GLGE_VERTEX_LAYOUT_VERTEX)
+     * @tparam Type the type of the element to access
+     * @return VertexAttributeView<typename VertexLayoutElement<Layout, Type>::Value> a view onto the element or an empty view if the mesh uses a different layout
+     */
+    template <VertexLayout Layout, VertexElementType Type>
+    inline VertexAttributeView<typename VertexLayoutElement<Layout, Type>::Value> getAttribute() noexcept {
+        using Element = VertexLayoutElement<Layout, Type>;
+        if ((m_layout != Layout) || !m_vertices.data()) {return {};}
+        m_vertices.makeUnique();
+        return Element::view(m_vertices.data(), m_vertexCount, m_storage);
+    }
+
+    /**
+     * @brief call a function with a typed, read only view onto an element of all vertices
+     * 
+     * The data type of the element is dispatched once per call, so the function runs its loop without checking the type
+     * of every vertex. The function is instantiated for every data type, see visitVertexAttribute.
+     * 
+     * @tparam Func the type of the function
+     * @param type the type of the element to visit
+     * @param func the function to call with a VertexAttributeView<const T>
+     * @return true : the function was called
+     * @return false : the element does not exist or its data type has no C++ representation
+     */
+    template <typename Func> inline bool visitAttribute(VertexElementType type, Func&& func) const noexcept {
+        uint64_t idx = m_layout.getIndexOfElement(type);
+        if ((idx == UINT64_MAX) || !m_vertices.data()) {return false;}
+        uint64_t stride = 0;
+        const uint8_t* base = __getAttributeBase(idx, stride);
+        return visitVertexAttribute<true>(base, stride, m_vertexCount, m_layout.m_elements[idx].data, std::forward<Func>(func));
+    }
+
+    /**
+     * @brief call a function with a typed, writable view onto an element of all vertices
+     * 
+     * Referenced vertex data is copied to memory owned by the mesh first, so writing never modifies external memory.
+     * 
+     * @tparam Func the type of the function
+     * @param type the type of the element to visit
+     * @param func the function to call with a VertexAttributeView<T>
+     * @return true : the function was called
+     * @return false : the element does not exist or its data type has no C++ representation
+     */
+    template <typename Func> inline bool visitAttribute(VertexElementType type, Func&& func) noexcept {
+        uint64_t idx = m_layout.getIndexOfElement(type);
+        if ((idx == UINT64_MAX) || !m_vertices.data()) {return false;}
+        m_vertices.makeUnique();
+        uint64_t stride = 0;
+        uint8_t* base = __getAttributeBase(idx, stride);
+        return visitVertexAttribute<false>(base, stride, m_vertexCount, m_layout.m_elements[idx].data, std::forward<Func>(func));
+    }
+
+    /**
+     * @brief convert interleaved vertex data to separately stored vertex data
+     * 
+     * @param src a pointer to the interleaved vertices
+     * @param dst a pointer to the buffer to write the element streams to (must not overlap with the source)
+     * @param vertexCount the amount of vertices to convert
+     * @param layout the layout of a single vertex
+     */
+    static void deinterleave(const void* src, void* dst, uint64_t vertexCount, const VertexLayout& layout) noexcept;
+
+    /**
+     * @brief convert separately stored vertex data to interleaved vertex data
+     * 
+     * @param src a pointer to the element streams
+     * @param dst a pointer to the buffer to write the interleaved vertices to (must not overlap with the source)
+     * @param vertexCount the amount of vertices to convert
+     * @param layout the layout of a single vertex
+     */
+    static void interleave(const void* src, void* dst, uint64_t vertexCount, const VertexLayout& layout) noexcept;
+
     /**
      * @brief Get the Vertices of the mesh
      * 
+     * @return const void* a read only pointer to the raw vertex data
+     */
+    inline constexpr const void* getVertices() const noexcept {return m_vertices.data();}
+
+    /**
+     * @brief Get the writable Vertices of the mesh
+     * 
+     * Referenced vertex data is copied to memory owned by the mesh first, so writing never modifies external memory.
+     * 
      * @return void* a pointer to the raw vertex data
      */
-    inline constexpr void* getVertices() const noexcept {return m_vertices;}
+    inline void* getVertices() noexcept {
+        m_vertices.makeUnique();
+        return m_vertices.data();
+    }
 
     /**
      * @brief Get the Vertices of the mesh
      * 
      * @tparam T the type for the vertex data
-     * @return constexpr T* a pointer to the raw vertex data
+     * @return constexpr const T* a read only pointer to the raw vertex data
      */
-    template <typename T> inline constexpr T* getVertices() const noexcept {return (T*)m_vertices;}
+    template <typename T> inline constexpr const T* getVertices() const noexcept {return (const T*)m_vertices.data();}
+
+    /**
+     * @brief Get the writable Vertices of the mesh
+     * 
+     * Referenced vertex data is copied to memory owned by the mesh first, so writing never modifies external memory.
+     * 
+     * @tparam T the type for the vertex data
+     * @return T* a pointer to the raw vertex data
+     */
+    template <typename T> inline T* getVertices() noexcept {return (T*)getVertices();}
 
     /**
      * @brief Get the amount of vertices
@@ -147,30 +501,193 @@ public:
      */
     inline constexpr uint64_t getVertexCount() const noexcept {return m_vertexCount;}
 
+    /**
+     * @brief Get who is responsible for the memory of the vertices
+     * 
+     * @return constexpr BufferOwnership the ownership of the vertex buffer
+     */
+    inline constexpr BufferOwnership getVertexOwnership() const noexcept {return m_vertices.getOwnership();}
+
+    /**
+     * @brief Get who is responsible for the memory of the indices
+     * 
+     * @return constexpr BufferOwnership the ownership of the index buffer
+     */
+    inline constexpr BufferOwnership getIndexOwnership() const noexcept {return m_indices.getOwnership();}
+
+    /**
+     * @brief copy all referenced data to memory owned by the mesh
+     * 
+     * After this call the mesh does not depend on external memory anymore
+     */
+    inline void makeUnique() noexcept {
+        m_vertices.makeUnique();
+        m_indices.makeUnique();
+    }
+
+    /**
+     * @brief Get the type the indices are stored with
+     * 
+     * @return constexpr IndexType the type of a single index
+     */
+    inline constexpr IndexType getIndexType() const noexcept {return m_indexType;}
+
+    /**
+     * @brief Get the smallest index type that can address a specific amount of vertices
+     * 
+     * @param vertexCount the amount of vertices to address
+     * @return constexpr IndexType the smallest fitting index type
+     */
+    inline static constexpr IndexType getIndexTypeFor(uint64_t vertexCount) noexcept 
+    {return (vertexCount <= ((uint64_t)UINT16_MAX + 1)) ? INDEX_TYPE_UINT16 : INDEX_TYPE_UINT32;}
+
+    /**
+     * @brief change the type the indices are stored with
+     * 
+     * @param type the new index type
+     * @return true : the indices were converted
+     * @return false : the new type can't address all vertices of the mesh
+     */
+    bool setIndexType(IndexType type) noexcept;
+
     /**
      * @brief Get the Indices of the model
      * 
-     * @return constexpr index_t* a pointer to the raw index data
+     * @warning the type of the data depends on the index type of the mesh
+     * 
+     * @return constexpr const void* a read only pointer to the raw index data
+     */
+    inline constexpr const void* getIndices() const noexcept {return m_indices.data();}
+
+    /**
+     * @brief Get the writable Indices of the model
+     * 
+     * Referenced index data is copied to memory owned by the mesh first, so writing never modifies external memory.
+     * 
+     * @warning the type of the data depends on the index type of the mesh
+     * 
+     * @return void* a pointer to the raw index data
+     */
+    inline void* getIndices() noexcept {
+        m_indices.makeUnique();
+        return m_indices.data();
+    }
+
+    /**
+     * @brief Get a typed, read only view onto the indices of the model
+     * 
+     * @tparam T the type of a single index (uint16_t or uint32_t, the size must match the index type)
+     * @return std::span<const T> a span over the indices or an empty span if the type does not match the index type
+     */
+    template <typename T> inline std::span<const T> getIndices() const noexcept {
+        if (sizeof(T) != (uint64_t)m_indexType) {return {};}
+        return std::span<const T>((const T*)m_indices.data(), getIndexCount());
+    }
+
+    /**
+     * @brief Get a typed, writable view onto the indices of the model
+     * 
+     * Referenced index data is copied to memory owned by the mesh first, so writing never modifies external memory.
+     * 
+     * @tparam T the type of a single index (uint16_t or uint32_t, the size must match the index type)
+     * @return std::span<T> a span over the indices or an empty span if the type does not match the index type
+     */
+    template <typename T> inline std::span<T> getIndices() noexcept {
+        if (sizeof(T) != (uint64_t)m_indexType) {return {};}
+        m_indices.makeUnique();
+        return std::span<T>((T*)m_indices.data(), getIndexCount());
+    }
+
+    /**
+     * @brief Get a single index independent of the index type
+     * 
+     * @param i the position of the index in the index buffer
+     * @return index_t the value of the index
+     */
+    inline index_t getIndex(uint64_t i) const noexcept {
+        return (m_indexType == INDEX_TYPE_UINT16) ? (index_t)((const uint16_t*)m_indices.data())[i] : ((const uint32_t*)m_indices.data())[i];
+    }
+
+    /**
+     * @brief Set a single index independent of the index type
+     * 
+     * @warning the value must be addressable by the index type
+     * 
+     * @param i the position of the index in the index buffer
+     * @param value the new value of the index
      */
-    inline constexpr index_t* getIndices() const noexcept {return (index_t*)m_indices.data();}
+    inline void setIndex(uint64_t i, index_t value) noexcept {
+        //referenced indices are copied before they are modified
+        m_indices.makeUnique();
+        if (m_indexType == INDEX_TYPE_UINT16) {((uint16_t*)m_indices.data())[i] = (uint16_t)value;}
+        else {((uint32_t*)m_indices.data())[i] = value;}
+    }
+
+    /**
+     * @brief call a function with a typed view onto the indices
+     * 
+     * This dispatches the index type once, so the function can run tight loops over the indices
+     * 
+     * @tparam Func the type of the function. It must accept a std::span<const uint16_t> and a std::span<const uint32_t>. 
+     * @param func the function to call
+     * @return decltype(auto) the return value of the function
+     */
+    template <typename Func> inline decltype(auto) visitIndices(Func&& func) const noexcept {
+        if (m_indexType == INDEX_TYPE_UINT16) {return func(getIndices<uint16_t>());}
+        return func(getIndices<uint32_t>());
+    }
+
+    /**
+     * @brief call a function with a typed, writable view onto the indices
+     * 
+     * Referenced index data is copied to memory owned by the mesh first, so writing never modifies external memory.
+     * 
+     * @tparam Func the type of the function. It must accept a std::span<uint16_t> and a std::span<uint32_t>. 
+     * @param func the function to call
+     * @return decltype(auto) the return value of the function
+     */
+    template <typename Func> inline decltype(auto) visitIndices(Func&& func) noexcept {
+        if (m_indexType == INDEX_TYPE_UINT16) {return func(getIndices<uint16_t>());}
+        return func(getIndices<uint32_t>());
+    }
 
     /**
      * @brief Get the amount of indices in the model
      * 
      * @return constexpr uint64_t the amount of indices in the model
      */
-    inline constexpr uint64_t getIndexCount() const noexcept {return m_indices.size();}
+    inline constexpr uint64_t getIndexCount() const noexcept {return m_indices.size() / (uint64_t)m_indexType;}
 
 protected:
 
+    /**
+     * @brief Get the first byte of an element and the distance between the elements of two vertices
+     * 
+     * @param idx the index of the element in the layout
+     * @param stride a reference to write the distance in bytes to
+     * @return uint8_t* a pointer to the element of the first vertex
+     */
+    inline uint8_t* __getAttributeBase(uint64_t idx, uint64_t& stride) const noexcept {
+        if (m_storage == VERTEX_STORAGE_MODE_SEPARATE) {
+            stride = m_layout.getElementSize(idx);
+            return m_vertices.data() + m_layout.getStreamOffsetOf(idx, m_vertexCount);
+        }
+        stride = m_layout.m_size;
+        return m_vertices.data() + m_layout.getOffsetOf(idx);
+    }
+
     //store the layout of the vertices
     VertexLayout m_layout;
+    //store how the vertices are arranged in memory
+    VertexStorageMode m_storage = VERTEX_STORAGE_MODE_INTERLEAVED;
     //store the amount of stored vertices
     uint64_t m_vertexCount = 0;
-    //store a pointer to the vertex array
-    void* m_vertices = NULL;
-    //store the indices of the mesh
-    std::vector<index_t> m_indices;
+    //store the raw bytes of the vertices
+    MeshBuffer m_vertices;
+    //store the type of a single index
+    IndexType m_indexType = INDEX_TYPE_UINT16;
+    //store the raw bytes of the indices of the mesh
+    MeshBuffer m_indices;
 
 };
 
@@ -194,6 +711,22 @@ typedef struct s_Mesh {byte unused;} Mesh;
  */
 Mesh* mesh_Create(void* vertices, uint64_t vertexCount, const VertexLayout* layout, index_t* indices, uint64_t indexCount);
 
+/**
+ * @brief Construct a new Mesh that references external memory instead of copying it
+ * 
+ * @warning the memory must outlive the mesh. It is copied before the mesh modifies it. 
+ * 
+ * @param vertices a C array containing some form of vertex structure
+ * @param vertexCount the amount of vertices contained in the array
+ * @param layout the layout of a vertex element
+ * @param indices a pointer to an array of indices
+ * @param indexCount the amount of indices in the index array
+ * @param indexType the type of the indices
+ * 
+ * @return a pointer to a new mesh
+ */
+Mesh* mesh_CreateView(void* vertices, uint64_t vertexCount, const VertexLayout* layout, void* indices, uint64_t indexCount, IndexType indexType);
+
 /**
  * @brief delete an existing mesh instance
  * 
@@ -209,6 +742,69 @@ void mesh_Delete(Mesh* mesh);
  */
 const VertexLayout* mesh_GetVertexLayout(Mesh* mesh);
 
+/**
+ * @brief get the way the vertices of a mesh are arranged in memory
+ * 
+ * @param mesh a pointer to the mesh to quarry the data from
+ * @return VertexStorageMode the storage mode of the vertex data
+ */
+VertexStorageMode mesh_GetStorageMode(Mesh* mesh);
+
+/**
+ * @brief re-arrange the vertices of a mesh to follow a different storage mode
+ * 
+ * @param mesh a pointer to the mesh to change the storage of
+ * @param mode the new storage mode of the vertex data
+ */
+void mesh_SetStorageMode(Mesh* mesh, VertexStorageMode mode);
+
+/**
+ * @brief get the stream of a single element of a mesh with separately stored vertices
+ * 
+ * @param mesh a pointer to the mesh to quarry the data from
+ * @param type the type of the element to get the stream for
+ * @return void* a pointer to the element stream or NULL if the stream is not available
+ */
+void* mesh_GetElementStream(Mesh* mesh, VertexElementType type);
+
+/**
+ * @brief merge all vertices of a mesh that are equal or close to each other
+ * 
+ * @param mesh a pointer to the mesh to weld
+ * @param epsilon the grid cell size used to quantize floating point elements. 0 means bit-identical comparison. 
+ * @return uint64_t the amount of removed vertices
+ */
+uint64_t mesh_Weld(Mesh* mesh, float epsilon);
+
+/**
+ * @brief re-compute the normals of a mesh from its triangles
+ * 
+ * @param mesh a pointer to the mesh to re-compute the normals for
+ * @param weighting the way the faces around a vertex are weighted
+ * @return true : the normals were re-computed
+ * @return false : the layout has no position or no normal element of a supported type
+ */
+bool mesh_RecalculateNormals(Mesh* mesh, NormalWeighting weighting);
+
+/**
+ * @brief re-compute the tangents of a mesh from its triangles, normals and first texture coordinates
+ * 
+ * @param mesh a pointer to the mesh to re-compute the tangents for
+ * @return true : the tangents were re-computed
+ * @return false : the layout is missing a required element or one of them has an unsupported type
+ */
+bool mesh_RecalculateTangents(Mesh* mesh);
+
+/**
+ * @brief apply a transform to all vertices of a mesh
+ * 
+ * @param mesh a pointer to the mesh to transform
+ * @param transform a pointer to the transform to apply
+ * @return true : the vertices were transformed
+ * @return false : the layout has no position element or one of the elements has an unsupported type
+ */
+bool mesh_ApplyTransform(Mesh* mesh, const Transform* transform);
+
 /**
  * @brief get the vertices of a mesh
  * 
@@ -229,9 +825,17 @@ uint64_t mesh_GetVertexCount(Mesh* mesh);
  * @brief get the indices of a mesh
  * 
  * @param mesh a pointer to the mesh to quarry the data from
- * @return index_t* a pointer to the indices of the mesh
+ * @return void* a pointer to the indices of the mesh. The type of the indices is given by mesh_GetIndexType. 
+ */
+void* mesh_GetIndices(Mesh* mesh);
+
+/**
+ * @brief get the type the indices of a mesh are stored with
+ * 
+ * @param mesh a pointer to the mesh to quarry the data from
+ * @return IndexType the type of a single index
  */
-index_t* mesh_GetIndices(Mesh* mesh);
+IndexType mesh_GetIndexType(Mesh* mesh);
 
 /**
  * @brief get the amount of indices of a mesh
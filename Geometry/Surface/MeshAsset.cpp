@@ -20,74 +20,52 @@
 
 //add the vertices
 #include "Vertex.h"
+//add the version 2 mesh files
+#include "MeshFile.h"
+//add scenes to instantiate imported hierarchies
+#include "../Structure/ECS/Scene.h"
+//meshes are converted in parallel
+#include "../../Threading/ThreadPool.h"
+//source files are hashed to find cached imports
+#include "../../Filesystem/Hash.h"
+#include "../../Filesystem/MappedFile.h"
+//temporary file names are randomized
+#include <random>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
 
 //add assimp
 #include "assimp/Importer.hpp"
 #include "assimp/scene.h"
 #include "assimp/postprocess.h"
 
-//store the magic number for a mesh asset
+//store the magic number for a version 1 mesh asset. New assets are written as version 2 mesh files. 
 static constexpr const char MESH_ASSET_MAGIC[] = "GLGE_MESH";
+//the lower 16 bits of the vertex type field store the actual vertex type
+static constexpr uint32_t MESH_ASSET_VERTEX_TYPE_MASK = 0xFFFF;
+//if this bit of the vertex type field is set, the indices are stored with 16 bits instead of 32 bits
+static constexpr uint32_t MESH_ASSET_FLAG_16_BIT_INDICES = 1u << 16;
 
 /**
- * @brief a helper function to write a mesh buffer to a file
+ * @brief load a version 1 GLGE mesh asset
  * 
- * @param verts the vertices of the mesh
- * @param indices the indices of the mesh
- * @param path the path of the mesh file to write to
- * @return true : success
- * @return false : failure
- */
-static bool __safeMeshAsset(const std::vector<SimpleVertex>& verts, const std::vector<index_t> indices, const String& path, const String& comment = "") noexcept
-{
-    //create the file to write to
-    std::ofstream f(path, std::ofstream::binary);
-    //sanity check
-    if (!f.is_open()) {return false;}
-
-    //store the magic number
-    f.write(MESH_ASSET_MAGIC, strlen(MESH_ASSET_MAGIC));
-    
-    //store a user-defined, NULL terminated comment
-    if (comment.size() > UINT16_MAX) {GLGE_MESSAGE("[WARNING] The comment is too long: it has more than 65535 characters.");}
-    uint16_t commentLen = (uint16_t)comment.size();
-    f.write((const char*)&commentLen, sizeof(commentLen));
-    //only write a comment with a size > 0
-    if (commentLen) {f.write(comment.data(), comment.size());}
-
-    //then store a number to identify the type of vertex used. Default is 0. 
-    uint32_t vertType = 0;
-    f.write((const char*)&vertType, sizeof(vertType));
-    //first, store the number of vertices
-    uint64_t vertCount = verts.size();
-    f.write((const char*)&vertCount, sizeof(vertCount));
-    //then, store the actual vertex data
-    f.write((const char*)verts.data(), verts.size()*sizeof(SimpleVertex));
-
-    //then, store the number of indices
-    uint64_t indCount = indices.size();
-    f.write((const char*)&indCount, sizeof(indCount));
-    f.write((const char*)indices.data(), indices.size()*sizeof(index_t));
-
-    //success
-    return true;
-}
-
-/**
- * @brief load a GLGE mesh asset
+ * The vertex and index data is read directly into the buffers the mesh will use, so it is never copied
  * 
- * @param verts the vector to fill with the vertices
- * @param indices the vector to fill with the indices
+ * @param verts the buffer to fill with the vertices
+ * @param vertexCount filled with the amount of vertices
+ * @param indices the buffer to fill with the raw bytes of the indices
+ * @param indexType filled with the type of the indices
  * @param path the path to the file to load
  * @return true : successfully loaded the file
  * @return false : failed to load the file / parsing error
  */
-static bool __loadMeshAsset(std::vector<SimpleVertex>& verts, std::vector<index_t>& indices, const String& path) noexcept {
+static bool __loadMeshAsset(MeshBuffer& verts, uint64_t& vertexCount, MeshBuffer& indices, IndexType& indexType, const String& path) noexcept {
     //check if the file exists
     if (!std::filesystem::is_regular_file(path)) {return false;}
 
     //open the file
-    std::ifstream f(path);
+    std::ifstream f(path, std::ifstream::binary);
     if (!f.is_open()) {return false;}
 
     //get the first few bytes of the file
@@ -117,83 +95,197 @@ static bool __loadMeshAsset(std::vector<SimpleVertex>& verts, std::vector<index_
     //get the type of vertex
     uint32_t vertType = 0;
     f.read((char*)&vertType, sizeof(vertType));
+    //files written before the flags existed always have 32 bit indices
+    indexType = (vertType & MESH_ASSET_FLAG_16_BIT_INDICES) ? INDEX_TYPE_UINT16 : INDEX_TYPE_UINT32;
+    vertType &= MESH_ASSET_VERTEX_TYPE_MASK;
 
     //read in the vertex data
     uint64_t vertLen = 0;
     f.read((char*)&vertLen, sizeof(vertLen));
-    verts.resize(vertLen);
-    f.read((char*)verts.data(), verts.size()*sizeof(SimpleVertex));
+    verts = MeshBuffer::allocate(vertLen*sizeof(SimpleVertex));
+    f.read((char*)verts.data(), verts.size());
+    vertexCount = vertLen;
 
     //read the index data
     uint64_t indLen = 0;
     f.read((char*)&indLen, sizeof(indLen));
-    indices.resize(indLen);
-    f.read((char*)indices.data(), indices.size()*sizeof(index_t));
+    indices = MeshBuffer::allocate(indLen * (uint64_t)indexType);
+    f.read((char*)indices.data(), indices.size());
 
-    //success
+    //the file was only read successfully if all bytes were there
+    return (bool)f;
+}
+
+//the flags passed to assimp when importing a file
+static constexpr uint32_t MESH_ASSET_IMPORT_FLAGS = aiProcess_Triangulate | aiProcess_FlipUVs | aiProcess_JoinIdenticalVertices;
+//the version of the conversion code. Increase it when the conversion changes, so old cache entries are not used anymore. 
+static constexpr uint32_t MESH_ASSET_IMPORTER_VERSION = 1;
+
+/**
+ * @brief define what an import produces (different results of the same source must not share a cache entry)
+ */
+typedef enum e_MeshAssetImportKind {
+    //only the first mesh is imported
+    MESH_ASSET_IMPORT_SINGLE = 1,
+    //all meshes and the node hierarchy are imported
+    MESH_ASSET_IMPORT_SCENE
+} MeshAssetImportKind;
+
+/**
+ * @brief compute the cache key of an import
+ * 
+ * @param path the path to the file to import
+ * @param kind what the import produces
+ * @param key filled with the cache key
+ * @return true : the key was computed
+ * @return false : the source file could not be read
+ */
+static bool __importKey(const String& path, MeshAssetImportKind kind, uint64_t& key) noexcept {
+    //hash the bytes of the source file
+    MappedFile source(path);
+    if (!source.isOpen()) {return false;}
+
+    //combine the source hash with everything else that changes the result
+    struct {
+        uint64_t sourceHash;
+        uint32_t importFlags;
+        uint32_t fileVersion;
+        uint32_t importerVersion;
+        uint32_t kind;
+    } desc{glge_Hash64(source.data(), source.size(), 0), MESH_ASSET_IMPORT_FLAGS, GLGE_MESH_FILE_VERSION, MESH_ASSET_IMPORTER_VERSION, (uint32_t)kind};
+    key = glge_Hash64(&desc, sizeof(desc), 0);
+    //0 marks files that were not imported
+    if (key == 0) {key = 1;}
     return true;
 }
 
-String MeshAsset::import(const String& path, const String& suffix) noexcept
-{
-    //store the string without the suffix
-    String path_raw = path;
-    //extract the file suffix
-    size_t pos = path_raw.find_last_of('.');
-    //sanity check (the file may not have a suffix)
-    if (pos != String::npos) {
-        //cut off the suffix
-        path_raw = path_raw.substr(0, pos);
+/**
+ * @brief get the path of the cache entry for an import
+ * 
+ * @param key the cache key of the import
+ * @param suffix the suffix of the asset file
+ * @return std::filesystem::path the path of the cache entry
+ */
+static std::filesystem::path __cachePath(uint64_t key, const String& suffix) noexcept {
+    char name[17]{0};
+    snprintf(name, sizeof(name), "%016llx", (unsigned long long)key);
+    return MeshAsset::getImportCacheDirectory() / (String(name) + "." + suffix);
+}
+
+/**
+ * @brief check if a valid cache entry exists
+ * 
+ * @param path the path of the cache entry
+ * @param key the cache key of the import
+ * @return true : the entry exists and was created by the same import
+ * @return false : the entry does not exist or is invalid
+ */
+static bool __isCached(const std::filesystem::path& path, uint64_t key) noexcept {
+    MeshFile file(path);
+    return file.isOpen() && (file.getHeader()->importKey == key);
+}
+
+/**
+ * @brief write a new cache entry
+ * 
+ * The file is written to a unique temporary file first and then renamed, so concurrent importers never see a half written file. 
+ * If two importers write the same entry, both files are identical and the last rename wins. 
+ * 
+ * @tparam Func the type of the function that writes the file. It gets the temporary path and the write options and returns if it succeeded. 
+ * @param path the path of the cache entry
+ * @param key the cache key of the import
+ * @param write the function that writes the file
+ * @return true : the entry exists now
+ * @return false : failed to write the entry
+ */
+template <typename Func>
+static bool __writeCached(const std::filesystem::path& path, uint64_t key, Func&& write) noexcept {
+    //make sure the cache directory exists
+    std::error_code err;
+    std::filesystem::create_directories(path.parent_path(), err);
+
+    //create a name no other importer uses
+    static std::atomic_uint64_t counter{0};
+    std::random_device random;
+    char suffix[64]{0};
+    snprintf(suffix, sizeof(suffix), ".%08x%08x.%llu.tmp", random(), random(), (unsigned long long)counter.fetch_add(1, std::memory_order_relaxed));
+    std::filesystem::path temp = path;
+    temp += suffix;
+
+    //write and publish the file
+    MeshFileWriteOptions options = MeshAsset::getImportWriteOptions();
+    options.importKey = key;
+    if (!write(temp, options)) {
+        std::filesystem::remove(temp, err);
+        return false;
+    }
+    std::filesystem::rename(temp, path, err);
+    if (err) {
+        //some systems don't replace existing files. If another importer was faster, its file is used. 
+        std::filesystem::remove(temp, err);
+        return __isCached(path, key);
     }
-    //store the path of the asset that will be created
-    String assPath = path_raw + "." + suffix;
-    //check if the asset exists. If it does, just stop. 
-    if (std::filesystem::is_regular_file(assPath))
-    {return assPath;}
+    return true;
+}
 
+/**
+ * @brief read an external file using assimp
+ * 
+ * @param importer the importer that owns the scene
+ * @param path the path to the file to read
+ * @return const aiScene* the read scene or NULL if it could not be read or contains no meshes
+ */
+static const aiScene* __readScene(Assimp::Importer& importer, const String& path) noexcept {
     //load the actual asset
-    Assimp::Importer importer;
-    const aiScene* scene = importer.ReadFile(path.c_str(), aiProcess_Triangulate | aiProcess_FlipUVs | aiProcess_JoinIdenticalVertices);
+    const aiScene* scene = importer.ReadFile(path.c_str(), MESH_ASSET_IMPORT_FLAGS);
     //sanity check
     if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) {
         //print an error
         std::cerr << "[ERROR] Failed to import the file \"" << path << "\" because an error occurred: " << importer.GetErrorString() << "\n";
-        return "";
+        return nullptr;
     }
 
     //if there are no meshes, stop
-    if (scene->mNumMeshes == 0) {return "";}
+    if (scene->mNumMeshes == 0) {return nullptr;}
 
     GLGE_DEBUG_MESSAGE("Successfully imported mesh from \"" << path << "\"");
-    //check if there are more than one meshes
-    //this is a mesh asset. There should be only one. 
-    #if GLGE_BG_DEBUG
-    if (scene->mNumMeshes != 1) {
-        std::cout << "[WARNING] Importing a mesh asset with " << scene->mNumMeshes << ". Only loading mesh 1.\n";
-    }
-    #endif
+    return scene;
+}
 
-    //extract the mesh
-    aiMesh* mesh = scene->mMeshes[0];
+/**
+ * @brief convert a vertex read by assimp to a simple vertex
+ * 
+ * @param mesh the mesh the vertex belongs to
+ * @param i the index of the vertex
+ * @return SimpleVertex the converted vertex
+ */
+static inline SimpleVertex __convertVertex(const aiMesh* mesh, uint64_t i) noexcept {
+    //format the vertex correctly
+    SimpleVertex vert;
+    //store the position. This must always exist. 
+    vert.pos = *((vec3*)&mesh->mVertices[i]);
+    //if normals exist, add them
+    if (mesh->HasNormals())
+    {vert.normal = *((vec3*)&mesh->mNormals[i]);}
+    //only use the texture coordinate at index 0
+    if (mesh->HasTextureCoords(0))
+    {vert.tex = *((vec2*)&(mesh->mTextureCoords[0][i]));}
+    return vert;
+}
 
+/**
+ * @brief convert a mesh read by assimp to a mesh using simple vertices
+ * 
+ * @param mesh the mesh to convert
+ * @return Mesh the converted mesh
+ */
+static Mesh __convertMesh(const aiMesh* mesh) noexcept {
     //make a list of all vectors to store
     std::vector<SimpleVertex> verts;
     verts.reserve(mesh->mNumVertices);
     //iterate and load all vertices in the correct format
-    for (size_t i = 0; i < verts.capacity(); ++i) {
-        //format the vertex correctly
-        SimpleVertex vert;
-        //store the position. This must always exist. 
-        vert.pos = *((vec3*)&mesh->mVertices[i]);
-        //if normals exist, add them
-        if (mesh->HasNormals())
-        {vert.normal = *((vec3*)&mesh->mNormals[i]);}
-        //only use the texture coordinate at index 0
-        if (mesh->HasTextureCoords(0))
-        {vert.tex = *((vec2*)&(mesh->mTextureCoords[0][i]));}
-        //store the new vertex
-        verts.push_back(vert);
-    }
+    for (size_t i = 0; i < verts.capacity(); ++i) 
+    {verts.push_back(__convertVertex(mesh, i));}
 
     //make a list of all indices to store
     std::vector<index_t> indices;
@@ -210,29 +302,268 @@ String MeshAsset::import(const String& path, const String& suffix) noexcept
         indices.push_back(face->mIndices[2]);
     }
 
-    //store the mesh data
-    if (!__safeMeshAsset(verts, indices, assPath)) {return "";}
+    return Mesh(verts.data(), verts.size(), GLGE_VERTEX_LAYOUT_SIMPLE_VERTEX, indices);
+}
+
+/**
+ * @brief describe a mesh read by assimp so it can be written block by block
+ * 
+ * The vertices and indices are converted directly into the blocks of the writer, so no converted copy of the whole mesh exists
+ * 
+ * @param mesh the mesh to stream. It must stay alive until the file is written. 
+ * @return MeshFileStreamEntry the entry for MeshFile::writeStreamed
+ */
+static MeshFileStreamEntry __streamMesh(const aiMesh* mesh) noexcept {
+    MeshFileStreamEntry entry;
+    entry.layout = GLGE_VERTEX_LAYOUT_SIMPLE_VERTEX;
+    entry.vertexCount = mesh->mNumVertices;
+    entry.indexCount = (uint64_t)mesh->mNumFaces * 3;
+    //the blocks are large, so they are converted in parallel
+    constexpr uint64_t GRAIN = 16384;
+    entry.vertices = [mesh](uint64_t first, uint64_t count, void* dst) {
+        SimpleVertex* verts = (SimpleVertex*)dst;
+        ThreadPool::getGlobal().parallelFor(count, GRAIN, [&](uint64_t begin, uint64_t end) {
+            for (uint64_t i = begin; i < end; ++i) {verts[i] = __convertVertex(mesh, first + i);}
+        });
+    };
+    entry.indices = [mesh](uint64_t first, uint64_t count, index_t* dst) {
+        //blocks may start and end in the middle of a face
+        for (uint64_t i = 0; i < count; ++i) {
+            const aiFace& face = mesh->mFaces[(first + i) / 3];
+            GLGE_DEBUG_ASSERT("Found a triangle during mesh import that has " << face.mNumIndices << " corners. What?", face.mNumIndices != 3);
+            dst[i] = face.mIndices[(first + i) % 3];
+        }
+    };
+    return entry;
+}
+
+/**
+ * @brief flatten the node hierarchy of an assimp scene
+ * 
+ * The nodes are stored depth first, so every parent is stored before its children
+ * 
+ * @param root the root node of the scene
+ * @param nodes the list to fill with the nodes
+ */
+static void __collectNodes(const aiNode* root, std::vector<MeshFileSceneNode>& nodes) noexcept {
+    //CAD hierarchies can be very deep, so an explicit stack is used instead of recursion
+    std::vector<std::pair<const aiNode*, uint32_t>> stack{{root, GLGE_MESH_FILE_NO_PARENT}};
+    while (!stack.empty()) {
+        auto [node, parent] = stack.back();
+        stack.pop_back();
+
+        //split the local transformation into its parts
+        aiVector3D scale, pos;
+        aiQuaternion rot;
+        node->mTransformation.Decompose(scale, rot, pos);
+        MeshFileSceneNode converted;
+        converted.name = node->mName.C_Str();
+        converted.parent = parent;
+        converted.transform = Transform(vec3(pos.x, pos.y, pos.z), Quaternion(rot.w, rot.x, rot.y, rot.z), vec3(scale.x, scale.y, scale.z));
+        //a single mesh is stored on the node directly
+        if (node->mNumMeshes == 1) {converted.meshIndex = node->mMeshes[0];}
+        uint32_t index = (uint32_t)nodes.size();
+        nodes.push_back(converted);
+
+        //multiple meshes get one child node each
+        if (node->mNumMeshes > 1) {
+            for (uint32_t i = 0; i < node->mNumMeshes; ++i) {
+                MeshFileSceneNode child;
+                child.name = converted.name + ".mesh" + std::to_string(i);
+                child.parent = index;
+                child.meshIndex = node->mMeshes[i];
+                nodes.push_back(child);
+            }
+        }
+
+        //push the children in reverse to keep their order
+        for (uint32_t i = node->mNumChildren; i > 0; --i)
+        {stack.push_back({node->mChildren[i-1], index});}
+    }
+}
+
+String MeshAsset::import(const String& path, const String& suffix) noexcept
+{
+    //look up the import in the cache
+    uint64_t key = 0;
+    if (!__importKey(path, MESH_ASSET_IMPORT_SINGLE, key)) {return "";}
+    std::filesystem::path assPath = __cachePath(key, suffix);
+    if (__isCached(assPath, key)) {return assPath.string();}
+
+    //load the actual asset
+    Assimp::Importer importer;
+    const aiScene* scene = __readScene(importer, path);
+    if (!scene) {return "";}
+
+    //check if there are more than one meshes
+    //this is a mesh asset. There should be only one. 
+    #if GLGE_BG_DEBUG
+    if (scene->mNumMeshes != 1) {
+        std::cout << "[WARNING] Importing a mesh asset with " << scene->mNumMeshes << ". Only loading mesh 1. Use MeshAsset::importScene to import all meshes.\n";
+    }
+    #endif
+
+    //store the mesh data as a version 2 mesh file so it can be memory mapped when it is loaded
+    const aiMesh* mesh = scene->mMeshes[0];
+    bool written = __writeCached(assPath, key, [&](const std::filesystem::path& temp, const MeshFileWriteOptions& options) {
+        //raw files are streamed block by block, so huge meshes are never copied as a whole. Encoding needs the whole mesh. 
+        if (!options.encode) {return MeshFile::writeStreamed(temp, {__streamMesh(mesh)}, {}, options);}
+        Mesh converted = __convertMesh(mesh);
+        return MeshFile::write(temp, {MeshFileEntry{&converted}}, {}, options);
+    });
+    if (!written) {return "";}
 
     //success
-    return assPath;
+    return assPath.string();
 }
 
-MeshAsset::MeshAsset(const String& path)
+String MeshAsset::importScene(const String& path, const String& suffix) noexcept
 {
-    //set the path to load from
+    //look up the import in the cache
+    uint64_t key = 0;
+    if (!__importKey(path, MESH_ASSET_IMPORT_SCENE, key)) {return "";}
+    std::filesystem::path assPath = __cachePath(key, suffix);
+    if (__isCached(assPath, key)) {return assPath.string();}
+
+    //the file is only parsed once for all meshes
+    Assimp::Importer importer;
+    const aiScene* scene = __readScene(importer, path);
+    if (!scene) {return "";}
+
+    //store the hierarchy next to the meshes
+    std::vector<MeshFileSceneNode> nodes;
+    __collectNodes(scene->mRootNode, nodes);
+    bool written = __writeCached(assPath, key, [&](const std::filesystem::path& temp, const MeshFileWriteOptions& options) {
+        //raw files are streamed mesh by mesh and block by block
+        if (!options.encode) {
+            std::vector<MeshFileStreamEntry> entries;
+            entries.reserve(scene->mNumMeshes);
+            for (uint32_t i = 0; i < scene->mNumMeshes; ++i) {entries.push_back(__streamMesh(scene->mMeshes[i]));}
+            return MeshFile::writeStreamed(temp, entries, nodes, options);
+        }
+
+        //encoding needs whole meshes, convert all meshes in parallel, one task per mesh
+        std::vector<std::optional<Mesh>> meshes(scene->mNumMeshes);
+        ThreadPool::getGlobal().parallelFor(scene->mNumMeshes, 1, [&](uint64_t begin, uint64_t end) {
+            for (uint64_t i = begin; i < end; ++i)
+            {meshes[i].emplace(__convertMesh(scene->mMeshes[i]));}
+        });
+        std::vector<MeshFileEntry> entries(meshes.size());
+        for (size_t i = 0; i < meshes.size(); ++i) {entries[i].mesh = &*meshes[i];}
+        return MeshFile::write(temp, entries, nodes, options);
+    });
+    if (!written) {return "";}
+
+    //success
+    return assPath.string();
+}
+
+std::vector<Object> MeshAsset::instantiate(const String& path, Scene& scene, Object parent) noexcept
+{
+    //only mesh files with a hierarchy can be instantiated
+    MeshFile file(path);
+    if (!file.isOpen()) {return {};}
+    std::span<const MeshFileNode> nodes = file.getNodes();
+    //check all nodes before creating anything, so an invalid file does not leave half a hierarchy behind
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        if ((nodes[i].parent != GLGE_MESH_FILE_NO_PARENT) && (nodes[i].parent >= i)) {return {};}
+        if ((nodes[i].meshIndex != GLGE_MESH_FILE_NO_MESH) && (nodes[i].meshIndex >= file.getMeshCount())) {return {};}
+    }
+
+    //create the objects in node order, parents are always created before their children
+    std::vector<Object> objects;
+    objects.reserve(nodes.size());
+    for (const MeshFileNode& node : nodes) {
+        Transform transform(vec3(node.position[0], node.position[1], node.position[2]),
+                            Quaternion(node.rotation[0], node.rotation[1], node.rotation[2], node.rotation[3]),
+                            vec3(node.scale[0], node.scale[1], node.scale[2]));
+        Object par = (node.parent == GLGE_MESH_FILE_NO_PARENT) ? parent : objects[node.parent];
+        String name(file.getNodeName(node));
+        if (name.empty()) {name = "Node";}
+
+        //only nodes with a mesh reference it
+        if (node.meshIndex != GLGE_MESH_FILE_NO_MESH) {
+            Object obj = scene.createObject<MeshReference>(name, transform, par);
+            *scene.get<MeshReference>(obj) = MeshReference{path, node.meshIndex};
+            objects.push_back(obj);
+        } else
+        {objects.push_back(scene.createObject(name, transform, par));}
+    }
+    return objects;
+}
+
+void MeshAsset::setImportCacheDirectory(const std::filesystem::path& directory) noexcept
+{
+    std::unique_lock lock(m_cacheMutex);
+    m_cacheDirectory = directory;
+}
+
+void MeshAsset::setImportWriteOptions(const MeshFileWriteOptions& options) noexcept
+{
+    std::unique_lock lock(m_cacheMutex);
+    m_importOptions = options;
+}
+
+MeshFileWriteOptions MeshAsset::getImportWriteOptions() noexcept
+{
+    std::unique_lock lock(m_cacheMutex);
+    return m_importOptions;
+}
+
+std::filesystem::path MeshAsset::getImportCacheDirectory() noexcept
+{
+    //use the set directory if there is one
+    {
+        std::unique_lock lock(m_cacheMutex);
+        if (!m_cacheDirectory.empty()) {return m_cacheDirectory;}
+    }
+    //else, the environment may select a shared directory (for example on build machines)
+    const char* env = std::getenv("GLGE_IMPORT_CACHE");
+    if (env && *env) {return std::filesystem::path(env);}
+    //fall back to the temporary directory
+    std::error_code err;
+    std::filesystem::path temp = std::filesystem::temp_directory_path(err);
+    return (err ? std::filesystem::path(".") : temp) / "glge_import_cache";
+}
+
+MeshAsset::MeshAsset(const String& path, uint32_t meshIndex)
+{
+    //set the path and mesh to load from
     m_path = path;
+    m_meshIndex = meshIndex;
 }
 
 void MeshAsset::load() noexcept
 {
     //mark the asset as loading
     updateLoadState(ASSET_STATE_LOADING);
-    //load the data
-    std::vector<SimpleVertex> verts;
-    std::vector<index_t> indices;
-    bool success = __loadMeshAsset(verts, indices, m_path);
-    //store the actual mesh
-    m_ptr = new (m_mesh) Mesh(verts.data(), verts.size(), GLGE_VERTEX_LAYOUT_SIMPLE_VERTEX, indices);
+
+    //version 2 files are mapped into memory and the mesh references the mapped data directly
+    MeshFile file(m_path);
+    if (file.isOpen()) {
+        std::optional<Mesh> mesh = file.createMesh(m_meshIndex);
+        if (mesh) {
+            m_ptr = new (m_mesh) Mesh(std::move(*mesh));
+            updateLoadState(ASSET_STATE_LOADED);
+            return;
+        }
+    }
+
+    //fall back to the version 1 reader
+    MeshBuffer verts;
+    MeshBuffer indices;
+    uint64_t vertexCount = 0;
+    IndexType indexType = INDEX_TYPE_UINT32;
+    //version 1 files only contain a single mesh
+    bool success = (m_meshIndex == 0) && __loadMeshAsset(verts, vertexCount, indices, indexType, m_path);
+    //a failed load results in an empty mesh
+    if (!success) {
+        verts = MeshBuffer();
+        indices = MeshBuffer();
+        vertexCount = 0;
+    }
+    //store the actual mesh. The buffers are moved into the mesh, so the data is not copied again. 
+    m_ptr = new (m_mesh) Mesh(std::move(verts), vertexCount, GLGE_VERTEX_LAYOUT_SIMPLE_VERTEX, std::move(indices), indexType);
     //depending on the success set the next load state
     updateLoadState(success ? ASSET_STATE_LOADED : ASSET_STATE_FAILED);
 }
\ No newline at end of file
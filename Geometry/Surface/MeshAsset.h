@@ -17,12 +17,36 @@
 #include "../../Assets/Assets.h"
 //add the mesh system
 #include "Mesh.h"
+//add mesh files for the import options
+#include "MeshFile.h"
 //add strings
 #include "../../../GLGE_BG/CBinding/String.h"
+//add objects to instantiate imported scenes
+#include "../Structure/ECS/Object.h"
 
 //only available for C++
 #if __cplusplus
 
+//vectors store the instantiated objects
+#include <vector>
+//the import cache is a directory
+#include <filesystem>
+//the cache directory may be changed from any thread
+#include <mutex>
+
+//scenes are only needed when instantiating a hierarchy
+class Scene;
+
+/**
+ * @brief a component that marks which mesh of a mesh file an object uses
+ */
+struct MeshReference {
+    //the path to the mesh file
+    String path;
+    //the index of the mesh in the mesh file
+    uint32_t meshIndex = 0;
+};
+
 /**
  * @brief define what a mesh asset is
  */
@@ -36,20 +60,85 @@ public:
      * @warning this will only load GLGE mesh assets. This will not import other file formats. 
      * 
      * @param path the path to the asset file to load
+     * @param meshIndex the index of the mesh to load if the file contains multiple meshes
      */
-    MeshAsset(const String& path);
+    MeshAsset(const String& path, uint32_t meshIndex = 0);
 
     /**
      * @brief import an external mesh file and convert it to a mesh asset
      * 
-     * @warning this checks if an asset file with that name does exist. If it does, it just returns the path directly
+     * The converted file is stored in the import cache. It is named after a hash of the source bytes, the import flags and the 
+     * format version, so a file is only converted again if one of them changed. 
+     * Unless the import write options encode the data, the mesh is converted and written block by block, so no converted copy 
+     * of the whole mesh is created. The memory used for the blocks is bounded by the stream budget of the import write options. 
      * 
      * @param path the path to the file to import
      * @param suffix the suffix to give to the imported file
-     * @return String the path to the imported file or an empty string if the import failed
+     * @return String the path to the imported file in the import cache or an empty string if the import failed
      */
     static String import(const String& path, const String& suffix = "gm") noexcept;
 
+    /**
+     * @brief import all meshes and the node hierarchy of an external file into a single mesh file
+     * 
+     * The meshes are converted in parallel. Every node of the file becomes a node of the mesh file with its local transformation. 
+     * Nodes that use more than one mesh get one child node per mesh. The result is cached like the result of import. 
+     * 
+     * @param path the path to the file to import
+     * @param suffix the suffix to give to the imported file
+     * @return String the path to the imported file in the import cache or an empty string if the import failed
+     */
+    static String importScene(const String& path, const String& suffix = "gms") noexcept;
+
+    /**
+     * @brief create objects for the node hierarchy stored in a mesh file
+     * 
+     * Every node becomes an object with the node's transformation. Nodes that use a mesh get a MeshReference component. 
+     * 
+     * @param path the path to the mesh file
+     * @param scene the scene to create the objects in
+     * @param parent the object to attach the root nodes to (NULL is interpreted as ROOT and is the default)
+     * @return std::vector<Object> the created objects in the order of the nodes or an empty list if the file has no hierarchy
+     */
+    static std::vector<Object> instantiate(const String& path, Scene& scene, Object parent = NULL) noexcept;
+
+    /**
+     * @brief set the directory imported files are cached in
+     * 
+     * Multiple processes may share the same directory. Files are written to a temporary file first and then renamed, 
+     * so an importer never sees a partially written file. 
+     * 
+     * @param directory the cache directory or an empty path to use the default directory
+     */
+    static void setImportCacheDirectory(const std::filesystem::path& directory) noexcept;
+
+    /**
+     * @brief Get the directory imported files are cached in
+     * 
+     * If no directory was set, the GLGE_IMPORT_CACHE environment variable is used. If that is not set either, 
+     * the directory "glge_import_cache" in the temporary directory of the system is used. 
+     * 
+     * @return std::filesystem::path the path to the cache directory
+     */
+    static std::filesystem::path getImportCacheDirectory() noexcept;
+
+    /**
+     * @brief set how imported files are written
+     * 
+     * The options only change how the data is stored, not the decoded mesh, so they are not part of the cache key. 
+     * Files that are already cached are not rewritten. The import key of the options is ignored. 
+     * 
+     * @param options the options to write imported files with
+     */
+    static void setImportWriteOptions(const MeshFileWriteOptions& options) noexcept;
+
+    /**
+     * @brief Get how imported files are written
+     * 
+     * @return MeshFileWriteOptions the options imported files are written with
+     */
+    static MeshFileWriteOptions getImportWriteOptions() noexcept;
+
     /**
      * @brief access the underlying mesh
      * 
@@ -90,6 +179,23 @@ private:
      * @brief store a path to a mesh asset
      */
     String m_path;
+    /**
+     * @brief store the index of the mesh to load from the file
+     */
+    uint32_t m_meshIndex = 0;
+
+    /**
+     * @brief store the directory set for the import cache (empty = default)
+     */
+    inline static std::filesystem::path m_cacheDirectory;
+    /**
+     * @brief store the options imported files are written with
+     */
+    inline static MeshFileWriteOptions m_importOptions;
+    /**
+     * @brief make sure the cache settings are not changed while they are read
+     */
+    inline static std::mutex m_cacheMutex;
 
 };
 
@@ -0,0 +1,175 @@
+/**
+ * @file MeshBatch.cpp
+ * @author DM8AT
+ * @brief implement the merging of meshes into a batch and the C binding for mesh batches
+ * @version 0.1
+ * @date 2025-11-08
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ */
+
+//include the mesh batch api
+#include "MeshBatch.h"
+
+//include the thread pool for parallel processing
+#include "../../Threading/ThreadPool.h"
+
+//atomics report failures from the worker threads
+#include <atomic>
+//for minimum and maximum
+#include <algorithm>
+
+/**
+ * @brief copy the indices of a sub mesh to the batched index buffer
+ * 
+ * @tparam Out the type of the batched indices
+ * @param src the mesh to copy the indices from
+ * @param dst a pointer to the first batched index of the sub mesh
+ * @param offset the value added to every index (the first vertex of the sub mesh)
+ * @param flip true to swap the last two indices of every triangle
+ */
+template <typename Out>
+static void __copyIndices(const Mesh& src, Out* dst, uint64_t offset, bool flip) noexcept {
+    uint64_t count = src.getIndexCount();
+    if (count) {
+        src.visitIndices([&](auto indices) {
+            for (uint64_t i = 0; i < count; ++i) {dst[i] = (Out)(indices[i] + offset);}
+        });
+    } else {
+        //meshes without indices are triangle lists
+        count = src.getVertexCount();
+        for (uint64_t i = 0; i < count; ++i) {dst[i] = (Out)(i + offset);}
+    }
+    //swapping two corners reverses the winding of a triangle
+    if (flip) {
+        for (uint64_t i = 0; i + 2 < count; i += 3) {std::swap(dst[i+1], dst[i+2]);}
+    }
+}
+
+bool MeshBatch::build(std::span<const MeshBatchInput> inputs) noexcept
+{
+    clear();
+    if (inputs.empty()) {return false;}
+
+    //all meshes must share the layout of the first mesh
+    for (const MeshBatchInput& input : inputs) {
+        if (!input.mesh) {return false;}
+        if (!(input.mesh->getVertexLayout() == inputs[0].mesh->getVertexLayout())) {return false;}
+    }
+    const VertexLayout& layout = inputs[0].mesh->getVertexLayout();
+    uint64_t posIdx = layout.getIndexOfElement(VERTEX_ELEMENT_TYPE_POSITION);
+    if (posIdx == UINT64_MAX) {return false;}
+
+    //compute where every sub mesh starts
+    m_ranges.resize(inputs.size());
+    uint64_t vertexCount = 0;
+    uint64_t indexCount = 0;
+    for (uint64_t i = 0; i < inputs.size(); ++i) {
+        const Mesh& mesh = *inputs[i].mesh;
+        MeshBatchRange& range = m_ranges[i];
+        range.firstVertex = vertexCount;
+        range.vertexCount = mesh.getVertexCount();
+        range.firstIndex = indexCount;
+        //a mesh without vertices is not copied, so it must not reserve indices either
+        range.indexCount = (range.vertexCount == 0) ? 0 : (mesh.getIndexCount() ? mesh.getIndexCount() : mesh.getVertexCount());
+        range.bounds = AABB();
+        vertexCount += range.vertexCount;
+        indexCount += range.indexCount;
+    }
+
+    //create the merged mesh with uninitialized buffers, the sub meshes are copied directly to their final place
+    IndexType indexType = Mesh::getIndexTypeFor(vertexCount);
+    m_mesh = Mesh(MeshBuffer::allocate(vertexCount * layout.m_size), vertexCount, layout,
+                  MeshBuffer::allocate(indexCount * (uint64_t)indexType), indexType);
+    uint8_t* vertices = m_mesh.getVertices<uint8_t>();
+    void* indices = m_mesh.getIndices();
+    uint64_t posOffset = layout.getOffsetOf(posIdx);
+
+    //every sub mesh writes to its own range, so the meshes can be processed independently
+    std::atomic_bool failed = false;
+    ThreadPool::getGlobal().parallelFor(inputs.size(), 1, [&](uint64_t begin, uint64_t end) {
+        for (uint64_t i = begin; i < end; ++i) {
+            const Mesh& mesh = *inputs[i].mesh;
+            const Transform& transform = inputs[i].transform;
+            MeshBatchRange& range = m_ranges[i];
+            if (range.vertexCount == 0) {continue;}
+
+            //copy the vertices and interleave them if required
+            uint8_t* dst = vertices + range.firstVertex * layout.m_size;
+            if (mesh.getStorageMode() == VERTEX_STORAGE_MODE_SEPARATE)
+            {Mesh::interleave(mesh.getVertices(), dst, range.vertexCount, layout);}
+            else
+            {memcpy(dst, mesh.getVertices(), range.vertexCount * layout.m_size);}
+
+            //copy the indices, a mirroring transform reverses the winding
+            bool flip = (transform.scale.x * transform.scale.y * transform.scale.z) < 0.f;
+            if (indexType == INDEX_TYPE_UINT16)
+            {__copyIndices(mesh, ((uint16_t*)indices) + range.firstIndex, range.firstVertex, flip);}
+            else
+            {__copyIndices(mesh, ((uint32_t*)indices) + range.firstIndex, range.firstVertex, flip);}
+
+            //bake the transform into the vertices
+            if (!m_mesh.applyTransform(transform, range.firstVertex, range.vertexCount)) {
+                failed = true;
+                continue;
+            }
+
+            //the transformed positions are floats, so they can be read directly
+            float pos[3];
+            memcpy(pos, dst + posOffset, sizeof(pos));
+            range.bounds = AABB(vec3(pos[0], pos[1], pos[2]), vec3(pos[0], pos[1], pos[2]));
+            for (uint64_t v = 1; v < range.vertexCount; ++v) {
+                memcpy(pos, dst + v*layout.m_size + posOffset, sizeof(pos));
+                range.bounds.merge(vec3(pos[0], pos[1], pos[2]));
+            }
+        }
+    });
+    if (failed) {
+        clear();
+        return false;
+    }
+
+    //merge the bounds of all non-empty sub meshes
+    bool first = true;
+    for (const MeshBatchRange& range : m_ranges) {
+        if (range.vertexCount == 0) {continue;}
+        if (first) {m_bounds = range.bounds;}
+        else {m_bounds.merge(range.bounds);}
+        first = false;
+    }
+    return true;
+}
+
+void MeshBatch::clear() noexcept
+{
+    m_mesh = Mesh();
+    m_ranges.clear();
+    m_bounds = AABB();
+}
+
+
+
+MeshBatch* meshBatch_Create(const Mesh* const* meshes, const Transform* transforms, uint64_t count)
+{
+    //collect the inputs
+    std::vector<MeshBatchInput> inputs(count);
+    for (uint64_t i = 0; i < count; ++i) {inputs[i] = MeshBatchInput{meshes[i], transforms[i]};}
+    //only return batches that were build successfully
+    MeshBatch* batch = new MeshBatch();
+    if (!batch->build(inputs)) {
+        delete batch;
+        return NULL;
+    }
+    return batch;
+}
+
+void meshBatch_Delete(MeshBatch* batch) {delete batch;}
+
+Mesh* meshBatch_GetMesh(MeshBatch* batch) {return &batch->getMesh();}
+
+uint64_t meshBatch_GetRangeCount(MeshBatch* batch) {return batch->getRanges().size();}
+
+const MeshBatchRange* meshBatch_GetRanges(MeshBatch* batch) {return batch->getRanges().data();}
+
+AABB meshBatch_GetBounds(MeshBatch* batch) {return batch->getBounds();}
@@ -0,0 +1,196 @@
+/**
+ * @file MeshBatch.h
+ * @author DM8AT
+ * @brief define a utility that merges many small meshes with the same vertex layout into a single mesh
+ * @version 0.1
+ * @date 2025-11-08
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ */
+
+//header guard
+#ifndef _GLGE_CORE_GEOMETRY_SURFACE_MESH_BATCH_
+#define _GLGE_CORE_GEOMETRY_SURFACE_MESH_BATCH_
+
+//include the type definitions
+#include "../../Types.h"
+//include meshes
+#include "Mesh.h"
+//include AABB's for the bounds of the sub meshes
+#include "../Volumes/AABB.h"
+
+/**
+ * @brief store where a single source mesh ended up in a batched mesh
+ */
+typedef struct s_MeshBatchRange {
+    //the index of the first vertex of the sub mesh in the batched vertex buffer
+    uint64_t firstVertex;
+    //the amount of vertices of the sub mesh
+    uint64_t vertexCount;
+    //the index of the first index of the sub mesh in the batched index buffer
+    uint64_t firstIndex;
+    //the amount of indices of the sub mesh
+    uint64_t indexCount;
+    //the bounds of the transformed vertices of the sub mesh
+    AABB bounds;
+} MeshBatchRange;
+
+//the batch class is only available for C++
+#if __cplusplus
+
+//include typed views for the inputs and ranges
+#include <span>
+
+/**
+ * @brief store a single mesh that is added to a batch
+ */
+struct MeshBatchInput {
+    //the mesh to add
+    const Mesh* mesh = nullptr;
+    //the transform that is applied to the vertices of the mesh
+    Transform transform;
+};
+
+/**
+ * @brief merge many meshes that share a vertex layout into a single interleaved vertex and index buffer
+ * 
+ * Static geometry often consists of thousands of tiny meshes, where the cost per object is much higher than the cost of
+ * the triangles themselves. A batch bakes the transform of every mesh into its vertices and appends all of them to one
+ * mesh, so they can be drawn and culled using a single buffer and a table of ranges.
+ * The indices of every sub mesh are offset so they reference the batched vertex buffer. Meshes without indices are
+ * treated as triangle lists and get sequential indices. The triangles of mirrored meshes (an odd amount of negative scale
+ * components) are flipped, so the winding stays the same.
+ * The meshes are copied and transformed in parallel on the global thread pool.
+ */
+class MeshBatch
+{
+public:
+
+    /**
+     * @brief Construct a new Mesh Batch
+     * 
+     * The batch is empty
+     */
+    MeshBatch() = default;
+
+    /**
+     * @brief Construct a new Mesh Batch from a list of meshes
+     * 
+     * @param inputs the meshes to merge and their transforms
+     */
+    inline MeshBatch(std::span<const MeshBatchInput> inputs) noexcept
+    {build(inputs);}
+
+    /**
+     * @brief merge a list of meshes into the batch
+     * 
+     * The previous content of the batch is replaced
+     * 
+     * @param inputs the meshes to merge and their transforms
+     * @return true : the meshes were merged
+     * @return false : the list is empty, a mesh is missing, the vertex layouts differ or the layout can't be transformed. The batch is empty.
+     */
+    bool build(std::span<const MeshBatchInput> inputs) noexcept;
+
+    /**
+     * @brief remove all meshes from the batch
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief Get the merged mesh
+     * 
+     * @return constexpr const Mesh& a constant reference to the mesh that contains all sub meshes
+     */
+    inline constexpr const Mesh& getMesh() const noexcept {return m_mesh;}
+
+    /**
+     * @brief Get the merged mesh
+     * 
+     * @return constexpr Mesh& a reference to the mesh that contains all sub meshes
+     */
+    inline constexpr Mesh& getMesh() noexcept {return m_mesh;}
+
+    /**
+     * @brief Get the ranges of all sub meshes
+     * 
+     * @return std::span<const MeshBatchRange> a range per input mesh in the order the meshes were passed to build
+     */
+    inline std::span<const MeshBatchRange> getRanges() const noexcept {return m_ranges;}
+
+    /**
+     * @brief Get the bounds of the whole batch
+     * 
+     * @return constexpr const AABB& the box that contains all sub meshes
+     */
+    inline constexpr const AABB& getBounds() const noexcept {return m_bounds;}
+
+protected:
+
+    //store the merged mesh
+    Mesh m_mesh;
+    //store the range of every sub mesh
+    std::vector<MeshBatchRange> m_ranges;
+    //store the bounds of all sub meshes
+    AABB m_bounds;
+
+};
+
+#else //else, define an opaque data structure
+
+//define an opaque (MSVC requires the unused byte) for a mesh batch
+typedef struct s_MeshBatch {byte unused;} MeshBatch;
+
+#endif
+
+/**
+ * @brief merge a list of meshes into a new mesh batch
+ * 
+ * @param meshes an array of pointers to the meshes to merge
+ * @param transforms an array with the transform for every mesh
+ * @param count the amount of meshes
+ * @return MeshBatch* a pointer to the new batch or NULL if the meshes can't be merged
+ */
+MeshBatch* meshBatch_Create(const Mesh* const* meshes, const Transform* transforms, uint64_t count);
+
+/**
+ * @brief delete an existing mesh batch
+ * 
+ * @param batch a pointer to the batch to delete
+ */
+void meshBatch_Delete(MeshBatch* batch);
+
+/**
+ * @brief get the merged mesh of a batch
+ * 
+ * @param batch a pointer to the batch to quarry the data from
+ * @return Mesh* a pointer to the mesh that contains all sub meshes. It is owned by the batch.
+ */
+Mesh* meshBatch_GetMesh(MeshBatch* batch);
+
+/**
+ * @brief get the amount of sub meshes in a batch
+ * 
+ * @param batch a pointer to the batch to quarry the data from
+ * @return uint64_t the amount of sub mesh ranges
+ */
+uint64_t meshBatch_GetRangeCount(MeshBatch* batch);
+
+/**
+ * @brief get the ranges of all sub meshes in a batch
+ * 
+ * @param batch a pointer to the batch to quarry the data from
+ * @return const MeshBatchRange* a pointer to the first range
+ */
+const MeshBatchRange* meshBatch_GetRanges(MeshBatch* batch);
+
+/**
+ * @brief get the bounds of a whole batch
+ * 
+ * @param batch a pointer to the batch to quarry the data from
+ * @return AABB the box that contains all sub meshes
+ */
+AABB meshBatch_GetBounds(MeshBatch* batch);
+
+#endif
@@ -0,0 +1,257 @@
+/**
+ * @file MeshBuffer.h
+ * @author DM8AT
+ * @brief define a raw byte buffer for mesh data that may own its memory or only reference it
+ * @version 0.1
+ * @date 2025-11-04
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ */
+
+//header guard
+#ifndef _GLGE_CORE_GEOMETRY_SURFACE_MESH_BUFFER_
+#define _GLGE_CORE_GEOMETRY_SURFACE_MESH_BUFFER_
+
+//include the type definitions
+#include "../../Types.h"
+
+/**
+ * @brief define who is responsible for the memory of a mesh buffer
+ */
+typedef enum e_BufferOwnership {
+    //the buffer owns the memory and frees it when it is destroyed
+    BUFFER_OWNERSHIP_OWNED = 0,
+    //the memory belongs to someone else and must outlive the buffer
+    BUFFER_OWNERSHIP_EXTERNAL,
+    //the memory is kept alive by a shared handle (for example a memory mapped file)
+    BUFFER_OWNERSHIP_SHARED
+} BufferOwnership;
+
+//the buffer class is only available for C++
+#if __cplusplus
+
+//shared pointers keep shared memory alive
+#include <memory>
+//memcpy is used to copy buffers
+#include <cstring>
+//swap is used for the assignment operators
+#include <utility>
+
+/**
+ * @brief store a buffer of raw bytes used by a mesh
+ * 
+ * A buffer either owns its memory, references external memory or references memory that is kept alive by a shared handle.
+ * Buffers that don't own their memory are treated as read only by the mesh: before the mesh modifies the data in place,
+ * it calls makeUnique to copy the data to owned memory (copy on write).
+ */
+class MeshBuffer
+{
+public:
+
+    /**
+     * @brief Construct a new Mesh Buffer
+     * 
+     * The buffer is empty
+     */
+    MeshBuffer() = default;
+
+    /**
+     * @brief create a new buffer with uninitialized, owned memory
+     * 
+     * @param size the size of the buffer in bytes
+     * @return MeshBuffer the new buffer
+     */
+    inline static MeshBuffer allocate(uint64_t size) noexcept {
+        MeshBuffer buff;
+        buff.m_data = size ? new uint8_t[size] : nullptr;
+        buff.m_size = size;
+        return buff;
+    }
+
+    /**
+     * @brief create a buffer that takes over the ownership of an existing allocation
+     * 
+     * @param data the memory to take over
+     * @param size the size of the memory in bytes
+     * @return MeshBuffer the new buffer
+     */
+    inline static MeshBuffer adopt(std::unique_ptr<uint8_t[]>&& data, uint64_t size) noexcept {
+        MeshBuffer buff;
+        buff.m_data = data.release();
+        buff.m_size = size;
+        return buff;
+    }
+
+    /**
+     * @brief create a buffer that references external memory
+     * 
+     * @warning the memory must outlive the buffer and all copies of it
+     * 
+     * @param data a pointer to the memory to reference
+     * @param size the size of the memory in bytes
+     * @return MeshBuffer the new buffer
+     */
+    inline static MeshBuffer view(void* data, uint64_t size) noexcept {
+        MeshBuffer buff;
+        buff.m_data = (uint8_t*)data;
+        buff.m_size = size;
+        buff.m_ownership = BUFFER_OWNERSHIP_EXTERNAL;
+        return buff;
+    }
+
+    /**
+     * @brief create a buffer that references memory that is kept alive by a shared handle
+     * 
+     * @param data a pointer to the memory to reference
+     * @param size the size of the memory in bytes
+     * @param keepAlive a handle that keeps the memory alive as long as any buffer references it
+     * @return MeshBuffer the new buffer
+     */
+    inline static MeshBuffer share(void* data, uint64_t size, std::shared_ptr<const void> keepAlive) noexcept {
+        MeshBuffer buff;
+        buff.m_data = (uint8_t*)data;
+        buff.m_size = size;
+        buff.m_ownership = BUFFER_OWNERSHIP_SHARED;
+        buff.m_keepAlive = std::move(keepAlive);
+        return buff;
+    }
+
+    /**
+     * @brief Construct a new Mesh Buffer by copying another buffer
+     * 
+     * Owned memory is copied. Referenced memory is referenced by the copy as well.
+     * 
+     * @param other the buffer to copy
+     */
+    MeshBuffer(const MeshBuffer& other)
+     : m_data(other.m_data), m_size(other.m_size), m_ownership(other.m_ownership), m_keepAlive(other.m_keepAlive)
+    {
+        //only owned memory needs a real copy
+        if ((m_ownership == BUFFER_OWNERSHIP_OWNED) && m_data) {
+            m_data = new uint8_t[m_size];
+            memcpy(m_data, other.m_data, m_size);
+        }
+    }
+
+    /**
+     * @brief Construct a new Mesh Buffer by moving from another buffer
+     * 
+     * @param other the buffer to move from. It is empty afterwards.
+     */
+    MeshBuffer(MeshBuffer&& other) noexcept
+     : m_data(other.m_data), m_size(other.m_size), m_ownership(other.m_ownership), m_keepAlive(std::move(other.m_keepAlive))
+    {
+        //the other buffer must not free the memory
+        other.m_data = nullptr;
+        other.m_size = 0;
+        other.m_ownership = BUFFER_OWNERSHIP_OWNED;
+    }
+
+    /**
+     * @brief copy another buffer into this buffer
+     * 
+     * @param other the buffer to copy
+     * @return MeshBuffer& a reference to this buffer
+     */
+    inline MeshBuffer& operator=(const MeshBuffer& other) {
+        MeshBuffer copy(other);
+        swap(copy);
+        return *this;
+    }
+
+    /**
+     * @brief move another buffer into this buffer
+     * 
+     * @param other the buffer to move from. It is empty afterwards.
+     * @return MeshBuffer& a reference to this buffer
+     */
+    inline MeshBuffer& operator=(MeshBuffer&& other) noexcept {
+        MeshBuffer moved(std::move(other));
+        swap(moved);
+        return *this;
+    }
+
+    /**
+     * @brief Destroy the Mesh Buffer
+     */
+    ~MeshBuffer() {
+        //only owned memory is freed
+        if ((m_ownership == BUFFER_OWNERSHIP_OWNED) && m_data) {delete[] m_data;}
+    }
+
+    /**
+     * @brief swap the contents of two buffers
+     * 
+     * @param other the buffer to swap with
+     */
+    inline void swap(MeshBuffer& other) noexcept {
+        std::swap(m_data, other.m_data);
+        std::swap(m_size, other.m_size);
+        std::swap(m_ownership, other.m_ownership);
+        std::swap(m_keepAlive, other.m_keepAlive);
+    }
+
+    /**
+     * @brief make sure the buffer owns its memory
+     * 
+     * If the memory is referenced, it is copied to a new, owned allocation. The referenced memory is not modified.
+     * 
+     * @warning this invalidates all pointers to the data if a copy is made
+     */
+    inline void makeUnique() noexcept {
+        //owned memory is allready unique
+        if (m_ownership == BUFFER_OWNERSHIP_OWNED) {return;}
+        //copy to owned memory and drop the reference
+        uint8_t* copy = m_size ? new uint8_t[m_size] : nullptr;
+        if (m_size) {memcpy(copy, m_data, m_size);}
+        m_data = copy;
+        m_ownership = BUFFER_OWNERSHIP_OWNED;
+        m_keepAlive.reset();
+    }
+
+    /**
+     * @brief Get the data of the buffer
+     * 
+     * @return constexpr uint8_t* a pointer to the first byte of the buffer
+     */
+    inline constexpr uint8_t* data() const noexcept {return m_data;}
+
+    /**
+     * @brief Get the size of the buffer
+     * 
+     * @return constexpr uint64_t the size of the buffer in bytes
+     */
+    inline constexpr uint64_t size() const noexcept {return m_size;}
+
+    /**
+     * @brief check if the buffer is empty
+     * 
+     * @return true : the buffer contains no bytes
+     * @return false : the buffer contains bytes
+     */
+    inline constexpr bool empty() const noexcept {return m_size == 0;}
+
+    /**
+     * @brief Get the ownership of the buffer's memory
+     * 
+     * @return constexpr BufferOwnership who is responsible for the memory
+     */
+    inline constexpr BufferOwnership getOwnership() const noexcept {return m_ownership;}
+
+protected:
+
+    //store a pointer to the first byte
+    uint8_t* m_data = nullptr;
+    //store the size of the buffer in bytes
+    uint64_t m_size = 0;
+    //store who is responsible for the memory
+    BufferOwnership m_ownership = BUFFER_OWNERSHIP_OWNED;
+    //store the handle that keeps shared memory alive
+    std::shared_ptr<const void> m_keepAlive;
+
+};
+
+#endif
+
+#endif
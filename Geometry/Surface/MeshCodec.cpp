@@ -0,0 +1,504 @@
+/**
+ * @file MeshCodec.cpp
+ * @author DM8AT
+ * @brief implement the vertex and index encodings
+ * @version 0.1
+ * @date 2025-11-07
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ */
+
+//include the codec
+#include "MeshCodec.h"
+//for the lookup tables
+#include <array>
+//for the limits of the index types
+#include <limits>
+//for minimum and maximum
+#include <algorithm>
+//for the decode buffer
+#include <memory>
+
+//use SSE2 to decode the vertex groups if it is available
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define __GLGE_MESH_CODEC_SSE2 1
+#else
+#define __GLGE_MESH_CODEC_SSE2 0
+#endif
+
+//the amount of bytes in a vertex group
+static constexpr uint64_t VERTEX_GROUP_SIZE = 16;
+//the amount of vertices in a block. A block of every plane is decoded before the vertices are written.
+static constexpr uint64_t VERTEX_BLOCK_SIZE = 256;
+//the size of the edge and vertex FIFOs of the index codec
+static constexpr uint32_t INDEX_FIFO_SIZE = 16;
+//the code of a triangle that shares no edge with a recent triangle
+static constexpr uint8_t INDEX_CODE_NO_EDGE = 0xF0;
+//the vertex code for the next unused vertex
+static constexpr uint8_t INDEX_VERTEX_NEXT = 0;
+//the vertex code for an explicitly stored vertex
+static constexpr uint8_t INDEX_VERTEX_EXPLICIT = 15;
+
+/**
+ * @brief the lookup table to unpack 4 values of 2 bits from a byte
+ */
+static constexpr std::array<uint32_t, 256> UNPACK_2_BIT = []() {
+    std::array<uint32_t, 256> table{};
+    for (uint32_t b = 0; b < 256; ++b)
+    {table[b] = (b & 3) | (((b >> 2) & 3) << 8) | (((b >> 4) & 3) << 16) | (((b >> 6) & 3) << 24);}
+    return table;
+}();
+
+/**
+ * @brief the lookup table to unpack 2 values of 4 bits from a byte
+ */
+static constexpr std::array<uint16_t, 256> UNPACK_4_BIT = []() {
+    std::array<uint16_t, 256> table{};
+    for (uint32_t b = 0; b < 256; ++b)
+    {table[b] = (uint16_t)((b & 15) | ((b >> 4) << 8));}
+    return table;
+}();
+
+/**
+ * @brief decode a group of 16 zigzag encoded byte deltas
+ * 
+ * @param zig the zigzag encoded deltas
+ * @param out the memory to write the 16 decoded bytes to
+ * @param prev the value before the group
+ * @return uint8_t the last value of the group
+ */
+static inline uint8_t __decodeGroup(const uint8_t* zig, uint8_t* out, uint8_t prev) noexcept {
+    #if __GLGE_MESH_CODEC_SSE2
+    //undo the zigzag encoding: (z >> 1) ^ -(z & 1)
+    __m128i z = _mm_loadu_si128((const __m128i*)zig);
+    __m128i d = _mm_xor_si128(_mm_and_si128(_mm_srli_epi16(z, 1), _mm_set1_epi8(0x7F)),
+                              _mm_sub_epi8(_mm_setzero_si128(), _mm_and_si128(z, _mm_set1_epi8(1))));
+    //prefix sum over the 16 deltas
+    d = _mm_add_epi8(d, _mm_slli_si128(d, 1));
+    d = _mm_add_epi8(d, _mm_slli_si128(d, 2));
+    d = _mm_add_epi8(d, _mm_slli_si128(d, 4));
+    d = _mm_add_epi8(d, _mm_slli_si128(d, 8));
+    d = _mm_add_epi8(d, _mm_set1_epi8((char)prev));
+    _mm_storeu_si128((__m128i*)out, d);
+    return out[VERTEX_GROUP_SIZE-1];
+    #else
+    for (uint64_t j = 0; j < VERTEX_GROUP_SIZE; ++j) {
+        prev = (uint8_t)(prev + ((zig[j] >> 1) ^ (uint8_t)-(zig[j] & 1)));
+        out[j] = prev;
+    }
+    return prev;
+    #endif
+}
+
+/**
+ * @brief transpose the decoded planes of a block into the vertices
+ * 
+ * @param planes the decoded planes, every plane is VERTEX_BLOCK_SIZE bytes large
+ * @param dst the first vertex of the block
+ * @param count the amount of vertices in the block
+ * @param stride the size of a single vertex in bytes
+ */
+static inline void __transposeBlock(const uint8_t* planes, uint8_t* dst, uint64_t count, uint64_t stride) noexcept {
+    uint64_t k = 0;
+    #if __GLGE_MESH_CODEC_SSE2
+    //transpose tiles of 16 planes x 16 vertices
+    for (; k + 16 <= stride; k += 16) {
+        for (uint64_t i = 0; i < count; i += 16) {
+            __m128i r[16];
+            for (uint64_t j = 0; j < 16; ++j) {r[j] = _mm_loadu_si128((const __m128i*)(planes + (k + j) * VERTEX_BLOCK_SIZE + i));}
+            //interleave 8, 16, 32 and 64 bit lanes
+            __m128i t[16];
+            for (uint64_t j = 0; j < 8; ++j) {
+                t[j] = _mm_unpacklo_epi8(r[2*j], r[2*j+1]);
+                t[j+8] = _mm_unpackhi_epi8(r[2*j], r[2*j+1]);
+            }
+            for (uint64_t h = 0; h < 2; ++h) {
+                for (uint64_t j = 0; j < 4; ++j) {
+                    r[8*h + j] = _mm_unpacklo_epi16(t[8*h + 2*j], t[8*h + 2*j+1]);
+                    r[8*h + j+4] = _mm_unpackhi_epi16(t[8*h + 2*j], t[8*h + 2*j+1]);
+                }
+            }
+            for (uint64_t q = 0; q < 4; ++q) {
+                for (uint64_t j = 0; j < 2; ++j) {
+                    t[4*q + j] = _mm_unpacklo_epi32(r[4*q + 2*j], r[4*q + 2*j+1]);
+                    t[4*q + j+2] = _mm_unpackhi_epi32(r[4*q + 2*j], r[4*q + 2*j+1]);
+                }
+            }
+            for (uint64_t o = 0; o < 8; ++o) {
+                r[2*o] = _mm_unpacklo_epi64(t[2*o], t[2*o+1]);
+                r[2*o+1] = _mm_unpackhi_epi64(t[2*o], t[2*o+1]);
+            }
+            //row j now holds the 16 planes of vertex i + j
+            uint64_t rows = std::min<uint64_t>(16, count - i);
+            for (uint64_t j = 0; j < rows; ++j) {_mm_storeu_si128((__m128i*)(dst + (i + j) * stride + k), r[j]);}
+        }
+    }
+    #endif
+    //transpose the remaining planes one byte at a time
+    for (uint64_t i = 0; i < count; ++i) {
+        uint8_t* vertex = dst + i * stride;
+        for (uint64_t p = k; p < stride; ++p) {vertex[p] = planes[p * VERTEX_BLOCK_SIZE + i];}
+    }
+}
+
+void MeshCodec::encodeVertices(std::vector<uint8_t>& out, const void* vertices, uint64_t vertexCount, uint64_t stride) noexcept
+{
+    const uint8_t* src = (const uint8_t*)vertices;
+    //the deltas of every plane continue over the blocks
+    std::vector<uint8_t> prev(stride, 0);
+
+    //encode the vertices in blocks, so the decoder can keep a whole block in the L1 cache
+    for (uint64_t block = 0; block < vertexCount; block += VERTEX_BLOCK_SIZE) {
+        uint64_t count = std::min(VERTEX_BLOCK_SIZE, vertexCount - block);
+        uint64_t groups = (count + VERTEX_GROUP_SIZE - 1) / VERTEX_GROUP_SIZE;
+
+        //encode every byte plane on its own
+        for (uint64_t k = 0; k < stride; ++k) {
+            //reserve the bit widths of the groups
+            uint64_t header = out.size();
+            out.resize(header + (groups + 3) / 4, 0);
+
+            for (uint64_t g = 0; g < groups; ++g) {
+                //compute the zigzag encoded deltas of the group. The last group is padded with zero deltas.
+                uint8_t zig[VERTEX_GROUP_SIZE];
+                uint8_t bits = 0;
+                for (uint64_t j = 0; j < VERTEX_GROUP_SIZE; ++j) {
+                    uint64_t i = g * VERTEX_GROUP_SIZE + j;
+                    uint8_t value = (i < count) ? src[(block + i) * stride + k] : prev[k];
+                    int8_t delta = (int8_t)(uint8_t)(value - prev[k]);
+                    zig[j] = (uint8_t)((uint8_t)(delta << 1) ^ (uint8_t)(delta >> 7));
+                    bits |= zig[j];
+                    prev[k] = value;
+                }
+
+                //select the smallest bit width and pack the group
+                uint8_t mode = (bits == 0) ? 0 : ((bits < 4) ? 1 : ((bits < 16) ? 2 : 3));
+                out[header + g / 4] |= (uint8_t)(mode << ((g % 4) * 2));
+                if (mode == 1) {
+                    for (uint64_t b = 0; b < 4; ++b)
+                    {out.push_back((uint8_t)(zig[4*b] | (zig[4*b+1] << 2) | (zig[4*b+2] << 4) | (zig[4*b+3] << 6)));}
+                } else if (mode == 2) {
+                    for (uint64_t b = 0; b < 8; ++b)
+                    {out.push_back((uint8_t)(zig[2*b] | (zig[2*b+1] << 4)));}
+                } else if (mode == 3)
+                {out.insert(out.end(), zig, zig + VERTEX_GROUP_SIZE);}
+            }
+        }
+    }
+}
+
+bool MeshCodec::decodeVertices(void* vertices, uint64_t vertexCount, uint64_t stride, const uint8_t* data, uint64_t size, uint64_t& used) noexcept
+{
+    uint8_t* dst = (uint8_t*)vertices;
+    //store the decoded planes of a single block
+    std::unique_ptr<uint8_t[]> planes(new uint8_t[VERTEX_BLOCK_SIZE * std::max<uint64_t>(stride, 1)]);
+    std::vector<uint8_t> prev(stride, 0);
+
+    uint64_t pos = 0;
+    for (uint64_t block = 0; block < vertexCount; block += VERTEX_BLOCK_SIZE) {
+        uint64_t count = std::min(VERTEX_BLOCK_SIZE, vertexCount - block);
+        uint64_t groups = (count + VERTEX_GROUP_SIZE - 1) / VERTEX_GROUP_SIZE;
+
+        for (uint64_t k = 0; k < stride; ++k) {
+            //read the bit widths of the groups
+            uint64_t headerSize = (groups + 3) / 4;
+            if (headerSize > size - pos) {return false;}
+            const uint8_t* header = data + pos;
+            pos += headerSize;
+
+            uint8_t* plane = planes.get() + k * VERTEX_BLOCK_SIZE;
+            for (uint64_t g = 0; g < groups; ++g) {
+                uint8_t mode = (header[g / 4] >> ((g % 4) * 2)) & 3;
+                uint8_t* out = plane + g * VERTEX_GROUP_SIZE;
+                //groups without changes just repeat the last value
+                if (mode == 0) {
+                    memset(out, prev[k], VERTEX_GROUP_SIZE);
+                    continue;
+                }
+
+                //unpack the group
+                alignas(16) uint8_t zig[VERTEX_GROUP_SIZE];
+                uint64_t groupSize = (mode == 1) ? 4 : ((mode == 2) ? 8 : 16);
+                if (groupSize > size - pos) {return false;}
+                if (mode == 1) {
+                    for (uint64_t b = 0; b < 4; ++b) {memcpy(zig + 4*b, &UNPACK_2_BIT[data[pos + b]], 4);}
+                } else if (mode == 2) {
+                    for (uint64_t b = 0; b < 8; ++b) {memcpy(zig + 2*b, &UNPACK_4_BIT[data[pos + b]], 2);}
+                } else
+                {memcpy(zig, data + pos, VERTEX_GROUP_SIZE);}
+                pos += groupSize;
+                prev[k] = __decodeGroup(zig, out, prev[k]);
+            }
+        }
+
+        //move the block from the planes into the vertices
+        __transposeBlock(planes.get(), dst + block * stride, count, stride);
+    }
+
+    used = pos;
+    return true;
+}
+
+/**
+ * @brief append an unsigned LEB128 varint to a buffer
+ * 
+ * @param out the buffer to append to
+ * @param value the value to append
+ */
+static inline void __writeVarint(std::vector<uint8_t>& out, uint64_t value) noexcept {
+    while (value >= 0x80) {
+        out.push_back((uint8_t)(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back((uint8_t)value);
+}
+
+/**
+ * @brief read an unsigned LEB128 varint
+ * 
+ * @param data the pointer to read from. It is advanced behind the varint.
+ * @param end the end of the readable data
+ * @param value filled with the read value
+ * @return true : the varint was read
+ * @return false : the data ended before the varint did or the varint is too long
+ */
+static inline bool __readVarint(const uint8_t*& data, const uint8_t* end, uint64_t& value) noexcept {
+    value = 0;
+    for (uint32_t shift = 0; shift < 64; shift += 7) {
+        if (data >= end) {return false;}
+        uint8_t byte = *data++;
+        value |= (uint64_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {return true;}
+    }
+    return false;
+}
+
+/**
+ * @brief store the state that the index encoder and decoder share
+ */
+struct IndexCodecState {
+    //the most recent edges
+    uint32_t edges[INDEX_FIFO_SIZE][2];
+    //the position to write the next edge to
+    uint32_t edgeOffset = 0;
+    //the most recent vertices
+    uint32_t vertices[INDEX_FIFO_SIZE];
+    //the position to write the next vertex to
+    uint32_t vertexOffset = 0;
+    //the next vertex that was not used yet
+    uint32_t next = 0;
+    //the last explicitly stored vertex
+    uint32_t last = 0;
+
+    /**
+     * @brief Construct a new Index Codec State
+     */
+    IndexCodecState() noexcept {
+        memset(edges, 0xFF, sizeof(edges));
+        memset(vertices, 0xFF, sizeof(vertices));
+    }
+
+    /**
+     * @brief get an edge by its age
+     * 
+     * @param age 0 for the most recent edge
+     * @return const uint32_t* the two vertices of the edge
+     */
+    inline const uint32_t* edge(uint32_t age) const noexcept {return edges[(edgeOffset - 1 - age) % INDEX_FIFO_SIZE];}
+
+    /**
+     * @brief get a vertex by its age
+     * 
+     * @param age 0 for the most recent vertex
+     * @return uint32_t the vertex
+     */
+    inline uint32_t vertex(uint32_t age) const noexcept {return vertices[(vertexOffset - 1 - age) % INDEX_FIFO_SIZE];}
+
+    /**
+     * @brief add a vertex to the vertex FIFO
+     * 
+     * @param v the vertex to add
+     */
+    inline void pushVertex(uint32_t v) noexcept {vertices[vertexOffset++ % INDEX_FIFO_SIZE] = v;}
+
+    /**
+     * @brief add the edges of a triangle to the edge FIFO
+     * 
+     * The edges are stored reversed, because a neighboring triangle uses its shared edge in the opposite direction
+     * 
+     * @param a the first vertex of the triangle
+     * @param b the second vertex of the triangle
+     * @param c the third vertex of the triangle
+     */
+    inline void pushTriangle(uint32_t a, uint32_t b, uint32_t c) noexcept {
+        const uint32_t tri[3][2] = {{b, a}, {c, b}, {a, c}};
+        for (const auto& e : tri) {
+            edges[edgeOffset % INDEX_FIFO_SIZE][0] = e[0];
+            edges[edgeOffset % INDEX_FIFO_SIZE][1] = e[1];
+            ++edgeOffset;
+        }
+    }
+};
+
+/**
+ * @brief encode a list of indices of a specific type
+ * 
+ * @tparam T the type of the indices
+ * @param out the buffer to append the encoded data to
+ * @param indices a pointer to the first index
+ * @param indexCount the amount of indices
+ */
+template <typename T>
+static void __encodeIndices(std::vector<uint8_t>& out, const T* indices, uint64_t indexCount) noexcept {
+    IndexCodecState state;
+    std::vector<uint8_t> codes;
+    std::vector<uint8_t> data;
+    codes.reserve(indexCount / 3 + 16);
+
+    //encode a single vertex and return its code
+    auto encodeVertex = [&](uint32_t v) -> uint8_t {
+        if (v == state.next) {
+            ++state.next;
+            state.pushVertex(v);
+            return INDEX_VERTEX_NEXT;
+        }
+        for (uint32_t age = 0; age < INDEX_VERTEX_EXPLICIT - 1; ++age)
+        {if (state.vertex(age) == v) {return (uint8_t)(age + 1);}}
+        int64_t delta = (int64_t)v - (int64_t)state.last;
+        __writeVarint(data, (uint64_t)((delta << 1) ^ (delta >> 63)));
+        state.last = v;
+        state.pushVertex(v);
+        return INDEX_VERTEX_EXPLICIT;
+    };
+
+    uint64_t triangleCount = indexCount / 3;
+    for (uint64_t t = 0; t < triangleCount; ++t) {
+        const uint32_t tri[3] = {(uint32_t)indices[3*t], (uint32_t)indices[3*t+1], (uint32_t)indices[3*t+2]};
+
+        //search for an edge that was used by a recent triangle
+        //only 15 edges can be addressed, the last code marks triangles without a shared edge
+        uint32_t found = UINT32_MAX;
+        uint32_t rotation = 0;
+        for (uint32_t age = 0; (age < (INDEX_CODE_NO_EDGE >> 4)) && (found == UINT32_MAX); ++age) {
+            const uint32_t* e = state.edge(age);
+            for (uint32_t r = 0; r < 3; ++r) {
+                if ((e[0] == tri[r]) && (e[1] == tri[(r+1)%3])) {
+                    found = age;
+                    rotation = r;
+                    break;
+                }
+            }
+        }
+
+        if (found != UINT32_MAX) {
+            //rotate the triangle so the shared edge comes first
+            uint32_t a = tri[rotation], b = tri[(rotation+1)%3], c = tri[(rotation+2)%3];
+            codes.push_back((uint8_t)((found << 4) | encodeVertex(c)));
+            state.pushTriangle(a, b, c);
+        } else {
+            codes.push_back(INDEX_CODE_NO_EDGE);
+            uint8_t ca = encodeVertex(tri[0]);
+            uint8_t cb = encodeVertex(tri[1]);
+            uint8_t cc = encodeVertex(tri[2]);
+            codes.push_back((uint8_t)((ca << 4) | cb));
+            codes.push_back(cc);
+            state.pushTriangle(tri[0], tri[1], tri[2]);
+        }
+    }
+
+    //indices that don't form a triangle are stored directly
+    for (uint64_t i = triangleCount * 3; i < indexCount; ++i) {__writeVarint(data, indices[i]);}
+
+    //write the codes followed by the data
+    __writeVarint(out, codes.size());
+    out.insert(out.end(), codes.begin(), codes.end());
+    out.insert(out.end(), data.begin(), data.end());
+}
+
+/**
+ * @brief decode a list of indices to a specific type
+ * 
+ * @tparam T the type of the indices
+ * @param indices the memory to decode to
+ * @param indexCount the amount of indices
+ * @param vertexCount the amount of vertices
+ * @param data the encoded data
+ * @param size the size of the encoded data in bytes
+ * @return true : the indices were decoded
+ * @return false : the data is invalid
+ */
+template <typename T>
+static bool __decodeIndices(T* indices, uint64_t indexCount, uint64_t vertexCount, const uint8_t* data, uint64_t size) noexcept {
+    const uint8_t* end = data + size;
+    uint64_t codeSize = 0;
+    if (!__readVarint(data, end, codeSize) || (codeSize > (uint64_t)(end - data))) {return false;}
+    const uint8_t* code = data;
+    const uint8_t* codeEnd = data + codeSize;
+    const uint8_t* extra = codeEnd;
+
+    //all indices must address a vertex and fit into the index type
+    uint64_t limit = std::min<uint64_t>(vertexCount, (uint64_t)std::numeric_limits<T>::max() + 1);
+    IndexCodecState state;
+
+    //decode a single vertex from its code
+    auto decodeVertex = [&](uint8_t c, uint32_t& v) -> bool {
+        if (c == INDEX_VERTEX_NEXT) {
+            v = state.next++;
+            state.pushVertex(v);
+        } else if (c == INDEX_VERTEX_EXPLICIT) {
+            uint64_t zig = 0;
+            if (!__readVarint(extra, end, zig)) {return false;}
+            int64_t delta = (int64_t)(zig >> 1) ^ -(int64_t)(zig & 1);
+            v = (uint32_t)((int64_t)state.last + delta);
+            state.last = v;
+            state.pushVertex(v);
+        } else
+        {v = state.vertex(c - 1);}
+        return v < limit;
+    };
+
+    uint64_t triangleCount = indexCount / 3;
+    for (uint64_t t = 0; t < triangleCount; ++t) {
+        if (code >= codeEnd) {return false;}
+        uint8_t c = *code++;
+        uint32_t a = 0, b = 0, v = 0;
+        if (c < INDEX_CODE_NO_EDGE) {
+            //the triangle starts with a recent edge
+            const uint32_t* e = state.edge(c >> 4);
+            a = e[0];
+            b = e[1];
+            if ((a >= limit) || (b >= limit) || !decodeVertex(c & 15, v)) {return false;}
+        } else {
+            if (codeEnd - code < 2) {return false;}
+            uint8_t ab = *code++;
+            uint8_t cc = *code++;
+            if (!decodeVertex(ab >> 4, a) || !decodeVertex(ab & 15, b) || !decodeVertex(cc & 15, v)) {return false;}
+        }
+        indices[3*t] = (T)a;
+        indices[3*t+1] = (T)b;
+        indices[3*t+2] = (T)v;
+        state.pushTriangle(a, b, v);
+    }
+
+    //read the indices that don't form a triangle
+    for (uint64_t i = triangleCount * 3; i < indexCount; ++i) {
+        uint64_t v = 0;
+        if (!__readVarint(extra, end, v) || (v >= limit)) {return false;}
+        indices[i] = (T)v;
+    }
+    return true;
+}
+
+void MeshCodec::encodeIndices(std::vector<uint8_t>& out, const void* indices, uint64_t indexCount, IndexType type) noexcept
+{
+    if (type == INDEX_TYPE_UINT16) {__encodeIndices(out, (const uint16_t*)indices, indexCount);}
+    else {__encodeIndices(out, (const uint32_t*)indices, indexCount);}
+}
+
+bool MeshCodec::decodeIndices(void* indices, uint64_t indexCount, IndexType type, uint64_t vertexCount, const uint8_t* data, uint64_t size) noexcept
+{
+    if (type == INDEX_TYPE_UINT16) {return __decodeIndices((uint16_t*)indices, indexCount, vertexCount, data, size);}
+    return __decodeIndices((uint32_t*)indices, indexCount, vertexCount, data, size);
+}
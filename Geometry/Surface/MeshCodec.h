@@ -0,0 +1,106 @@
+/**
+ * @file MeshCodec.h
+ * @author DM8AT
+ * @brief define lossless encodings for vertex and index data that make mesh files smaller and decode quickly
+ * @version 0.1
+ * @date 2025-11-07
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ */
+
+//header guard
+#ifndef _GLGE_CORE_GEOMETRY_SURFACE_MESH_CODEC_
+#define _GLGE_CORE_GEOMETRY_SURFACE_MESH_CODEC_
+
+//include the type definitions
+#include "../../Types.h"
+//include meshes for the index types
+#include "Mesh.h"
+
+//the codec is only available for C++
+#if __cplusplus
+
+//vectors store the encoded data
+#include <vector>
+
+/*
+ * Vertex encoding:
+ * The vertices are stored in blocks of 256 vertices. Every block is split into byte planes (byte k of every vertex). Every plane
+ * stores the difference of each byte to the same byte of the previous vertex as a zigzag encoded byte. The planes are split into
+ * groups of 16 bytes, and every group is bit packed with 0, 2, 4 or 8 bits per byte. A plane starts with 2 bits per group that
+ * select the bit width, followed by the packed groups. Neighboring vertices are usually similar, so most groups need only 0 - 4 bits
+ * per byte. The decoder unpacks a whole block into the L1 cache and transposes it into the vertices using SSE2.
+ * 
+ * Index encoding:
+ * Triangles are encoded relative to a FIFO of the last 16 edges and a FIFO of the last 16 vertices. A triangle that shares an
+ * edge with a recent triangle only stores the edge and its third vertex. Vertices are stored as "next unused vertex", as
+ * position in the vertex FIFO or as a zigzag varint delta to the last explicitly stored vertex.
+ * The decoded triangles may be rotated compared to the input (the winding is kept).
+ */
+
+/**
+ * @brief a static class that encodes and decodes mesh data
+ */
+class MeshCodec final
+{
+public:
+
+    /**
+     * @brief encode a stream of vertices and append it to a buffer
+     * 
+     * @param out the buffer to append the encoded data to
+     * @param vertices a pointer to the first vertex
+     * @param vertexCount the amount of vertices to encode
+     * @param stride the size of a single vertex in bytes
+     */
+    static void encodeVertices(std::vector<uint8_t>& out, const void* vertices, uint64_t vertexCount, uint64_t stride) noexcept;
+
+    /**
+     * @brief decode a stream of vertices that was encoded using encodeVertices
+     * 
+     * @param vertices the memory to decode the vertices to. Must be at least vertexCount * stride bytes large.
+     * @param vertexCount the amount of encoded vertices
+     * @param stride the size of a single vertex in bytes
+     * @param data a pointer to the encoded data
+     * @param size the amount of bytes available at data
+     * @param used filled with the amount of bytes the stream used
+     * @return true : the vertices were decoded
+     * @return false : the data is too short
+     */
+    static bool decodeVertices(void* vertices, uint64_t vertexCount, uint64_t stride, const uint8_t* data, uint64_t size, uint64_t& used) noexcept;
+
+    /**
+     * @brief encode a list of triangle indices and append it to a buffer
+     * 
+     * @param out the buffer to append the encoded data to
+     * @param indices a pointer to the first index
+     * @param indexCount the amount of indices. Indices that don't form a full triangle are stored without compression.
+     * @param type the type of the indices
+     */
+    static void encodeIndices(std::vector<uint8_t>& out, const void* indices, uint64_t indexCount, IndexType type) noexcept;
+
+    /**
+     * @brief decode a list of triangle indices that was encoded using encodeIndices
+     * 
+     * @param indices the memory to decode the indices to. Must be at least indexCount * type bytes large.
+     * @param indexCount the amount of encoded indices
+     * @param type the type of the indices to decode to
+     * @param vertexCount the amount of vertices. Decoding fails if an index is not smaller than this.
+     * @param data a pointer to the encoded data
+     * @param size the amount of bytes available at data
+     * @return true : the indices were decoded
+     * @return false : the data is invalid
+     */
+    static bool decodeIndices(void* indices, uint64_t indexCount, IndexType type, uint64_t vertexCount, const uint8_t* data, uint64_t size) noexcept;
+
+private:
+
+    //the class is static only
+    MeshCodec() = delete;
+
+};
+
+#endif
+
+#endif
@@ -0,0 +1,537 @@
+/**
+ * @file MeshFile.cpp
+ * @author DM8AT
+ * @brief implement reading and writing of version 2 mesh files
+ * @version 0.1
+ * @date 2025-11-05
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ */
+
+//include mesh files
+#include "MeshFile.h"
+//include bounding volumes to pre-compute the bounds
+#include "../Volumes/AABB.h"
+#include "../Volumes/Sphere.h"
+
+//include the codec for encoded sections
+#include "MeshCodec.h"
+//encoded sections may be compressed
+#include "../../Filesystem/Compression.h"
+//meshes are encoded in parallel
+#include "../../Threading/ThreadPool.h"
+
+//add the GLGE debugging stuff
+#include "../../../GLGE_BG/Debugging/Logging/__BG_SimpleDebug.h"
+
+//files are written using the C++ file streams
+#include <fstream>
+//for minimum and maximum
+#include <algorithm>
+
+/**
+ * @brief round a value up to the alignment of the sections
+ * 
+ * @param value the value to align
+ * @return uint64_t the next multiple of the section alignment
+ */
+static inline uint64_t __alignSection(uint64_t value) noexcept
+{return (value + GLGE_MESH_FILE_ALIGNMENT - 1) & ~((uint64_t)GLGE_MESH_FILE_ALIGNMENT - 1);}
+
+/**
+ * @brief call a function for every vertex stream of a mesh
+ * 
+ * Interleaved vertices are a single stream. Separated vertices have one stream per vertex element. 
+ * 
+ * @tparam Func the type of the function. It gets the offset of the stream in bytes and the stride of the stream and returns if it succeeded. 
+ * @param layout the layout of the vertices
+ * @param storage the way the vertices are stored
+ * @param vertexCount the amount of vertices
+ * @param func the function to call
+ * @return true : the function succeeded for all streams
+ * @return false : the function failed for a stream
+ */
+template <typename Func>
+static bool __forEachStream(const VertexLayout& layout, VertexStorageMode storage, uint64_t vertexCount, Func&& func) noexcept {
+    if (storage == VERTEX_STORAGE_MODE_INTERLEAVED) {return func(0, layout.m_size);}
+    for (uint64_t i = 0; i < VERTEX_ELEMENT_TYPE_COUNT; ++i) {
+        uint64_t size = layout.getElementSize(i);
+        if (size == 0) {continue;}
+        if (!func(layout.getStreamOffsetOf(i, vertexCount), size)) {return false;}
+    }
+    return true;
+}
+
+/**
+ * @brief get the encoded data of an encoded section
+ * 
+ * @param file a pointer to the first byte of the file
+ * @param section the encoded section
+ * @param storage used to store the data if it must be decompressed
+ * @param data filled with a pointer to the encoded data
+ * @param size filled with the size of the encoded data
+ * @return true : the data is available
+ * @return false : the section is invalid
+ */
+static bool __getEncodedData(const uint8_t* file, const MeshFileSection& section, String& storage, const uint8_t*& data, uint64_t& size) noexcept {
+    if (section.size < sizeof(MeshFileEncoding)) {return false;}
+    const MeshFileEncoding* encoding = (const MeshFileEncoding*)(file + section.offset);
+    if (encoding->storedSize > section.size - sizeof(MeshFileEncoding)) {return false;}
+    data = file + section.offset + sizeof(MeshFileEncoding);
+    size = encoding->encodedSize;
+
+    //uncompressed data is used directly from the file
+    if (!(encoding->flags & GLGE_MESH_FILE_ENCODING_FLAG_ZLIB)) {return size <= encoding->storedSize;}
+    storage.assign((const char*)data, encoding->storedSize);
+    glge_Decompress(&storage, nullptr);
+    if (storage.size() != size) {return false;}
+    data = (const uint8_t*)storage.data();
+    return true;
+}
+
+/**
+ * @brief build an encoded section from encoded data
+ * 
+ * @param encoded the encoded data. It is replaced with the section content.
+ * @param options the options that select if the data is compressed
+ */
+static void __finishEncodedSection(std::vector<uint8_t>& encoded, const MeshFileWriteOptions& options) noexcept {
+    MeshFileEncoding encoding{0, 0, encoded.size(), encoded.size(), 0};
+    String compressed;
+    if (options.compress && !encoded.empty()) {
+        //only keep the compressed data if it is smaller
+        compressed.assign((const char*)encoded.data(), encoded.size());
+        uint32_t level = (uint32_t)options.compressionLevel;
+        glge_Compress(&compressed, &level);
+        if (!compressed.empty() && (compressed.size() < encoded.size())) {
+            encoding.flags |= GLGE_MESH_FILE_ENCODING_FLAG_ZLIB;
+            encoding.storedSize = compressed.size();
+        }
+    }
+
+    //prepend the encoding to the stored data
+    std::vector<uint8_t> section(sizeof(MeshFileEncoding) + encoding.storedSize);
+    memcpy(section.data(), &encoding, sizeof(encoding));
+    //empty sections have no data pointer to copy from
+    if (encoding.storedSize) {
+        memcpy(section.data() + sizeof(encoding), (encoding.flags & GLGE_MESH_FILE_ENCODING_FLAG_ZLIB) ? (const uint8_t*)compressed.data() : encoded.data(), 
+               encoding.storedSize);
+    }
+    encoded = std::move(section);
+}
+
+bool MeshFile::isMeshFile(const void* data, uint64_t size) noexcept
+{
+    //the file must at least contain the header
+    if (!data || (size < sizeof(MeshFileHeader))) {return false;}
+    const MeshFileHeader* header = (const MeshFileHeader*)data;
+    return (memcmp(header->magic, GLGE_MESH_FILE_MAGIC, sizeof(header->magic)) == 0) && (header->version == GLGE_MESH_FILE_VERSION);
+}
+
+bool MeshFile::open(const std::filesystem::path& path) noexcept
+{
+    //if a file is open, close it
+    close();
+
+    //map the file
+    std::shared_ptr<MappedFile> file = std::make_shared<MappedFile>(path);
+    if (!file->isOpen()) {return false;}
+    //check the header
+    if (!isMeshFile(file->data(), file->size())) {return false;}
+    const MeshFileHeader* header = (const MeshFileHeader*)file->data();
+    if (header->fileSize != file->size()) {
+        GLGE_DEBUG_MESSAGE("Failed to open the mesh file: the file size does not match the size stored in the header");
+        return false;
+    }
+    //check that the section table is inside the file
+    if ((header->sectionTableOffset > file->size()) ||
+        (header->sectionCount > (file->size() - header->sectionTableOffset) / sizeof(MeshFileSection))) {
+        GLGE_DEBUG_MESSAGE("Failed to open the mesh file: the section table is out of bounds");
+        return false;
+    }
+    //check that all sections are inside the file and aligned
+    const MeshFileSection* sections = (const MeshFileSection*)(file->data() + header->sectionTableOffset);
+    for (uint32_t i = 0; i < header->sectionCount; ++i) {
+        if ((sections[i].offset > file->size()) || (sections[i].size > file->size() - sections[i].offset) ||
+            (sections[i].offset % GLGE_MESH_FILE_ALIGNMENT)) {
+            GLGE_DEBUG_MESSAGE("Failed to open the mesh file: section " << i << " is out of bounds or not aligned");
+            return false;
+        }
+    }
+
+    //the file is valid
+    m_file = std::move(file);
+    m_header = header;
+    m_sections = sections;
+    return true;
+}
+
+void MeshFile::close() noexcept
+{
+    //meshes may still reference the mapping, so only this reference is dropped
+    m_file.reset();
+    m_header = nullptr;
+    m_sections = nullptr;
+}
+
+const MeshFileSection* MeshFile::findSection(MeshFileSectionType type, uint32_t meshIndex) const noexcept
+{
+    //without a file there are no sections
+    if (!m_header) {return nullptr;}
+    //the section table is small, so a linear search is fine
+    for (uint32_t i = 0; i < m_header->sectionCount; ++i) {
+        if ((m_sections[i].type == (uint32_t)type) && (m_sections[i].meshIndex == meshIndex))
+        {return &m_sections[i];}
+    }
+    return nullptr;
+}
+
+std::optional<Mesh> MeshFile::createMesh(uint32_t meshIndex) const noexcept
+{
+    //get the required sections. The vertices and indices may be stored raw or encoded. 
+    const MeshFileSection* infoSection = findSection(MESH_FILE_SECTION_MESH_INFO, meshIndex);
+    const MeshFileSection* vertSection = findSection(MESH_FILE_SECTION_VERTICES, meshIndex);
+    const MeshFileSection* indSection = findSection(MESH_FILE_SECTION_INDICES, meshIndex);
+    const MeshFileSection* encVertSection = vertSection ? nullptr : findSection(MESH_FILE_SECTION_VERTICES_ENCODED, meshIndex);
+    const MeshFileSection* encIndSection = indSection ? nullptr : findSection(MESH_FILE_SECTION_INDICES_ENCODED, meshIndex);
+    if (!infoSection || !(vertSection || encVertSection) || !(indSection || encIndSection) || (infoSection->size < sizeof(MeshFileMeshInfo))) 
+    {return std::nullopt;}
+    const MeshFileMeshInfo* info = (const MeshFileMeshInfo*)(m_file->data() + infoSection->offset);
+
+    //re-create the vertex layout
+    if (info->elementCount > VERTEX_ELEMENT_TYPE_COUNT) {return std::nullopt;}
+    VertexElement elements[VERTEX_ELEMENT_TYPE_COUNT];
+    for (uint32_t i = 0; i < info->elementCount; ++i)
+    {elements[i] = VertexElement((VertexElementType)info->elements[i][0], (VertexElementDataType)info->elements[i][1]);}
+    VertexLayout layout(elements, info->elementCount);
+    if (layout.m_invalidConstruction) {return std::nullopt;}
+
+    //check that the sections contain all the data
+    if ((info->indexType != INDEX_TYPE_UINT16) && (info->indexType != INDEX_TYPE_UINT32)) {return std::nullopt;}
+    if ((info->storageMode != VERTEX_STORAGE_MODE_INTERLEAVED) && (info->storageMode != VERTEX_STORAGE_MODE_SEPARATE)) {return std::nullopt;}
+    if ((vertSection && (info->vertexCount > vertSection->size / std::max<uint64_t>(layout.m_size, 1))) ||
+        (indSection && (info->indexCount > indSection->size / info->indexType))) {return std::nullopt;}
+
+    //raw data is used directly from the mapped memory
+    //the mapping is shared with the buffers, so it stays alive as long as the mesh references it
+    MeshBuffer vertices;
+    MeshBuffer indices;
+    String storage;
+    if (vertSection) {
+        vertices = MeshBuffer::share(m_file->data() + vertSection->offset, info->vertexCount * layout.m_size, m_file);
+    } else {
+        //decode all vertex streams one after another
+        const uint8_t* data = nullptr;
+        uint64_t size = 0;
+        if (!__getEncodedData(m_file->data(), *encVertSection, storage, data, size)) {return std::nullopt;}
+        vertices = MeshBuffer::allocate(info->vertexCount * layout.m_size);
+        uint64_t pos = 0;
+        bool success = __forEachStream(layout, (VertexStorageMode)info->storageMode, info->vertexCount, [&](uint64_t offset, uint64_t stride) {
+            uint64_t used = 0;
+            if (!MeshCodec::decodeVertices(vertices.data() + offset, info->vertexCount, stride, data + pos, size - pos, used)) {return false;}
+            pos += used;
+            return true;
+        });
+        if (!success) {return std::nullopt;}
+    }
+    if (indSection) {
+        indices = MeshBuffer::share(m_file->data() + indSection->offset, info->indexCount * info->indexType, m_file);
+    } else {
+        const uint8_t* data = nullptr;
+        uint64_t size = 0;
+        if (!__getEncodedData(m_file->data(), *encIndSection, storage, data, size)) {return std::nullopt;}
+        indices = MeshBuffer::allocate(info->indexCount * info->indexType);
+        if (!MeshCodec::decodeIndices(indices.data(), info->indexCount, (IndexType)info->indexType, info->vertexCount, data, size)) 
+        {return std::nullopt;}
+    }
+
+    return Mesh(std::move(vertices), info->vertexCount, layout, std::move(indices), (IndexType)info->indexType, (VertexStorageMode)info->storageMode);
+}
+
+std::string_view MeshFile::getNodeName(const MeshFileNode& node) const noexcept
+{
+    //the name must be inside the name section
+    std::span<const char> names = getSection<char>(MESH_FILE_SECTION_NODE_NAMES, GLGE_MESH_FILE_NO_MESH);
+    if ((node.nameOffset > names.size()) || (node.nameLength > names.size() - node.nameOffset)) {return {};}
+    return std::string_view(names.data() + node.nameOffset, node.nameLength);
+}
+
+/**
+ * @brief store the data of a single section to write
+ */
+struct __MeshFileSectionData {
+    //the table entry of the section
+    MeshFileSection entry;
+    //the data to write or NULL if the data is streamed
+    const void* data;
+};
+
+/**
+ * @brief describe the layout of a mesh for the mesh info section
+ * 
+ * @param info the info to fill
+ * @param layout the layout of the vertices
+ * @param vertexCount the amount of vertices
+ * @param indexCount the amount of indices
+ * @param indexType the type of the indices
+ * @param storage the way the vertices are stored
+ */
+static void __describeMesh(MeshFileMeshInfo& info, const VertexLayout& layout, uint64_t vertexCount, uint64_t indexCount, IndexType indexType, 
+                           VertexStorageMode storage) noexcept {
+    info = MeshFileMeshInfo{};
+    info.vertexCount = vertexCount;
+    info.indexCount = indexCount;
+    info.indexType = (uint32_t)indexType;
+    info.storageMode = (uint32_t)storage;
+    for (uint64_t i = 0; i < VERTEX_ELEMENT_TYPE_COUNT; ++i) {
+        if (layout.m_elements[i].type == VERTEX_ELEMENT_TYPE_UNDEFINED) {continue;}
+        info.elements[info.elementCount][0] = (uint32_t)layout.m_elements[i].type;
+        info.elements[info.elementCount][1] = (uint32_t)layout.m_elements[i].data;
+        ++info.elementCount;
+    }
+}
+
+/**
+ * @brief convert the bounding box of a mesh to the stored bounds
+ * 
+ * @param box the bounding box of the mesh
+ * @return MeshFileBounds the box and the sphere that encloses the box
+ */
+static MeshFileBounds __toBounds(const AABB& box) noexcept {
+    Sphere sphere((box.min + box.max) * 0.5f, length((box.max - box.min) * 0.5f));
+    return MeshFileBounds{{box.min.x, box.min.y, box.min.z}, {box.max.x, box.max.y, box.max.z},
+                          {sphere.pos.x, sphere.pos.y, sphere.pos.z}, sphere.radius};
+}
+
+/**
+ * @brief add the optional sections of a mesh
+ * 
+ * @param sections the sections to add to
+ * @param m the index of the mesh
+ * @param lods the levels of detail of the mesh
+ * @param meshlets the meshlets of the mesh
+ */
+static void __addOptionalSections(std::vector<__MeshFileSectionData>& sections, uint32_t m, const std::vector<MeshFileLod>& lods, 
+                                  const std::vector<MeshFileMeshlet>& meshlets) noexcept {
+    if (!lods.empty())
+    {sections.push_back({{MESH_FILE_SECTION_LODS, m, 0, lods.size() * sizeof(MeshFileLod), 0}, lods.data()});}
+    if (!meshlets.empty())
+    {sections.push_back({{MESH_FILE_SECTION_MESHLETS, m, 0, meshlets.size() * sizeof(MeshFileMeshlet), 0}, meshlets.data()});}
+}
+
+/**
+ * @brief convert the scene hierarchy and add its sections
+ * 
+ * @param nodes the nodes to convert
+ * @param meshCount the amount of meshes in the file
+ * @param fileNodes filled with the converted nodes
+ * @param names filled with the names of all nodes
+ * @param sections the sections to add to
+ * @return true : the hierarchy was converted
+ * @return false : a node is invalid
+ */
+static bool __addNodeSections(const std::vector<MeshFileSceneNode>& nodes, uint64_t meshCount, std::vector<MeshFileNode>& fileNodes, String& names,
+                              std::vector<__MeshFileSectionData>& sections) noexcept {
+    fileNodes.resize(nodes.size());
+    for (uint32_t n = 0; n < (uint32_t)nodes.size(); ++n) {
+        const MeshFileSceneNode& node = nodes[n];
+        //parents must be written first so the hierarchy can be rebuilt in a single pass
+        if ((node.parent != GLGE_MESH_FILE_NO_PARENT) && (node.parent >= n)) {return false;}
+        if ((node.meshIndex != GLGE_MESH_FILE_NO_MESH) && (node.meshIndex >= meshCount)) {return false;}
+        fileNodes[n] = MeshFileNode{node.parent, node.meshIndex, (uint32_t)names.size(), (uint32_t)node.name.size(),
+                                    {node.transform.pos.x, node.transform.pos.y, node.transform.pos.z},
+                                    {node.transform.rot.w, node.transform.rot.i, node.transform.rot.j, node.transform.rot.k},
+                                    {node.transform.scale.x, node.transform.scale.y, node.transform.scale.z}, {0, 0}};
+        names += node.name;
+    }
+    if (!fileNodes.empty()) {
+        sections.push_back({{MESH_FILE_SECTION_NODES, GLGE_MESH_FILE_NO_MESH, 0, fileNodes.size() * sizeof(MeshFileNode), 0}, fileNodes.data()});
+        sections.push_back({{MESH_FILE_SECTION_NODE_NAMES, GLGE_MESH_FILE_NO_MESH, 0, names.size(), 0}, names.data()});
+    }
+    return true;
+}
+
+/**
+ * @brief lay out and write a mesh file
+ * 
+ * The sections are written in order, so a streamed section may fill the data of a later section
+ * 
+ * @tparam Func the type of the function that writes streamed sections. It gets the file stream and the section and returns if it succeeded. 
+ * @param path the path of the file to write
+ * @param sections the sections of the file
+ * @param meshCount the amount of meshes in the file
+ * @param options the options to write the file with
+ * @param stream the function that writes the sections without data
+ * @return true : the file was written successfully
+ * @return false : failed to write the file
+ */
+template <typename Func>
+static bool __writeFile(const std::filesystem::path& path, std::vector<__MeshFileSectionData>& sections, uint32_t meshCount, 
+                        const MeshFileWriteOptions& options, Func&& stream) noexcept {
+    //lay out the file: the header, then the section table, then the aligned section data
+    MeshFileHeader header{};
+    memcpy(header.magic, GLGE_MESH_FILE_MAGIC, sizeof(header.magic));
+    header.version = GLGE_MESH_FILE_VERSION;
+    header.sectionCount = (uint32_t)sections.size();
+    header.sectionTableOffset = sizeof(MeshFileHeader);
+    header.meshCount = meshCount;
+    header.importKey = options.importKey;
+    header.flags = options.encode ? GLGE_MESH_FILE_FLAG_ENCODED : 0;
+    uint64_t offset = header.sectionTableOffset + sections.size() * sizeof(MeshFileSection);
+    for (__MeshFileSectionData& section : sections) {
+        section.entry.offset = __alignSection(offset);
+        offset = section.entry.offset + section.entry.size;
+    }
+    header.fileSize = offset;
+
+    //write the file
+    std::ofstream f(path, std::ofstream::binary);
+    if (!f.is_open()) {return false;}
+    f.write((const char*)&header, sizeof(header));
+    for (const __MeshFileSectionData& section : sections) {f.write((const char*)&section.entry, sizeof(section.entry));}
+    uint64_t written = header.sectionTableOffset + sections.size() * sizeof(MeshFileSection);
+    const char padding[GLGE_MESH_FILE_ALIGNMENT]{0};
+    for (const __MeshFileSectionData& section : sections) {
+        //pad till the start of the section
+        f.write(padding, section.entry.offset - written);
+        if (section.data) {f.write((const char*)section.data, section.entry.size);}
+        else if (section.entry.size && !stream(f, section.entry)) {return false;}
+        written = section.entry.offset + section.entry.size;
+    }
+
+    //check if all writes succeeded
+    return (bool)f;
+}
+
+bool MeshFile::write(const std::filesystem::path& path, const std::vector<MeshFileEntry>& meshes, const std::vector<MeshFileSceneNode>& nodes, const MeshFileWriteOptions& options) noexcept
+{
+    //encode the meshes in parallel
+    std::vector<std::vector<uint8_t>> encodedVertices(options.encode ? meshes.size() : 0);
+    std::vector<std::vector<uint8_t>> encodedIndices(options.encode ? meshes.size() : 0);
+    if (options.encode) {
+        for (const MeshFileEntry& entry : meshes) {if (!entry.mesh) {return false;}}
+        ThreadPool::getGlobal().parallelFor(meshes.size(), 1, [&](uint64_t begin, uint64_t end) {
+            for (uint64_t m = begin; m < end; ++m) {
+                const Mesh* mesh = meshes[m].mesh;
+                __forEachStream(mesh->getVertexLayout(), mesh->getStorageMode(), mesh->getVertexCount(), [&](uint64_t offset, uint64_t stride) {
+                    MeshCodec::encodeVertices(encodedVertices[m], (const uint8_t*)mesh->getVertices() + offset, mesh->getVertexCount(), stride);
+                    return true;
+                });
+                MeshCodec::encodeIndices(encodedIndices[m], mesh->getIndices(), mesh->getIndexCount(), mesh->getIndexType());
+                __finishEncodedSection(encodedVertices[m], options);
+                __finishEncodedSection(encodedIndices[m], options);
+            }
+        });
+    }
+
+    //collect all sections and the data they contain
+    std::vector<__MeshFileSectionData> sections;
+    std::vector<MeshFileMeshInfo> infos(meshes.size());
+    std::vector<MeshFileBounds> bounds(meshes.size());
+    for (uint32_t m = 0; m < (uint32_t)meshes.size(); ++m) {
+        const Mesh* mesh = meshes[m].mesh;
+        if (!mesh) {return false;}
+        const VertexLayout& layout = mesh->getVertexLayout();
+
+        //describe the mesh layout and pre-compute the bounding volumes
+        MeshFileMeshInfo& info = infos[m];
+        __describeMesh(info, layout, mesh->getVertexCount(), mesh->getIndexCount(), mesh->getIndexType(), mesh->getStorageMode());
+        bounds[m] = __toBounds(mesh->getBoundingVolume<AABB>());
+
+        //store the sections of the mesh
+        sections.push_back({{MESH_FILE_SECTION_MESH_INFO, m, 0, sizeof(MeshFileMeshInfo), 0}, &info});
+        if (options.encode) {
+            sections.push_back({{MESH_FILE_SECTION_VERTICES_ENCODED, m, 0, encodedVertices[m].size(), 0}, encodedVertices[m].data()});
+            sections.push_back({{MESH_FILE_SECTION_INDICES_ENCODED, m, 0, encodedIndices[m].size(), 0}, encodedIndices[m].data()});
+        } else {
+            sections.push_back({{MESH_FILE_SECTION_VERTICES, m, 0, info.vertexCount * layout.m_size, 0}, mesh->getVertices()});
+            sections.push_back({{MESH_FILE_SECTION_INDICES, m, 0, info.indexCount * info.indexType, 0}, mesh->getIndices()});
+        }
+        sections.push_back({{MESH_FILE_SECTION_BOUNDS, m, 0, sizeof(MeshFileBounds), 0}, &bounds[m]});
+        __addOptionalSections(sections, m, meshes[m].lods, meshes[m].meshlets);
+    }
+
+    //convert the scene hierarchy
+    std::vector<MeshFileNode> fileNodes;
+    String names;
+    if (!__addNodeSections(nodes, meshes.size(), fileNodes, names, sections)) {return false;}
+
+    //all sections have their data, nothing is streamed
+    return __writeFile(path, sections, (uint32_t)meshes.size(), options, [](std::ofstream&, const MeshFileSection&) {return false;});
+}
+
+bool MeshFile::writeStreamed(const std::filesystem::path& path, const std::vector<MeshFileStreamEntry>& meshes, const std::vector<MeshFileSceneNode>& nodes, 
+                             const MeshFileWriteOptions& options) noexcept
+{
+    //streamed sections are always stored raw
+    MeshFileWriteOptions rawOptions = options;
+    rawOptions.encode = false;
+
+    //collect all sections. The vertices and indices have no data, they are requested while the file is written. 
+    std::vector<__MeshFileSectionData> sections;
+    std::vector<MeshFileMeshInfo> infos(meshes.size());
+    std::vector<MeshFileBounds> bounds(meshes.size());
+    for (uint32_t m = 0; m < (uint32_t)meshes.size(); ++m) {
+        const MeshFileStreamEntry& entry = meshes[m];
+        if ((entry.vertexCount && !entry.vertices) || (entry.indexCount && !entry.indices) || entry.layout.m_invalidConstruction) {return false;}
+
+        //the bounds are filled while the vertices are streamed, the bounds section is written after the vertex section
+        MeshFileMeshInfo& info = infos[m];
+        __describeMesh(info, entry.layout, entry.vertexCount, entry.indexCount, Mesh::getIndexTypeFor(entry.vertexCount), VERTEX_STORAGE_MODE_INTERLEAVED);
+        sections.push_back({{MESH_FILE_SECTION_MESH_INFO, m, 0, sizeof(MeshFileMeshInfo), 0}, &info});
+        sections.push_back({{MESH_FILE_SECTION_VERTICES, m, 0, info.vertexCount * entry.layout.m_size, 0}, nullptr});
+        sections.push_back({{MESH_FILE_SECTION_INDICES, m, 0, info.indexCount * info.indexType, 0}, nullptr});
+        sections.push_back({{MESH_FILE_SECTION_BOUNDS, m, 0, sizeof(MeshFileBounds), 0}, &bounds[m]});
+        __addOptionalSections(sections, m, entry.lods, entry.meshlets);
+    }
+
+    //convert the scene hierarchy
+    std::vector<MeshFileNode> fileNodes;
+    String names;
+    if (!__addNodeSections(nodes, meshes.size(), fileNodes, names, sections)) {return false;}
+
+    //a single block buffer is shared by all streamed sections, it never grows beyond the budget (or a single vertex)
+    std::vector<uint8_t> block;
+    auto stream = [&](std::ofstream& f, const MeshFileSection& section) -> bool {
+        const MeshFileStreamEntry& entry = meshes[section.meshIndex];
+        if (section.type == MESH_FILE_SECTION_VERTICES) {
+            uint64_t size = entry.layout.m_size;
+            uint64_t perBlock = std::max<uint64_t>(options.streamBudget / size, 1);
+            block.resize(std::max<uint64_t>(block.size(), std::min(perBlock, entry.vertexCount) * size));
+            //the bounds start at the origin like the bounds of a mesh
+            AABB box;
+            for (uint64_t first = 0; first < entry.vertexCount; first += perBlock) {
+                uint64_t count = std::min(perBlock, entry.vertexCount - first);
+                entry.vertices(first, count, block.data());
+                //a mesh view onto the block computes the bounds without copying
+                box.merge(Mesh(MeshBuffer::view(block.data(), count * size), count, entry.layout, MeshBuffer(), INDEX_TYPE_UINT16).getBoundingVolume<AABB>());
+                if (!f.write((const char*)block.data(), count * size)) {return false;}
+            }
+            bounds[section.meshIndex] = __toBounds(box);
+            return true;
+        }
+
+        //indices are requested with 32 bits and narrowed in place if the mesh uses 16 bit indices
+        IndexType type = Mesh::getIndexTypeFor(entry.vertexCount);
+        uint64_t perBlock = std::max<uint64_t>(options.streamBudget / sizeof(index_t), 3);
+        block.resize(std::max<uint64_t>(block.size(), std::min(perBlock, entry.indexCount) * sizeof(index_t)));
+        for (uint64_t first = 0; first < entry.indexCount; first += perBlock) {
+            uint64_t count = std::min(perBlock, entry.indexCount - first);
+            entry.indices(first, count, (index_t*)block.data());
+            if (type == INDEX_TYPE_UINT16) {
+                //the 16 bit index i is written before the 32 bit index i+1 is read, so nothing is overwritten early
+                for (uint64_t i = 0; i < count; ++i) {
+                    index_t index;
+                    memcpy(&index, block.data() + i*sizeof(index_t), sizeof(index));
+                    uint16_t narrow = (uint16_t)index;
+                    memcpy(block.data() + i*sizeof(uint16_t), &narrow, sizeof(narrow));
+                }
+            }
+            if (!f.write((const char*)block.data(), count * (uint64_t)type)) {return false;}
+        }
+        return true;
+    };
+
+    return __writeFile(path, sections, (uint32_t)meshes.size(), rawOptions, stream);
+}
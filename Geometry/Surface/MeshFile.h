@@ -0,0 +1,493 @@
+/**
+ * @file MeshFile.h
+ * @author DM8AT
+ * @brief define the version 2 layout of GLGE mesh files. The files are designed to be memory mapped and used without parsing.
+ * @version 0.1
+ * @date 2025-11-05
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ */
+
+//header guard
+#ifndef _GLGE_CORE_GEOMETRY_SURFACE_MESH_FILE_
+#define _GLGE_CORE_GEOMETRY_SURFACE_MESH_FILE_
+
+//include the type definitions
+#include "../../Types.h"
+//include meshes
+#include "Mesh.h"
+
+/*
+ * A version 2 mesh file has the following layout (all values are little endian):
+ * 
+ * | MeshFileHeader (64 bytes)                                     |
+ * | MeshFileSection[sectionCount] (32 bytes each)                 |
+ * | section data, every section starts at a multiple of 64 bytes |
+ * 
+ * Every mesh in the file has a MESH_INFO, a VERTICES and an INDICES section. BOUNDS, LODS and MESHLETS are optional.
+ * The vertex and index sections contain the raw bytes a mesh uses, so a mesh can point directly into the mapped file.
+ * 
+ * Files imported from a whole scene additionally store the node hierarchy in a NODES and a NODE_NAMES section.
+ * Those sections don't belong to a mesh, so their mesh index is GLGE_MESH_FILE_NO_MESH.
+ * 
+ * To make files smaller, the VERTICES and INDICES sections may be replaced by VERTICES_ENCODED and INDICES_ENCODED sections.
+ * They start with a MeshFileEncoding structure followed by the data encoded by the MeshCodec (optionally compressed with zlib).
+ * Encoded meshes are decoded to owned memory when they are created, so they can't reference the mapped file.
+ */
+
+//the magic value at the start of a version 2 mesh file
+#define GLGE_MESH_FILE_MAGIC "GLGEMSH2"
+//the current version of the mesh file layout
+#define GLGE_MESH_FILE_VERSION 2
+//the alignment of all sections in bytes
+#define GLGE_MESH_FILE_ALIGNMENT 64
+//the maximum amount of vertex elements that can be stored for a mesh
+#define GLGE_MESH_FILE_MAX_ELEMENTS 32
+//the mesh index of sections that don't belong to a mesh and of nodes without a mesh
+#define GLGE_MESH_FILE_NO_MESH UINT32_MAX
+//the parent index of root nodes
+#define GLGE_MESH_FILE_NO_PARENT UINT32_MAX
+//a header flag that is set if at least one section of the file is encoded
+#define GLGE_MESH_FILE_FLAG_ENCODED 1
+//an encoding flag that is set if the encoded data is compressed with zlib
+#define GLGE_MESH_FILE_ENCODING_FLAG_ZLIB 1
+
+/**
+ * @brief define the types of sections a mesh file can contain
+ */
+typedef enum e_MeshFileSectionType {
+    //a MeshFileMeshInfo structure that describes the layout of the mesh
+    MESH_FILE_SECTION_MESH_INFO = 1,
+    //the raw vertex data of the mesh
+    MESH_FILE_SECTION_VERTICES,
+    //the raw index data of the mesh
+    MESH_FILE_SECTION_INDICES,
+    //a MeshFileBounds structure
+    MESH_FILE_SECTION_BOUNDS,
+    //an array of MeshFileLod structures
+    MESH_FILE_SECTION_LODS,
+    //an array of MeshFileMeshlet structures
+    MESH_FILE_SECTION_MESHLETS,
+    //an array of MeshFileNode structures, parents are always stored before their children
+    MESH_FILE_SECTION_NODES,
+    //the names of all nodes as characters without NULL terminators
+    MESH_FILE_SECTION_NODE_NAMES,
+    //the vertex data of the mesh encoded by MeshCodec::encodeVertices (one stream per vertex element for separate storage)
+    MESH_FILE_SECTION_VERTICES_ENCODED,
+    //the index data of the mesh encoded by MeshCodec::encodeIndices
+    MESH_FILE_SECTION_INDICES_ENCODED
+} MeshFileSectionType;
+
+/**
+ * @brief the header at the start of a mesh file
+ */
+typedef struct s_MeshFileHeader {
+    //the magic value (GLGE_MESH_FILE_MAGIC without the NULL terminator)
+    char magic[8];
+    //the version of the layout
+    uint32_t version;
+    //the amount of entries in the section table
+    uint32_t sectionCount;
+    //the size of the whole file in bytes
+    uint64_t fileSize;
+    //the offset of the section table from the start of the file in bytes
+    uint64_t sectionTableOffset;
+    //the amount of meshes stored in the file
+    uint32_t meshCount;
+    //a combination of GLGE_MESH_FILE_FLAG_* values
+    uint32_t flags;
+    //the key of the import that created the file (0 if the file was not created by an import)
+    uint64_t importKey;
+    //reserved for future use, must be 0
+    uint8_t reserved[16];
+} MeshFileHeader;
+
+/**
+ * @brief an entry of the section table
+ */
+typedef struct s_MeshFileSection {
+    //the type of the section (a MeshFileSectionType)
+    uint32_t type;
+    //the index of the mesh the section belongs to
+    uint32_t meshIndex;
+    //the offset of the section data from the start of the file in bytes
+    uint64_t offset;
+    //the size of the section data in bytes
+    uint64_t size;
+    //reserved for future use, must be 0
+    uint64_t reserved;
+} MeshFileSection;
+
+/**
+ * @brief describe the layout of a mesh stored in a mesh file
+ */
+typedef struct s_MeshFileMeshInfo {
+    //the amount of vertices of the mesh
+    uint64_t vertexCount;
+    //the amount of indices of the mesh
+    uint64_t indexCount;
+    //the type of the indices (an IndexType)
+    uint32_t indexType;
+    //the way the vertices are arranged (a VertexStorageMode)
+    uint32_t storageMode;
+    //the amount of used vertex elements
+    uint32_t elementCount;
+    //reserved for future use, must be 0
+    uint32_t reserved;
+    //the vertex elements as pairs of VertexElementType and VertexElementDataType
+    uint32_t elements[GLGE_MESH_FILE_MAX_ELEMENTS][2];
+} MeshFileMeshInfo;
+
+/**
+ * @brief store the pre-computed bounding volumes of a mesh
+ */
+typedef struct s_MeshFileBounds {
+    //the minimum corner of the axis aligned bounding box
+    float min[3];
+    //the maximum corner of the axis aligned bounding box
+    float max[3];
+    //the center of the bounding sphere
+    float center[3];
+    //the radius of the bounding sphere
+    float radius;
+} MeshFileBounds;
+
+/**
+ * @brief store a level of detail as a range of the index buffer
+ */
+typedef struct s_MeshFileLod {
+    //the first index of the level of detail
+    uint64_t firstIndex;
+    //the amount of indices of the level of detail
+    uint64_t indexCount;
+    //the error of the level of detail in object space units
+    float error;
+    //reserved for future use, must be 0
+    uint32_t reserved;
+} MeshFileLod;
+
+/**
+ * @brief store a meshlet as a contiguous range of triangles in the index buffer
+ */
+typedef struct s_MeshFileMeshlet {
+    //the first index of the meshlet
+    uint32_t firstIndex;
+    //the amount of triangles of the meshlet
+    uint32_t triangleCount;
+    //the center of the bounding sphere of the meshlet
+    float center[3];
+    //the radius of the bounding sphere of the meshlet
+    float radius;
+    //the axis of the normal cone of the meshlet
+    float coneAxis[3];
+    //the cosine of the cutoff angle of the normal cone
+    float coneCutoff;
+} MeshFileMeshlet;
+
+/**
+ * @brief the start of an encoded section
+ */
+typedef struct s_MeshFileEncoding {
+    //a combination of GLGE_MESH_FILE_ENCODING_FLAG_* values
+    uint32_t flags;
+    //reserved for future use, must be 0
+    uint32_t reserved;
+    //the size of the encoded data in bytes (after decompression)
+    uint64_t encodedSize;
+    //the size of the data that follows this structure in bytes
+    uint64_t storedSize;
+    //reserved for future use, must be 0
+    uint64_t reserved2;
+} MeshFileEncoding;
+
+/**
+ * @brief store a single node of the scene hierarchy
+ */
+typedef struct s_MeshFileNode {
+    //the index of the parent node or GLGE_MESH_FILE_NO_PARENT for root nodes
+    uint32_t parent;
+    //the index of the mesh the node uses or GLGE_MESH_FILE_NO_MESH
+    uint32_t meshIndex;
+    //the offset of the name in the NODE_NAMES section in bytes
+    uint32_t nameOffset;
+    //the length of the name in bytes
+    uint32_t nameLength;
+    //the position of the node relative to the parent
+    float position[3];
+    //the rotation of the node relative to the parent as a quaternion (w, i, j, k)
+    float rotation[4];
+    //the scale of the node relative to the parent
+    float scale[3];
+    //reserved for future use, must be 0
+    uint32_t reserved[2];
+} MeshFileNode;
+
+//the mesh file class is only available for C++
+#if __cplusplus
+
+//mesh files are memory mapped
+#include "../../Filesystem/MappedFile.h"
+//meshes are created on demand
+#include <optional>
+//shared pointers keep the mapping alive
+#include <memory>
+//vectors store the meshes to write
+#include <vector>
+//spans are used to access the sections
+#include <span>
+//string views are used to access node names
+#include <string_view>
+//streamed meshes provide their data through callbacks
+#include <functional>
+//transforms are stored for the nodes
+#include "../Structure/Transform.h"
+//strings store the names of nodes
+#include "../../../GLGE_BG/CBinding/String.h"
+
+//make sure the layout of the file structures does not depend on the compiler
+static_assert(sizeof(MeshFileHeader) == 64, "The mesh file header must be 64 bytes large");
+static_assert(sizeof(MeshFileSection) == 32, "A mesh file section table entry must be 32 bytes large");
+static_assert(sizeof(MeshFileMeshInfo) == 288, "The mesh file mesh info must be 288 bytes large");
+static_assert(sizeof(MeshFileBounds) == 40, "The mesh file bounds must be 40 bytes large");
+static_assert(sizeof(MeshFileLod) == 24, "A mesh file level of detail must be 24 bytes large");
+static_assert(sizeof(MeshFileMeshlet) == 40, "A mesh file meshlet must be 40 bytes large");
+static_assert(sizeof(MeshFileNode) == 64, "A mesh file node must be 64 bytes large");
+static_assert(sizeof(MeshFileEncoding) == 32, "A mesh file encoding must be 32 bytes large");
+static_assert(VERTEX_ELEMENT_TYPE_COUNT <= GLGE_MESH_FILE_MAX_ELEMENTS, "A mesh file can't store all vertex element types");
+
+/**
+ * @brief store a mesh and its optional data that should be written to a mesh file
+ */
+struct MeshFileEntry {
+    //the mesh to write
+    const Mesh* mesh = nullptr;
+    //the levels of detail of the mesh (optional)
+    std::vector<MeshFileLod> lods;
+    //the meshlets of the mesh (optional)
+    std::vector<MeshFileMeshlet> meshlets;
+};
+
+/**
+ * @brief store a node of a scene hierarchy that should be written to a mesh file
+ */
+struct MeshFileSceneNode {
+    //the name of the node
+    String name;
+    //the index of the parent node or GLGE_MESH_FILE_NO_PARENT for root nodes. The parent must come before the node.
+    uint32_t parent = GLGE_MESH_FILE_NO_PARENT;
+    //the index of the mesh the node uses or GLGE_MESH_FILE_NO_MESH
+    uint32_t meshIndex = GLGE_MESH_FILE_NO_MESH;
+    //the transformation of the node relative to the parent
+    Transform transform;
+};
+
+/**
+ * @brief store how a mesh file should be written
+ */
+struct MeshFileWriteOptions {
+    //the key of the import that creates the file (0 if the file is not created by an import)
+    uint64_t importKey = 0;
+    //true to encode the vertices and indices with the MeshCodec. Encoded meshes can't reference the mapped file. 
+    bool encode = false;
+    //true to compress the encoded data with zlib. Only used if it makes the data smaller. 
+    bool compress = false;
+    //the zlib compression level (-1 for the default level)
+    int32_t compressionLevel = -1;
+    //the maximum amount of memory in bytes MeshFile::writeStreamed uses to buffer vertices and indices
+    uint64_t streamBudget = 64ull << 20;
+};
+
+/**
+ * @brief describe a mesh that is written to a mesh file block by block
+ * 
+ * The mesh never has to exist in memory as a whole. The writer asks for the vertices and indices in blocks that fit into
+ * the stream budget of the write options and writes every block to the file before asking for the next one. 
+ */
+struct MeshFileStreamEntry {
+    //the layout of a single vertex. Streamed vertices are always stored interleaved. 
+    VertexLayout layout;
+    //the amount of vertices of the mesh
+    uint64_t vertexCount = 0;
+    //the amount of indices of the mesh
+    uint64_t indexCount = 0;
+    //fill a block of vertices. Gets the first vertex, the amount of vertices and the memory to write the vertices to. 
+    std::function<void(uint64_t, uint64_t, void*)> vertices;
+    //fill a block of indices. Gets the first index, the amount of indices and the memory to write the indices to. 
+    std::function<void(uint64_t, uint64_t, index_t*)> indices;
+    //the levels of detail of the mesh (optional)
+    std::vector<MeshFileLod> lods;
+    //the meshlets of the mesh (optional)
+    std::vector<MeshFileMeshlet> meshlets;
+};
+
+/**
+ * @brief a memory mapped version 2 mesh file
+ * 
+ * Opening a file only maps and validates it. Meshes created from the file reference the mapped memory directly
+ * and keep the mapping alive, so the file instance may be destroyed before the meshes.
+ */
+class MeshFile
+{
+public:
+
+    /**
+     * @brief Construct a new Mesh File
+     * 
+     * No file is opened
+     */
+    MeshFile() = default;
+
+    /**
+     * @brief Construct a new Mesh File
+     * 
+     * @param path the path to the mesh file to open
+     */
+    MeshFile(const std::filesystem::path& path) noexcept
+    {open(path);}
+
+    /**
+     * @brief map and validate a mesh file (close the current one if one is open)
+     * 
+     * @param path the path to the mesh file to open
+     * @return true : the file was opened and is a valid version 2 mesh file
+     * @return false : the file could not be mapped or is not a valid version 2 mesh file
+     */
+    bool open(const std::filesystem::path& path) noexcept;
+
+    /**
+     * @brief close the mesh file
+     * 
+     * @warning meshes created from the file stay valid
+     */
+    void close() noexcept;
+
+    /**
+     * @brief check if a file is open
+     * 
+     * @return true : a valid mesh file is open
+     * @return false : no file is open
+     */
+    inline bool isOpen() const noexcept {return m_header != nullptr;}
+
+    /**
+     * @brief Get the header of the mesh file
+     * 
+     * @return const MeshFileHeader* a pointer to the header or NULL if no file is open
+     */
+    inline const MeshFileHeader* getHeader() const noexcept {return m_header;}
+
+    /**
+     * @brief Get the amount of meshes in the file
+     * 
+     * @return uint32_t the amount of stored meshes
+     */
+    inline uint32_t getMeshCount() const noexcept {return m_header ? m_header->meshCount : 0;}
+
+    /**
+     * @brief search for a specific section
+     * 
+     * @param type the type of the section to search
+     * @param meshIndex the index of the mesh the section belongs to
+     * @return const MeshFileSection* a pointer to the section table entry or NULL if the section does not exist
+     */
+    const MeshFileSection* findSection(MeshFileSectionType type, uint32_t meshIndex) const noexcept;
+
+    /**
+     * @brief Get a typed view onto the data of a section
+     * 
+     * @tparam T the type of the elements of the section
+     * @param type the type of the section
+     * @param meshIndex the index of the mesh the section belongs to
+     * @return std::span<const T> a span over the section data or an empty span if the section does not exist
+     */
+    template <typename T> inline std::span<const T> getSection(MeshFileSectionType type, uint32_t meshIndex) const noexcept {
+        const MeshFileSection* section = findSection(type, meshIndex);
+        if (!section) {return {};}
+        return std::span<const T>((const T*)(m_file->data() + section->offset), section->size / sizeof(T));
+    }
+
+    /**
+     * @brief create a mesh that references the data in the mapped file
+     * 
+     * No vertex or index data is copied. The data is copied when the mesh modifies it. 
+     * Encoded data is decoded to memory owned by the mesh.
+     * 
+     * @param meshIndex the index of the mesh to create
+     * @return std::optional<Mesh> the mesh or nothing if the mesh does not exist or its sections are invalid
+     */
+    std::optional<Mesh> createMesh(uint32_t meshIndex) const noexcept;
+
+    /**
+     * @brief Get the nodes of the scene hierarchy stored in the file
+     * 
+     * @return std::span<const MeshFileNode> a span over all nodes or an empty span if the file has no hierarchy
+     */
+    inline std::span<const MeshFileNode> getNodes() const noexcept
+    {return getSection<MeshFileNode>(MESH_FILE_SECTION_NODES, GLGE_MESH_FILE_NO_MESH);}
+
+    /**
+     * @brief Get the name of a node
+     * 
+     * @param node the node to get the name of
+     * @return std::string_view a view onto the name in the mapped file or an empty view if the name is out of bounds
+     */
+    std::string_view getNodeName(const MeshFileNode& node) const noexcept;
+
+    /**
+     * @brief check if a block of memory starts with the magic value of a version 2 mesh file
+     * 
+     * @param data a pointer to the first byte of the memory
+     * @param size the size of the memory in bytes
+     * @return true : the memory starts with a version 2 mesh file header
+     * @return false : the memory is no version 2 mesh file
+     */
+    static bool isMeshFile(const void* data, uint64_t size) noexcept;
+
+    /**
+     * @brief write a list of meshes to a version 2 mesh file
+     * 
+     * The bounding volumes of all meshes are computed and stored in the file
+     * 
+     * @param path the path of the file to write
+     * @param meshes the meshes to write
+     * @param nodes the nodes of the scene hierarchy to write (optional)
+     * @param options how the file should be written (optional)
+     * @return true : the file was written successfully
+     * @return false : failed to write the file or a node is invalid
+     */
+    static bool write(const std::filesystem::path& path, const std::vector<MeshFileEntry>& meshes, const std::vector<MeshFileSceneNode>& nodes = {}, 
+                      const MeshFileWriteOptions& options = {}) noexcept;
+
+    /**
+     * @brief write a list of meshes to a version 2 mesh file without keeping any of them in memory as a whole
+     * 
+     * The vertices and indices are requested block by block and written directly to the file, so the memory used for the mesh
+     * data is bounded by the stream budget of the options (at least a single vertex is buffered). The bounds are computed while
+     * the vertices are streamed. The indices are stored with the smallest index type that can address all vertices. 
+     * The sections are always stored raw, the encoding options are ignored because encoding requires the whole mesh. 
+     * 
+     * @param path the path of the file to write
+     * @param meshes the meshes to write
+     * @param nodes the nodes of the scene hierarchy to write (optional)
+     * @param options how the file should be written (optional)
+     * @return true : the file was written successfully
+     * @return false : failed to write the file, a mesh has no data callback or a node is invalid
+     */
+    static bool writeStreamed(const std::filesystem::path& path, const std::vector<MeshFileStreamEntry>& meshes, const std::vector<MeshFileSceneNode>& nodes = {}, 
+                              const MeshFileWriteOptions& options = {}) noexcept;
+
+protected:
+
+    //store the mapped file. It is shared with all meshes that reference it.
+    std::shared_ptr<MappedFile> m_file;
+    //store a pointer to the header in the mapped file
+    const MeshFileHeader* m_header = nullptr;
+    //store a pointer to the section table in the mapped file
+    const MeshFileSection* m_sections = nullptr;
+
+};
+
+#endif
+
+#endif
@@ -0,0 +1,522 @@
+/**
+ * @file Skinning.cpp
+ * @author DM8AT
+ * @brief implement the CPU skinning kernel and the C binding for skinning
+ * @version 0.1
+ * @date 2025-11-08
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ */
+
+//include the skinning api
+#include "Skinning.h"
+
+//include the thread pool for parallel processing
+#include "../../Threading/ThreadPool.h"
+
+//include intrinsics for the vectorized blending
+#if defined(__AVX512F__) || defined(__AVX2__)
+    #include <immintrin.h>
+#endif
+
+//for the square root
+#include <cmath>
+//for memcpy
+#include <cstring>
+
+//the kernel reads the bone matrices as a flat float array
+static_assert(sizeof(BoneMatrix) == sizeof(float)*12, "A bone matrix must consist of exactly 12 floats");
+
+s_BoneMatrix::s_BoneMatrix(const Transform& transform) noexcept
+{
+    const Quaternion& q = transform.rot;
+    const vec3& s = transform.scale;
+    //same as Transform::getTransformMatrix
+    float r[3][3] = {
+        {1.f - 2.f*(q.j*q.j + q.k*q.k), 2.f*(q.i*q.j - q.k*q.w), 2.f*(q.i*q.k + q.j*q.w)},
+        {2.f*(q.i*q.j + q.k*q.w), 1.f - 2.f*(q.i*q.i + q.k*q.k), 2.f*(q.j*q.k - q.i*q.w)},
+        {2.f*(q.i*q.k - q.j*q.w), 2.f*(q.j*q.k + q.i*q.w), 1.f - 2.f*(q.i*q.i + q.j*q.j)}
+    };
+    float scale[3] = {s.x, s.y, s.z};
+    float pos[3] = {transform.pos.x, transform.pos.y, transform.pos.z};
+    for (uint64_t i = 0; i < 3; ++i) {
+        for (uint64_t j = 0; j < 3; ++j) {rows[i][j] = scale[i] * r[i][j];}
+        rows[i][3] = pos[i];
+    }
+}
+
+BoneMatrix BoneMatrix::operator*(const BoneMatrix& other) const noexcept
+{
+    BoneMatrix ret;
+    for (uint64_t i = 0; i < 3; ++i) {
+        for (uint64_t j = 0; j < 4; ++j) {
+            //the implicit last row of both matrices is (0, 0, 0, 1)
+            ret.rows[i][j] = rows[i][0]*other.rows[0][j] + rows[i][1]*other.rows[1][j] + rows[i][2]*other.rows[2][j] + ((j == 3) ? rows[i][3] : 0.f);
+        }
+    }
+    return ret;
+}
+
+/**
+ * @brief store how a single element of all vertices of a mesh can be accessed
+ */
+struct __SkinElement {
+    //a pointer to the element of the first vertex or NULL if the element doesn't exist
+    uint8_t* base = nullptr;
+    //the distance between the element of two vertices in bytes
+    uint64_t stride = 0;
+    //the data type of the element
+    VertexElementDataType data = VERTEX_ELEMENT_DATA_TYPE_UNDEFINED;
+};
+
+/**
+ * @brief store all elements of a mesh the skinning reads from
+ */
+struct __SkinSource {
+    //the positions of the vertices
+    __SkinElement pos;
+    //the normals of the vertices
+    __SkinElement nor;
+    //the tangents of the vertices
+    __SkinElement tan;
+    //the two sets of bone indices
+    __SkinElement indices[2];
+    //the two sets of bone weights
+    __SkinElement weights[2];
+    //the amount of bones per vertex (4 or 8)
+    uint32_t influences = 0;
+};
+
+/**
+ * @brief get the access information of an element of a mesh
+ * 
+ * @param mesh the mesh to get the element from
+ * @param type the type of the element
+ * @return __SkinElement the access information. The base is NULL if the mesh has no such element.
+ */
+static __SkinElement __getElement(const Mesh& mesh, VertexElementType type) noexcept {
+    const VertexLayout& layout = mesh.getVertexLayout();
+    uint64_t idx = layout.getIndexOfElement(type);
+    if ((idx == UINT64_MAX) || !mesh.getVertices()) {return {};}
+    __SkinElement el;
+    el.data = layout.m_elements[idx].data;
+    //the start and the stride depend on the storage mode
+    if (mesh.getStorageMode() == VERTEX_STORAGE_MODE_SEPARATE) {
+        el.base = ((uint8_t*)mesh.getVertices()) + layout.getStreamOffsetOf(idx, mesh.getVertexCount());
+        el.stride = layout.getElementSize(idx);
+    } else {
+        el.base = ((uint8_t*)mesh.getVertices()) + layout.getOffsetOf(idx);
+        el.stride = layout.m_size;
+    }
+    return el;
+}
+
+/**
+ * @brief check if an element is a 3D or 4D float vector or doesn't exist
+ * 
+ * @param el the element to check
+ * @return true : the element can be read and written as floats
+ * @return false : the element has a different type
+ */
+static inline bool __isFloatVector(const __SkinElement& el) noexcept {
+    return !el.base || (el.data == VERTEX_ELEMENT_DATA_TYPE_FLOAT_VEC3) || (el.data == VERTEX_ELEMENT_DATA_TYPE_FLOAT_VEC4);
+}
+
+/**
+ * @brief check if an element stores bone indices in a supported type
+ * 
+ * @param el the element to check
+ * @return true : the indices can be read
+ * @return false : the type is not supported
+ */
+static inline bool __isIndexVector(const __SkinElement& el) noexcept {
+    return (el.data == VERTEX_ELEMENT_DATA_TYPE_UINT8_VEC4) || (el.data == VERTEX_ELEMENT_DATA_TYPE_UINT16_VEC4) ||
+           (el.data == VERTEX_ELEMENT_DATA_TYPE_UINT32_VEC4);
+}
+
+/**
+ * @brief check if an element stores bone weights in a supported type
+ * 
+ * @param el the element to check
+ * @return true : the weights can be read
+ * @return false : the type is not supported
+ */
+static inline bool __isWeightVector(const __SkinElement& el) noexcept {
+    return (el.data == VERTEX_ELEMENT_DATA_TYPE_FLOAT_VEC4) || (el.data == VERTEX_ELEMENT_DATA_TYPE_UINT8_VEC4) ||
+           (el.data == VERTEX_ELEMENT_DATA_TYPE_UINT16_VEC4);
+}
+
+/**
+ * @brief collect and validate all elements a mesh needs for skinning
+ * 
+ * @param mesh the mesh to skin
+ * @param src filled with the elements of the mesh
+ * @return true : the mesh can be skinned
+ * @return false : an element is missing or has an unsupported type
+ */
+static bool __getSource(const Mesh& mesh, __SkinSource& src) noexcept {
+    src.influences = Skinning::getInfluenceCount(mesh.getVertexLayout());
+    if (src.influences == 0) {return false;}
+    src.pos = __getElement(mesh, VERTEX_ELEMENT_TYPE_POSITION);
+    src.nor = __getElement(mesh, VERTEX_ELEMENT_TYPE_NORMAL);
+    src.tan = __getElement(mesh, VERTEX_ELEMENT_TYPE_TANGENT);
+    src.indices[0] = __getElement(mesh, VERTEX_ELEMENT_TYPE_BONE_INDICES0);
+    src.weights[0] = __getElement(mesh, VERTEX_ELEMENT_TYPE_BONE_WEIGHTS0);
+    src.indices[1] = __getElement(mesh, VERTEX_ELEMENT_TYPE_BONE_INDICES1);
+    src.weights[1] = __getElement(mesh, VERTEX_ELEMENT_TYPE_BONE_WEIGHTS1);
+    //empty meshes are allowed, their elements simply have no data
+    if (mesh.getVertexCount() == 0) {return true;}
+    if (!src.pos.base || !__isFloatVector(src.pos) || !__isFloatVector(src.nor) || !__isFloatVector(src.tan)) {return false;}
+    for (uint32_t i = 0; i < src.influences / 4; ++i)
+    {if (!__isIndexVector(src.indices[i]) || !__isWeightVector(src.weights[i])) {return false;}}
+    return true;
+}
+
+/**
+ * @brief read 4 bone indices of a vertex
+ * 
+ * @param el the element to read from
+ * @param v the index of the vertex
+ * @param out the array to write the indices to
+ */
+static inline void __readIndices(const __SkinElement& el, uint64_t v, uint32_t* out) noexcept {
+    const uint8_t* ptr = el.base + v*el.stride;
+    switch (el.data)
+    {
+    case VERTEX_ELEMENT_DATA_TYPE_UINT8_VEC4:
+        for (uint32_t i = 0; i < 4; ++i) {out[i] = ptr[i];}
+        break;
+    case VERTEX_ELEMENT_DATA_TYPE_UINT16_VEC4:
+        for (uint32_t i = 0; i < 4; ++i) {uint16_t val; memcpy(&val, ptr + i*sizeof(uint16_t), sizeof(val)); out[i] = val;}
+        break;
+    default:
+        memcpy(out, ptr, sizeof(uint32_t)*4);
+        break;
+    }
+}
+
+/**
+ * @brief read 4 bone weights of a vertex
+ * 
+ * @param el the element to read from
+ * @param v the index of the vertex
+ * @param out the array to write the weights to
+ */
+static inline void __readWeights(const __SkinElement& el, uint64_t v, float* out) noexcept {
+    const uint8_t* ptr = el.base + v*el.stride;
+    switch (el.data)
+    {
+    case VERTEX_ELEMENT_DATA_TYPE_UINT8_VEC4:
+        for (uint32_t i = 0; i < 4; ++i) {out[i] = ptr[i] * (1.f / 255.f);}
+        break;
+    case VERTEX_ELEMENT_DATA_TYPE_UINT16_VEC4:
+        for (uint32_t i = 0; i < 4; ++i) {uint16_t val; memcpy(&val, ptr + i*sizeof(uint16_t), sizeof(val)); out[i] = val * (1.f / 65535.f);}
+        break;
+    default:
+        memcpy(out, ptr, sizeof(float)*4);
+        break;
+    }
+}
+
+/*
+ * The blended matrix of a vertex is built from up to 8 bone matrices. Every bone matrix is loaded as a whole
+ * (12 floats) and accumulated with a single fused multiply add per register, so the cost per influence is
+ * one or two loads and FMAs. The blended matrix is applied to the position, normal and tangent by multiplying
+ * it with the broadcast vector and summing up the 4 lanes of every row. The 3 results are moved to the lower
+ * lanes of a single 128 bit register, normalized there if required and stored as 4 floats at once (a masked or
+ * partial store would stall the following loads of the same floats).
+ */
+
+#if defined(__AVX512F__) || (defined(__AVX2__) && defined(__FMA__))
+
+/**
+ * @brief normalize a 3D vector stored in the lower 3 lanes of a register
+ * 
+ * @param v the vector to normalize. Vectors without length are not changed.
+ * @return __m128 the normalized vector
+ */
+static inline __m128 __normalize(__m128 v) noexcept {
+    __m128 len = _mm_sqrt_ps(_mm_dp_ps(v, v, 0x7F));
+    return _mm_blendv_ps(v, _mm_div_ps(v, len), _mm_cmpgt_ps(len, _mm_setzero_ps()));
+}
+
+#endif
+
+#if defined(__AVX512F__)
+
+//the blended matrix fits into a single register, the last 4 lanes are 0
+typedef __m512 __BlendedMatrix;
+
+/**
+ * @brief start a new blended matrix
+ * 
+ * @return __BlendedMatrix a matrix with all components set to 0
+ */
+static inline __BlendedMatrix __blendStart() noexcept {return _mm512_setzero_ps();}
+
+/**
+ * @brief add a weighted bone matrix to a blended matrix
+ * 
+ * @param m the blended matrix
+ * @param bone a pointer to the 12 floats of the bone matrix
+ * @param weight the weight of the bone
+ * @return __BlendedMatrix the new blended matrix
+ */
+static inline __BlendedMatrix __blendAdd(__BlendedMatrix m, const float* bone, float weight) noexcept
+{return _mm512_fmadd_ps(_mm512_set1_ps(weight), _mm512_maskz_loadu_ps(0x0FFF, bone), m);}
+
+/**
+ * @brief apply a blended matrix to a vector
+ * 
+ * @tparam Normalize true to normalize the result
+ * @param m the blended matrix
+ * @param v the vector to transform
+ * @param w 1 for positions and 0 for directions
+ * @param out the array to write the transformed vector to. Must have room for 4 floats, the 4th is undefined.
+ */
+template <bool Normalize>
+static inline void __blendApply(__BlendedMatrix m, const float* v, float w, float* out) noexcept {
+    __m512 prod = _mm512_mul_ps(m, _mm512_broadcast_f32x4(_mm_setr_ps(v[0], v[1], v[2], w)));
+    //sum up the 4 lanes of every row, the sum ends up in every lane of the row
+    prod = _mm512_add_ps(prod, _mm512_permute_ps(prod, _MM_SHUFFLE(2,3,0,1)));
+    prod = _mm512_add_ps(prod, _mm512_permute_ps(prod, _MM_SHUFFLE(1,0,3,2)));
+    //move the first lane of the 3 rows (and the empty 4th row) to the lowest 4 lanes
+    __m128 res = _mm512_castps512_ps128(_mm512_permutexvar_ps(_mm512_setr_epi32(0,4,8,12, 0,0,0,0, 0,0,0,0, 0,0,0,0), prod));
+    if constexpr (Normalize) {res = __normalize(res);}
+    _mm_storeu_ps(out, res);
+}
+
+#elif defined(__AVX2__) && defined(__FMA__)
+
+//the first two rows are stored in a 256 bit register and the last row in a 128 bit register
+struct __BlendedMatrix {
+    //the first two rows
+    __m256 r01;
+    //the last row
+    __m128 r2;
+};
+
+/**
+ * @brief start a new blended matrix
+ * 
+ * @return __BlendedMatrix a matrix with all components set to 0
+ */
+static inline __BlendedMatrix __blendStart() noexcept {return {_mm256_setzero_ps(), _mm_setzero_ps()};}
+
+/**
+ * @brief add a weighted bone matrix to a blended matrix
+ * 
+ * @param m the blended matrix
+ * @param bone a pointer to the 12 floats of the bone matrix
+ * @param weight the weight of the bone
+ * @return __BlendedMatrix the new blended matrix
+ */
+static inline __BlendedMatrix __blendAdd(__BlendedMatrix m, const float* bone, float weight) noexcept {
+    return {_mm256_fmadd_ps(_mm256_set1_ps(weight), _mm256_loadu_ps(bone), m.r01),
+            _mm_fmadd_ps(_mm_set1_ps(weight), _mm_loadu_ps(bone + 8), m.r2)};
+}
+
+/**
+ * @brief apply a blended matrix to a vector
+ * 
+ * @tparam Normalize true to normalize the result
+ * @param m the blended matrix
+ * @param v the vector to transform
+ * @param w 1 for positions and 0 for directions
+ * @param out the array to write the transformed vector to. Must have room for 4 floats, the 4th is undefined.
+ */
+template <bool Normalize>
+static inline void __blendApply(const __BlendedMatrix& m, const float* v, float w, float* out) noexcept {
+    __m128 vec = _mm_setr_ps(v[0], v[1], v[2], w);
+    __m256 p01 = _mm256_mul_ps(m.r01, _mm256_set_m128(vec, vec));
+    __m128 p2 = _mm_mul_ps(m.r2, vec);
+    //two horizontal adds sum up the 4 lanes of every row, the sum ends up in every lane of the row
+    p01 = _mm256_hadd_ps(p01, p01);
+    p01 = _mm256_hadd_ps(p01, p01);
+    p2 = _mm_hadd_ps(p2, p2);
+    p2 = _mm_hadd_ps(p2, p2);
+    //pick one lane of every row
+    __m128 res = _mm_blend_ps(_mm256_castps256_ps128(p01), _mm256_extractf128_ps(p01, 1), 0b0010);
+    res = _mm_blend_ps(res, p2, 0b0100);
+    if constexpr (Normalize) {res = __normalize(res);}
+    _mm_storeu_ps(out, res);
+}
+
+#else
+
+//without vector extensions the matrix is blended component by component
+struct __BlendedMatrix {
+    //the 12 components of the matrix
+    float m[12];
+};
+
+/**
+ * @brief start a new blended matrix
+ * 
+ * @return __BlendedMatrix a matrix with all components set to 0
+ */
+static inline __BlendedMatrix __blendStart() noexcept {return {};}
+
+/**
+ * @brief add a weighted bone matrix to a blended matrix
+ * 
+ * @param m the blended matrix
+ * @param bone a pointer to the 12 floats of the bone matrix
+ * @param weight the weight of the bone
+ * @return __BlendedMatrix the new blended matrix
+ */
+static inline __BlendedMatrix __blendAdd(__BlendedMatrix m, const float* bone, float weight) noexcept {
+    for (uint32_t i = 0; i < 12; ++i) {m.m[i] += weight * bone[i];}
+    return m;
+}
+
+/**
+ * @brief apply a blended matrix to a vector
+ * 
+ * @tparam Normalize true to normalize the result
+ * @param m the blended matrix
+ * @param v the vector to transform
+ * @param w 1 for positions and 0 for directions
+ * @param out the array to write the transformed vector to. Must have room for 4 floats, the 4th is undefined.
+ */
+template <bool Normalize>
+static inline void __blendApply(const __BlendedMatrix& m, const float* v, float w, float* out) noexcept {
+    for (uint32_t i = 0; i < 3; ++i)
+    {out[i] = m.m[i*4]*v[0] + m.m[i*4+1]*v[1] + m.m[i*4+2]*v[2] + m.m[i*4+3]*w;}
+    if constexpr (Normalize) {
+        //vectors without length are not changed
+        float len = std::sqrt(out[0]*out[0] + out[1]*out[1] + out[2]*out[2]);
+        if (len > 0.f) {
+            float inv = 1.f / len;
+            out[0] *= inv; out[1] *= inv; out[2] *= inv;
+        }
+    }
+}
+
+#endif
+
+/**
+ * @brief skin all vertices of a mesh in parallel
+ * 
+ * @tparam Store the type of the function that stores the skinned vertex
+ * @param source the elements of the source mesh
+ * @param bones the matrices of all bones
+ * @param vertexCount the amount of vertices to skin
+ * @param normals true to skin the normals
+ * @param tangents true to skin the tangents
+ * @param storeFunc a function that gets the index of the vertex and pointers to the skinned position, normal and tangent
+ */
+template <typename Store>
+static void __skin(const __SkinSource& source, std::span<const BoneMatrix> bones, uint64_t vertexCount, bool normals, bool tangents, const Store& storeFunc) noexcept {
+    const float* boneData = (const float*)bones.data();
+    uint64_t boneCount = bones.size();
+    //every vertex is independent, so the range is simply split between the threads
+    constexpr uint64_t GRAIN = 4096;
+    ThreadPool::getGlobal().parallelFor(vertexCount, GRAIN, [&](uint64_t begin, uint64_t end) {
+        //local copies can't be aliased by the byte pointers the vertices are written through, so they stay in registers
+        const __SkinSource src = source;
+        const Store store = storeFunc;
+        uint32_t indices[8];
+        float weights[8];
+        float p[3], n[3] = {0,0,0}, t[3] = {0,0,0};
+        for (uint64_t v = begin; v < end; ++v) {
+            //read the input vertex
+            memcpy(p, src.pos.base + v*src.pos.stride, sizeof(p));
+            if (normals) {memcpy(n, src.nor.base + v*src.nor.stride, sizeof(n));}
+            if (tangents) {memcpy(t, src.tan.base + v*src.tan.stride, sizeof(t));}
+            for (uint32_t s = 0; s < src.influences / 4; ++s) {
+                __readIndices(src.indices[s], v, indices + s*4);
+                __readWeights(src.weights[s], v, weights + s*4);
+            }
+
+            //only bones that exist contribute, their weights are normalized
+            float sum = 0.f;
+            for (uint32_t i = 0; i < src.influences; ++i) {
+                if ((indices[i] >= boneCount) || !(weights[i] > 0.f)) {weights[i] = 0.f;}
+                sum += weights[i];
+            }
+            //vertices without any influence are not moved
+            if (sum <= 0.f) {
+                store(v, p, n, t);
+                continue;
+            }
+            float inv = 1.f / sum;
+            __BlendedMatrix m = __blendStart();
+            for (uint32_t i = 0; i < src.influences; ++i)
+            {if (weights[i] != 0.f) {m = __blendAdd(m, boneData + indices[i]*12, weights[i] * inv);}}
+
+            //apply the blended matrix
+            float op[4], on[4] = {0,0,0,0}, ot[4] = {0,0,0,0};
+            __blendApply<false>(m, p, 1.f, op);
+            if (normals) {__blendApply<true>(m, n, 0.f, on);}
+            if (tangents) {__blendApply<true>(m, t, 0.f, ot);}
+            store(v, op, on, ot);
+        }
+    });
+}
+
+uint32_t Skinning::getInfluenceCount(const VertexLayout& layout) noexcept
+{
+    if ((layout.getIndexOfElement(VERTEX_ELEMENT_TYPE_BONE_INDICES0) == UINT64_MAX) ||
+        (layout.getIndexOfElement(VERTEX_ELEMENT_TYPE_BONE_WEIGHTS0) == UINT64_MAX)) {return 0;}
+    if ((layout.getIndexOfElement(VERTEX_ELEMENT_TYPE_BONE_INDICES1) == UINT64_MAX) ||
+        (layout.getIndexOfElement(VERTEX_ELEMENT_TYPE_BONE_WEIGHTS1) == UINT64_MAX)) {return 4;}
+    return 8;
+}
+
+bool Skinning::skin(const Mesh& src, std::span<const BoneMatrix> bones, Mesh& dst) noexcept
+{
+    //skinning in place would loose the bind pose
+    if (&src == &dst) {return false;}
+    __SkinSource source;
+    if (!__getSource(src, source)) {return false;}
+
+    //the output must have the same vertices, it is only re-created if it doesn't match
+    if ((dst.getVertexCount() != src.getVertexCount()) || !(dst.getVertexLayout() == src.getVertexLayout())) {dst = src;}
+    dst.makeUnique();
+    if (src.getVertexCount() == 0) {return true;}
+
+    //the output uses the same layout, but may use a different storage mode
+    __SkinElement pos = __getElement(dst, VERTEX_ELEMENT_TYPE_POSITION);
+    __SkinElement nor = __getElement(dst, VERTEX_ELEMENT_TYPE_NORMAL);
+    __SkinElement tan = __getElement(dst, VERTEX_ELEMENT_TYPE_TANGENT);
+    //the 4th components (like the handedness of the tangent) are allready copied, so only 3 floats are written
+    __skin(source, bones, src.getVertexCount(), nor.base != nullptr, tan.base != nullptr,
+    [&](uint64_t v, const float* p, const float* n, const float* t) {
+        memcpy(pos.base + v*pos.stride, p, sizeof(float)*3);
+        if (nor.base) {memcpy(nor.base + v*nor.stride, n, sizeof(float)*3);}
+        if (tan.base) {memcpy(tan.base + v*tan.stride, t, sizeof(float)*3);}
+    });
+    return true;
+}
+
+bool Skinning::skin(const Mesh& src, std::span<const BoneMatrix> bones, const SkinningStreams& dst) noexcept
+{
+    __SkinSource source;
+    if (!__getSource(src, source)) {return false;}
+    //an attribute is written if any of its streams is set
+    bool positions = dst.positions[0] || dst.positions[1] || dst.positions[2];
+    bool normals = dst.normals[0] || dst.normals[1] || dst.normals[2];
+    bool tangents = dst.tangents[0] || dst.tangents[1] || dst.tangents[2];
+    if (src.getVertexCount() == 0) {return true;}
+    if ((normals && !source.nor.base) || (tangents && !source.tan.base)) {return false;}
+
+    __skin(source, bones, src.getVertexCount(), normals, tangents,
+    [&](uint64_t v, const float* p, const float* n, const float* t) {
+        for (uint32_t i = 0; i < 3; ++i) {
+            if (positions && dst.positions[i]) {dst.positions[i][v] = p[i];}
+            if (normals && dst.normals[i]) {dst.normals[i][v] = n[i];}
+            if (tangents && dst.tangents[i]) {dst.tangents[i][v] = t[i];}
+        }
+    });
+    return true;
+}
+
+
+
+bool skinning_SkinMesh(const Mesh* src, const BoneMatrix* bones, uint64_t boneCount, Mesh* dst)
+{return Skinning::skin(*src, std::span<const BoneMatrix>(bones, boneCount), *dst);}
+
+bool skinning_SkinStreams(const Mesh* src, const BoneMatrix* bones, uint64_t boneCount, const SkinningStreams* dst)
+{return Skinning::skin(*src, std::span<const BoneMatrix>(bones, boneCount), *dst);}
@@ -0,0 +1,169 @@
+/**
+ * @file Skinning.h
+ * @author DM8AT
+ * @brief define a CPU skinning kernel that deforms meshes by a set of bone matrices
+ * @version 0.1
+ * @date 2025-11-08
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ */
+
+//header guard
+#ifndef _GLGE_CORE_GEOMETRY_SURFACE_SKINNING_
+#define _GLGE_CORE_GEOMETRY_SURFACE_SKINNING_
+
+//include the type definitions
+#include "../../Types.h"
+//include meshes
+#include "Mesh.h"
+
+/**
+ * @brief store the affine transformation of a single bone
+ * 
+ * The matrix is stored as the upper 3 rows of a row major 4x4 matrix, the translation is stored in the last column.
+ * The matrix of a bone is usually the world matrix of the bone multiplied with the inverse bind matrix of the bone.
+ */
+typedef struct s_BoneMatrix {
+    //store the 3 rows of the matrix
+    float rows[3][4];
+
+    //for C++ add constructors and composition
+    #if __cplusplus
+
+    /**
+     * @brief Construct a new Bone Matrix
+     * 
+     * The matrix is the identity
+     */
+    inline constexpr s_BoneMatrix() noexcept
+     : rows{{1,0,0,0}, {0,1,0,0}, {0,0,1,0}}
+    {}
+
+    /**
+     * @brief Construct a new Bone Matrix from a transform
+     * 
+     * @param transform the transform to convert to a matrix (same as Transform::getTransformMatrix)
+     */
+    s_BoneMatrix(const Transform& transform) noexcept;
+
+    /**
+     * @brief chain two bone matrices
+     * 
+     * @param other the matrix that is applied first
+     * @return s_BoneMatrix a matrix that first applies other and then this matrix
+     */
+    s_BoneMatrix operator*(const s_BoneMatrix& other) const noexcept;
+
+    #endif
+
+} BoneMatrix;
+
+/**
+ * @brief store pointers to separate streams of skinned vertex data (structure of arrays)
+ * 
+ * Every component is stored in its own, tightly packed float array with one entry per vertex.
+ * Set all pointers of an attribute to NULL to skip it.
+ */
+typedef struct s_SkinningStreams {
+    //the x, y and z components of the skinned positions
+    float* positions[3];
+    //the x, y and z components of the skinned normals
+    float* normals[3];
+    //the x, y and z components of the skinned tangents
+    float* tangents[3];
+} SkinningStreams;
+
+//the skinning class is only available for C++
+#if __cplusplus
+
+//include typed views for the bones
+#include <span>
+
+/**
+ * @brief a static class that deforms meshes by bone matrices on the CPU
+ * 
+ * The source mesh must have a BONE_INDICES0 and a BONE_WEIGHTS0 element and may have a BONE_INDICES1 and BONE_WEIGHTS1
+ * element, so every vertex is influenced by up to 4 or 8 bones. The matrices of all bones of a vertex are blended by their
+ * weights (linear blend skinning) and the result is applied to the position, the normal and the tangent of the vertex.
+ * Normals and tangents are re-normalized, so uniform scale is supported. Non-uniform scale in the bone matrices slightly
+ * skews the normals.
+ * The weights are normalized by their sum, vertices with only zero weights and bone indices outside of the bone list are
+ * not influenced by the respective bones. A vertex without any valid influence keeps its original position.
+ * 
+ * Bone indices may be stored as unsigned 8, 16 or 32 bit integer 4D vectors. Weights may be stored as float 4D vectors or
+ * as normalized unsigned 8 or 16 bit integer 4D vectors. Positions, normals and tangents must be 3D or 4D float vectors.
+ * The blending uses AVX-512 or AVX2 if the code is compiled for it and runs in parallel on the global thread pool.
+ */
+class Skinning final
+{
+public:
+
+    /**
+     * @brief get the amount of bones that can influence a single vertex of a layout
+     * 
+     * @param layout the layout to check
+     * @return uint32_t 8 if both bone index and weight sets exist, 4 if only the first set exists and 0 if the layout can't be skinned
+     */
+    static uint32_t getInfluenceCount(const VertexLayout& layout) noexcept;
+
+    /**
+     * @brief skin a mesh and write the result to another mesh
+     * 
+     * If the output mesh doesn't have the same amount of vertices and the same layout as the source mesh, it is replaced by a
+     * copy of the source mesh first. After that only the positions, normals and tangents of the output mesh are written, so
+     * the same output mesh can be re-used every frame without allocations.
+     * 
+     * @param src the mesh to skin
+     * @param bones the matrices of all bones
+     * @param dst the mesh to write the skinned vertices to. Must not be the source mesh.
+     * @return true : the mesh was skinned
+     * @return false : the source mesh can't be skinned
+     */
+    static bool skin(const Mesh& src, std::span<const BoneMatrix> bones, Mesh& dst) noexcept;
+
+    /**
+     * @brief skin a mesh and write the result to separate streams
+     * 
+     * @param src the mesh to skin
+     * @param bones the matrices of all bones
+     * @param dst the streams to write to. Every stream must have room for all vertices of the source mesh.
+     * @return true : the mesh was skinned
+     * @return false : the source mesh can't be skinned or a requested attribute doesn't exist in the source mesh
+     */
+    static bool skin(const Mesh& src, std::span<const BoneMatrix> bones, const SkinningStreams& dst) noexcept;
+
+private:
+
+    //the class is static only
+    Skinning() = delete;
+
+};
+
+#endif
+
+/**
+ * @brief skin a mesh and write the result to another mesh
+ * 
+ * @param src a pointer to the mesh to skin
+ * @param bones a pointer to the matrices of all bones
+ * @param boneCount the amount of bone matrices
+ * @param dst a pointer to the mesh to write the skinned vertices to
+ * @return true : the mesh was skinned
+ * @return false : the source mesh can't be skinned
+ */
+bool skinning_SkinMesh(const Mesh* src, const BoneMatrix* bones, uint64_t boneCount, Mesh* dst);
+
+/**
+ * @brief skin a mesh and write the result to separate streams
+ * 
+ * @param src a pointer to the mesh to skin
+ * @param bones a pointer to the matrices of all bones
+ * @param boneCount the amount of bone matrices
+ * @param dst a pointer to the streams to write to
+ * @return true : the mesh was skinned
+ * @return false : the source mesh can't be skinned or a requested attribute doesn't exist in the source mesh
+ */
+bool skinning_SkinStreams(const Mesh* src, const BoneMatrix* bones, uint64_t boneCount, const SkinningStreams* dst);
+
+#endif
@@ -15,10 +15,22 @@
 
 //include vertices
 #include "Vertex.h"
+//include typed views onto vertex elements
+#include "VertexAttribute.h"
+//include the buffers meshes store their data in
+#include "MeshBuffer.h"
 //include meshes
 #include "Mesh.h"
+//include mesh batches
+#include "MeshBatch.h"
+//include the mesh data encodings
+#include "MeshCodec.h"
+//include mesh files
+#include "MeshFile.h"
 //include mesh assets
 #include "MeshAsset.h"
+//include CPU skinning
+#include "Skinning.h"
 //include triangles
 #include "Triangle.h"
 
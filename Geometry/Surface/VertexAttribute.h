@@ -0,0 +1,306 @@
+/**
+ * @file VertexAttribute.h
+ * @author DM8AT
+ * @brief define typed, strided views onto a single element of many vertices and resolve vertex layouts at compile time
+ * @version 0.1
+ * @date 2025-11-10
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ */
+
+//header guard
+#ifndef _GLGE_CORE_GEOMETRY_SURFACE_VERTEX_ATTRIBUTE_
+#define _GLGE_CORE_GEOMETRY_SURFACE_VERTEX_ATTRIBUTE_
+
+//include vertex layouts
+#include "VertexLayout.h"
+
+//the attribute views are only available for C++
+#if __cplusplus
+
+//arrays store vectors without a math type
+#include <array>
+//for memcpy
+#include <cstring>
+//for type checks
+#include <type_traits>
+
+/**
+ * @brief map a vertex element data type to the C++ type that stores it
+ * 
+ * @tparam Data the data type to map
+ */
+template <VertexElementDataType Data> struct VertexElementDataTypeInfo {
+    //the data type has no C++ representation
+    static constexpr bool defined = false;
+};
+
+//float vectors use the math types if they are tightly packed, else a plain array
+using VertexFloatVec2 = std::conditional_t<sizeof(vec2) == 2*sizeof(float), vec2, std::array<float, 2>>;
+using VertexFloatVec3 = std::conditional_t<sizeof(vec3) == 3*sizeof(float), vec3, std::array<float, 3>>;
+using VertexFloatVec4 = std::conditional_t<sizeof(vec4) == 4*sizeof(float), vec4, std::array<float, 4>>;
+
+//define the mapping for a single data type (the value type is last, so it may contain commas)
+#define __GLGE_VERTEX_DATA_TYPE_INFO(data, component, count, ...) \
+    template <> struct VertexElementDataTypeInfo<data> { \
+        static constexpr bool defined = true; \
+        using Component = component; \
+        static constexpr uint32_t componentCount = count; \
+        using Value = __VA_ARGS__; \
+        static_assert(sizeof(Value) == sizeof(Component) * count, "the C++ type must have the same size as the vertex data"); \
+    };
+//define the mapping for a scalar type and its 2D, 3D and 4D vectors
+#define __GLGE_VERTEX_DATA_TYPE_INFO_ARRAYS(prefix, component) \
+    __GLGE_VERTEX_DATA_TYPE_INFO(prefix##_VEC2, component, 2, std::array<component, 2>) \
+    __GLGE_VERTEX_DATA_TYPE_INFO(prefix##_VEC3, component, 3, std::array<component, 3>) \
+    __GLGE_VERTEX_DATA_TYPE_INFO(prefix##_VEC4, component, 4, std::array<component, 4>)
+
+__GLGE_VERTEX_DATA_TYPE_INFO(VERTEX_ELEMENT_DATA_TYPE_INT8, int8_t, 1, int8_t)
+__GLGE_VERTEX_DATA_TYPE_INFO(VERTEX_ELEMENT_DATA_TYPE_UINT8, uint8_t, 1, uint8_t)
+__GLGE_VERTEX_DATA_TYPE_INFO(VERTEX_ELEMENT_DATA_TYPE_INT16, int16_t, 1, int16_t)
+__GLGE_VERTEX_DATA_TYPE_INFO(VERTEX_ELEMENT_DATA_TYPE_UINT16, uint16_t, 1, uint16_t)
+__GLGE_VERTEX_DATA_TYPE_INFO(VERTEX_ELEMENT_DATA_TYPE_INT32, int32_t, 1, int32_t)
+__GLGE_VERTEX_DATA_TYPE_INFO(VERTEX_ELEMENT_DATA_TYPE_UINT32, uint32_t, 1, uint32_t)
+__GLGE_VERTEX_DATA_TYPE_INFO(VERTEX_ELEMENT_DATA_TYPE_INT64, int64_t, 1, int64_t)
+__GLGE_VERTEX_DATA_TYPE_INFO(VERTEX_ELEMENT_DATA_TYPE_UINT64, uint64_t, 1, uint64_t)
+__GLGE_VERTEX_DATA_TYPE_INFO(VERTEX_ELEMENT_DATA_TYPE_HALF, half, 1, half)
+__GLGE_VERTEX_DATA_TYPE_INFO(VERTEX_ELEMENT_DATA_TYPE_FLOAT, float, 1, float)
+__GLGE_VERTEX_DATA_TYPE_INFO(VERTEX_ELEMENT_DATA_TYPE_DOUBLE, double, 1, double)
+__GLGE_VERTEX_DATA_TYPE_INFO(VERTEX_ELEMENT_DATA_TYPE_FLOAT_VEC2, float, 2, VertexFloatVec2)
+__GLGE_VERTEX_DATA_TYPE_INFO(VERTEX_ELEMENT_DATA_TYPE_FLOAT_VEC3, float, 3, VertexFloatVec3)
+__GLGE_VERTEX_DATA_TYPE_INFO(VERTEX_ELEMENT_DATA_TYPE_FLOAT_VEC4, float, 4, VertexFloatVec4)
+__GLGE_VERTEX_DATA_TYPE_INFO_ARRAYS(VERTEX_ELEMENT_DATA_TYPE_HALF, half)
+__GLGE_VERTEX_DATA_TYPE_INFO_ARRAYS(VERTEX_ELEMENT_DATA_TYPE_DOUBLE, double)
+__GLGE_VERTEX_DATA_TYPE_INFO_ARRAYS(VERTEX_ELEMENT_DATA_TYPE_INT8, int8_t)
+__GLGE_VERTEX_DATA_TYPE_INFO_ARRAYS(VERTEX_ELEMENT_DATA_TYPE_UINT8, uint8_t)
+__GLGE_VERTEX_DATA_TYPE_INFO_ARRAYS(VERTEX_ELEMENT_DATA_TYPE_INT16, int16_t)
+__GLGE_VERTEX_DATA_TYPE_INFO_ARRAYS(VERTEX_ELEMENT_DATA_TYPE_UINT16, uint16_t)
+__GLGE_VERTEX_DATA_TYPE_INFO_ARRAYS(VERTEX_ELEMENT_DATA_TYPE_INT32, int32_t)
+__GLGE_VERTEX_DATA_TYPE_INFO_ARRAYS(VERTEX_ELEMENT_DATA_TYPE_UINT32, uint32_t)
+__GLGE_VERTEX_DATA_TYPE_INFO_ARRAYS(VERTEX_ELEMENT_DATA_TYPE_INT64, int64_t)
+__GLGE_VERTEX_DATA_TYPE_INFO_ARRAYS(VERTEX_ELEMENT_DATA_TYPE_UINT64, uint64_t)
+
+#undef __GLGE_VERTEX_DATA_TYPE_INFO_ARRAYS
+#undef __GLGE_VERTEX_DATA_TYPE_INFO
+
+/**
+ * @brief a typed view onto the same element of many vertices
+ * 
+ * The elements may be spread over interleaved vertices (the stride is the size of a vertex) or tightly packed in a stream
+ * (the stride is the size of the element). Elements of interleaved vertices are not necessarily aligned, so the values are
+ * loaded and stored by copying their bytes. The compiler turns these copies into plain (unaligned) loads and stores.
+ * 
+ * @tparam T the C++ type of a single element. A constant type creates a read only view.
+ */
+template <typename T> class VertexAttributeView
+{
+public:
+
+    //the type of a single element without qualifiers
+    using Value = std::remove_const_t<T>;
+    //the pointer type of the raw data, constant for read only views
+    using Pointer = std::conditional_t<std::is_const_v<T>, const uint8_t*, uint8_t*>;
+
+    //the values are copied byte wise
+    static_assert(std::is_trivially_copyable_v<Value>, "vertex attributes must be trivially copyable");
+
+    /**
+     * @brief Construct a new Vertex Attribute View
+     * 
+     * The view is empty
+     */
+    constexpr VertexAttributeView() noexcept = default;
+
+    /**
+     * @brief Construct a new Vertex Attribute View
+     * 
+     * @param base a pointer to the element of the first vertex
+     * @param stride the distance in bytes between the elements of two vertices
+     * @param count the amount of vertices
+     */
+    constexpr VertexAttributeView(Pointer base, uint64_t stride, uint64_t count) noexcept
+     : m_base(base), m_stride(stride), m_count(count)
+    {}
+
+    /**
+     * @brief convert a writable view into a read only view
+     * 
+     * @param other the writable view
+     */
+    template <typename U> requires (std::is_const_v<T> && std::is_same_v<const U, T>)
+    constexpr VertexAttributeView(const VertexAttributeView<U>& other) noexcept
+     : m_base(other.data()), m_stride(other.getStride()), m_count(other.size())
+    {}
+
+    /**
+     * @brief read the element of a vertex
+     * 
+     * @param i the index of the vertex
+     * @return Value a copy of the element
+     */
+    inline Value operator[](uint64_t i) const noexcept {
+        Value value;
+        memcpy(&value, m_base + i*m_stride, sizeof(Value));
+        return value;
+    }
+
+    /**
+     * @brief write the element of a vertex
+     * 
+     * @param i the index of the vertex
+     * @param value the new value of the element
+     */
+    inline void set(uint64_t i, const Value& value) const noexcept requires (!std::is_const_v<T>)
+    {memcpy(m_base + i*m_stride, &value, sizeof(Value));}
+
+    /**
+     * @brief Get the amount of vertices
+     * 
+     * @return constexpr uint64_t the amount of elements in the view
+     */
+    inline constexpr uint64_t size() const noexcept {return m_count;}
+
+    /**
+     * @brief check if the view is empty
+     * 
+     * @return true : the view contains no elements
+     * @return false : the view contains elements
+     */
+    inline constexpr bool empty() const noexcept {return m_count == 0;}
+
+    /**
+     * @brief Get the distance between the elements of two vertices
+     * 
+     * @return constexpr uint64_t the stride in bytes
+     */
+    inline constexpr uint64_t getStride() const noexcept {return m_stride;}
+
+    /**
+     * @brief check if the elements are tightly packed
+     * 
+     * @return true : the elements follow each other directly, so the view can be used as a plain array
+     * @return false : there is other data between the elements
+     */
+    inline constexpr bool isPacked() const noexcept {return m_stride == sizeof(Value);}
+
+    /**
+     * @brief Get the raw data of the view
+     * 
+     * @return constexpr Pointer a pointer to the element of the first vertex
+     */
+    inline constexpr Pointer data() const noexcept {return m_base;}
+
+protected:
+
+    //a pointer to the element of the first vertex
+    Pointer m_base = nullptr;
+    //the distance between two elements in bytes
+    uint64_t m_stride = 0;
+    //the amount of elements
+    uint64_t m_count = 0;
+
+};
+
+/**
+ * @brief resolve a single element of a vertex layout that is known at compile time
+ * 
+ * All lookups into the layout happen while compiling, so kernels written for a fixed layout (like
+ * GLGE_VERTEX_LAYOUT_VERTEX) access their elements without any runtime type switches.
+ * 
+ * @tparam Layout the layout of the vertices
+ * @tparam Type the type of the element
+ */
+template <VertexLayout Layout, VertexElementType Type> struct VertexLayoutElement {
+    //the index of the element in the layout
+    static constexpr uint64_t index = Layout.getIndexOfElement(Type);
+    //elements that don't exist can't be accessed
+    static_assert(index != UINT64_MAX, "the vertex layout doesn't contain the element");
+    //the data type of the element
+    static constexpr VertexElementDataType data = Layout.m_elements[index].data;
+    //only data types with a C++ representation can be accessed
+    static_assert(VertexElementDataTypeInfo<data>::defined, "the data type of the element has no C++ representation");
+    //the C++ type of the element
+    using Value = typename VertexElementDataTypeInfo<data>::Value;
+    //the offset of the element in an interleaved vertex
+    static constexpr uint64_t offset = Layout.getOffsetOf(index);
+    //the size of a whole vertex
+    static constexpr uint64_t vertexSize = Layout.m_size;
+
+    /**
+     * @brief create a view onto the element of a vertex buffer
+     * 
+     * @tparam T the type of the view. Use const Value for a read only view.
+     * @param vertices a pointer to the vertex buffer
+     * @param vertexCount the amount of vertices in the buffer
+     * @param storage the way the vertices are arranged in memory
+     * @return VertexAttributeView<T> the view onto the element of all vertices
+     */
+    template <typename T = Value> static inline constexpr VertexAttributeView<T> view(typename VertexAttributeView<T>::Pointer vertices,
+                                                                                      uint64_t vertexCount, VertexStorageMode storage) noexcept {
+        static_assert(std::is_same_v<std::remove_const_t<T>, Value>, "the view must use the type of the element");
+        if (storage == VERTEX_STORAGE_MODE_SEPARATE)
+        {return VertexAttributeView<T>(vertices + offset * vertexCount, sizeof(Value), vertexCount);}
+        return VertexAttributeView<T>(vertices + offset, vertexSize, vertexCount);
+    }
+};
+
+/**
+ * @brief call a function with a view of the matching C++ type onto an element whose data type is only known at runtime
+ * 
+ * The data type is dispatched once, so the function can run tight loops without checking the type of every element.
+ * The function is instantiated for every data type, use `if constexpr` on the value type of the view to skip types a
+ * kernel doesn't support.
+ * 
+ * @tparam Const true to pass read only views
+ * @tparam Func the type of the function. It must accept a VertexAttributeView of every C++ element type.
+ * @param base a pointer to the element of the first vertex
+ * @param stride the distance between the elements of two vertices in bytes
+ * @param count the amount of vertices
+ * @param data the data type of the element
+ * @param func the function to call
+ * @return true : the function was called
+ * @return false : the data type has no C++ representation, the function was not called
+ */
+template <bool Const, typename Func>
+inline bool visitVertexAttribute(std::conditional_t<Const, const uint8_t*, uint8_t*> base, uint64_t stride, uint64_t count,
+                                 VertexElementDataType data, Func&& func) noexcept {
+    //expand to a case that calls the function with the view of a data type
+    #define __GLGE_VISIT_VERTEX_DATA_TYPE(type) \
+        case type: { \
+            using Value = typename VertexElementDataTypeInfo<type>::Value; \
+            func(VertexAttributeView<std::conditional_t<Const, const Value, Value>>(base, stride, count)); \
+            return true; \
+        }
+    //expand to the cases of a scalar type and its 2D, 3D and 4D vectors
+    #define __GLGE_VISIT_VERTEX_DATA_TYPES(type) \
+        __GLGE_VISIT_VERTEX_DATA_TYPE(type) \
+        __GLGE_VISIT_VERTEX_DATA_TYPE(type##_VEC2) \
+        __GLGE_VISIT_VERTEX_DATA_TYPE(type##_VEC3) \
+        __GLGE_VISIT_VERTEX_DATA_TYPE(type##_VEC4)
+
+    switch (data)
+    {
+    __GLGE_VISIT_VERTEX_DATA_TYPES(VERTEX_ELEMENT_DATA_TYPE_INT8)
+    __GLGE_VISIT_VERTEX_DATA_TYPES(VERTEX_ELEMENT_DATA_TYPE_UINT8)
+    __GLGE_VISIT_VERTEX_DATA_TYPES(VERTEX_ELEMENT_DATA_TYPE_INT16)
+    __GLGE_VISIT_VERTEX_DATA_TYPES(VERTEX_ELEMENT_DATA_TYPE_UINT16)
+    __GLGE_VISIT_VERTEX_DATA_TYPES(VERTEX_ELEMENT_DATA_TYPE_INT32)
+    __GLGE_VISIT_VERTEX_DATA_TYPES(VERTEX_ELEMENT_DATA_TYPE_UINT32)
+    __GLGE_VISIT_VERTEX_DATA_TYPES(VERTEX_ELEMENT_DATA_TYPE_INT64)
+    __GLGE_VISIT_VERTEX_DATA_TYPES(VERTEX_ELEMENT_DATA_TYPE_UINT64)
+    __GLGE_VISIT_VERTEX_DATA_TYPES(VERTEX_ELEMENT_DATA_TYPE_HALF)
+    __GLGE_VISIT_VERTEX_DATA_TYPES(VERTEX_ELEMENT_DATA_TYPE_FLOAT)
+    __GLGE_VISIT_VERTEX_DATA_TYPES(VERTEX_ELEMENT_DATA_TYPE_DOUBLE)
+    default:
+        //the data type has no C++ representation
+        return false;
+    }
+
+    #undef __GLGE_VISIT_VERTEX_DATA_TYPES
+    #undef __GLGE_VISIT_VERTEX_DATA_TYPE
+}
+
+#endif
+
+#endif
@@ -66,10 +66,19 @@ typedef enum e_VertexElementType {
     VERTEX_ELEMENT_TYPE_COLOR6,
     //the element represents a color
     VERTEX_ELEMENT_TYPE_COLOR7,
+
+    //the element stores the indices of the first 4 bones that influence the vertex (an integer 4D vector)
+    VERTEX_ELEMENT_TYPE_BONE_INDICES0,
+    //the element stores the indices of the bones 5 to 8 that influence the vertex (an integer 4D vector)
+    VERTEX_ELEMENT_TYPE_BONE_INDICES1,
+    //the element stores the weights of the bones in BONE_INDICES0 (a float or normalized unsigned integer 4D vector)
+    VERTEX_ELEMENT_TYPE_BONE_WEIGHTS0,
+    //the element stores the weights of the bones in BONE_INDICES1 (a float or normalized unsigned integer 4D vector)
+    VERTEX_ELEMENT_TYPE_BONE_WEIGHTS1,
 } VertexElementType;
 
 //define how many different types of vertex element types exist
-#define VERTEX_ELEMENT_TYPE_COUNT 21
+#define VERTEX_ELEMENT_TYPE_COUNT 25
 
 /**
  * @brief define an identifier for a single type of vertex element
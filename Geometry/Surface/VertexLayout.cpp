@@ -19,4 +19,7 @@ uint64_t vertexLayout_GetVertexSize(VertexLayout* layout)
 {return layout->getVertexSize();}
 
 uint64_t vertexLayout_GetIndexOfElement(VertexElementType type, VertexLayout* layout)
-{return layout->getIndexOfElement(type);}
\ No newline at end of file
+{return layout->getIndexOfElement(type);}
+
+uint64_t vertexLayout_GetElementSize(uint64_t idx, VertexLayout* layout)
+{return layout->getElementSize(idx);}
@@ -26,6 +26,17 @@
     #include <array>
 #endif
 
+/**
+ * @brief define how the elements of multiple vertices are arranged in memory
+ */
+typedef enum e_VertexStorageMode {
+    //all elements of a single vertex are stored next to each other (array of structures)
+    VERTEX_STORAGE_MODE_INTERLEAVED = 0,
+    //each element is stored in its own, tightly packed stream (structure of arrays)
+    //the streams are ordered like the elements of the layout and directly follow each other
+    VERTEX_STORAGE_MODE_SEPARATE
+} VertexStorageMode;
+
 /**
  * @brief store an actual vertex
  */
@@ -34,6 +45,13 @@ typedef struct s_VertexLayout {
     //member functions for C++
     #if __cplusplus 
 
+    /**
+     * @brief Construct a new, empty Vertex Layout
+     * 
+     * The layout has no elements and a size of 0 bytes. It is used by empty meshes.
+     */
+    s_VertexLayout() = default;
+
     /**
      * @brief Construct a new Vertex Layout
      * 
@@ -138,6 +156,28 @@ typedef struct s_VertexLayout {
         return offs;
     }
 
+    /**
+     * @brief Get the size of a single element in bytes
+     * 
+     * @param idx the index of the element to quarry the size of
+     * @return constexpr uint64_t the size of the element in bytes or 0 if the index is out of range
+     */
+    inline constexpr uint64_t getElementSize(uint64_t idx) const noexcept
+    {return (idx < VERTEX_ELEMENT_TYPE_COUNT) ? size(m_elements[idx].data) : 0;}
+
+    /**
+     * @brief Get the offset of the stream of a specific element when the vertices are stored separately
+     * 
+     * In separate storage all elements of a type are packed together, so the stream of an element starts after the
+     * streams of all previous elements.
+     * 
+     * @param idx the index of the element to quarry the stream offset of
+     * @param vertexCount the amount of vertices stored in the buffer
+     * @return constexpr uint64_t the offset in bytes from the start of the vertex buffer to the first element of the stream
+     */
+    inline constexpr uint64_t getStreamOffsetOf(uint64_t idx, uint64_t vertexCount) const noexcept
+    {return getOffsetOf(idx) * vertexCount;}
+
     /**
      * @brief Comparison operator to check equality between two vertex layouts
      * 
@@ -328,4 +368,13 @@ uint64_t vertexLayout_GetVertexSize(VertexLayout* layout);
  */
 uint64_t vertexLayout_GetIndexOfElement(VertexElementType type, VertexLayout* layout);
 
+/**
+ * @brief get the size of a single element of a vertex layout in bytes
+ * 
+ * @param idx the index of the element to quarry the size of
+ * @param layout a pointer to the layout to quarry the information from
+ * @return uint64_t the size of the element in bytes or 0 if the index is out of range
+ */
+uint64_t vertexLayout_GetElementSize(uint64_t idx, VertexLayout* layout);
+
 #endif
\ No newline at end of file
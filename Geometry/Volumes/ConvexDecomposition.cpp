@@ -0,0 +1,496 @@
+/**
+ * @file ConvexDecomposition.cpp
+ * @author DM8AT
+ * @brief implement the voxel based approximate convex decomposition and its C binding
+ * @version 0.1
+ * @date 2025-11-09
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ */
+
+//include the convex decomposition
+#include "ConvexDecomposition.h"
+
+//include the thread pool for parallel processing
+#include "../../Threading/ThreadPool.h"
+
+//for minimum, maximum and sorting
+#include <algorithm>
+//for the float limits
+#include <cfloat>
+
+/**
+ * @brief the state of a single voxel after the voxelization
+ */
+enum __VoxelState : uint8_t {
+    //the voxel was not touched yet
+    __VOXEL_EMPTY = 0,
+    //the voxel intersects the surface of the mesh
+    __VOXEL_SURFACE,
+    //the voxel is outside of the mesh
+    __VOXEL_OUTSIDE
+};
+
+/**
+ * @brief store the voxel grid of the mesh
+ * 
+ * The grid has an empty layer of voxels on every side, so every solid voxel has 6 neighbors inside of the grid.
+ */
+struct __VoxelGrid {
+    //the amount of voxels along every axis
+    uint32_t dim[3];
+    //the position of the first corner of the grid in mesh space
+    vec3 origin;
+    //the edge length of a single voxel in mesh space
+    float size;
+    //the part every voxel belongs to or UINT32_MAX for voxels outside of the mesh
+    std::vector<uint32_t> labels;
+
+    //convert a voxel coordinate to the index in the grid
+    inline uint64_t index(uint32_t x, uint32_t y, uint32_t z) const noexcept {return x + (uint64_t)dim[0]*(y + (uint64_t)dim[1]*z);}
+    //convert an index in the grid to the coordinate of the voxel
+    inline void coord(uint64_t idx, uint32_t c[3]) const noexcept {
+        c[0] = (uint32_t)(idx % dim[0]);
+        c[1] = (uint32_t)((idx / dim[0]) % dim[1]);
+        c[2] = (uint32_t)(idx / ((uint64_t)dim[0]*dim[1]));
+    }
+};
+
+/**
+ * @brief store a connected set of voxels that is either split further or turned into a hull
+ */
+struct __Part {
+    //the label of the voxels of the part
+    uint32_t id;
+    //the amount of times the part was split from the whole mesh
+    uint32_t depth;
+    //the indices of all voxels of the part
+    std::vector<uint32_t> voxels;
+};
+
+/**
+ * @brief store a finished hull while the hulls are merged
+ */
+struct __Piece {
+    //the vertices of the hull in voxel space
+    std::vector<vec3> points;
+    //the volume of the hull
+    float volume;
+    //the bounds of the hull
+    AABB bounds;
+    //false if the piece was merged into another piece
+    bool alive;
+};
+
+/**
+ * @brief check if a triangle intersects a cube (separating axis test by Akenine-Möller)
+ * 
+ * @param center the center of the cube
+ * @param half half of the edge length of the cube
+ * @param tri the corners of the triangle
+ * @return true : the triangle touches the cube
+ * @return false : the triangle is separated from the cube
+ */
+static bool __triangleCubeOverlap(const float center[3], float half, const vec3 tri[3]) noexcept {
+    float v[3][3];
+    for (uint32_t i = 0; i < 3; ++i) {
+        v[i][0] = tri[i].x - center[0];
+        v[i][1] = tri[i].y - center[1];
+        v[i][2] = tri[i].z - center[2];
+    }
+    //the axes of the cube
+    for (uint32_t a = 0; a < 3; ++a) {
+        if (std::min({v[0][a], v[1][a], v[2][a]}) > half || std::max({v[0][a], v[1][a], v[2][a]}) < -half) {return false;}
+    }
+    //the cross products of the cube axes and the triangle edges
+    float e[3][3];
+    for (uint32_t i = 0; i < 3; ++i) {
+        for (uint32_t a = 0; a < 3; ++a) {e[i][a] = v[(i+1)%3][a] - v[i][a];}
+    }
+    for (uint32_t i = 0; i < 3; ++i) {
+        const float axes[3][3] = {{0.f, -e[i][2], e[i][1]}, {e[i][2], 0.f, -e[i][0]}, {-e[i][1], e[i][0], 0.f}};
+        for (const float* axis : axes) {
+            float p0 = axis[0]*v[0][0] + axis[1]*v[0][1] + axis[2]*v[0][2];
+            float p1 = axis[0]*v[1][0] + axis[1]*v[1][1] + axis[2]*v[1][2];
+            float p2 = axis[0]*v[2][0] + axis[1]*v[2][1] + axis[2]*v[2][2];
+            float r = half * (std::abs(axis[0]) + std::abs(axis[1]) + std::abs(axis[2]));
+            if (std::min({p0, p1, p2}) > r || std::max({p0, p1, p2}) < -r) {return false;}
+        }
+    }
+    //the plane of the triangle
+    float n[3] = {e[0][1]*e[1][2] - e[0][2]*e[1][1], e[0][2]*e[1][0] - e[0][0]*e[1][2], e[0][0]*e[1][1] - e[0][1]*e[1][0]};
+    float d = n[0]*v[0][0] + n[1]*v[0][1] + n[2]*v[0][2];
+    return std::abs(d) <= half * (std::abs(n[0]) + std::abs(n[1]) + std::abs(n[2]));
+}
+
+/**
+ * @brief convert a mesh into a voxel grid and fill its inside
+ * 
+ * @param positions the positions of the mesh
+ * @param indices the triangles of the mesh
+ * @param resolution the amount of voxels along the longest axis
+ * @param grid the grid to fill. All solid voxels get the label 0.
+ * @return uint64_t the amount of solid voxels
+ */
+static uint64_t __voxelize(const std::vector<vec3>& positions, const std::vector<uint32_t>& indices, uint32_t resolution, __VoxelGrid& grid) noexcept {
+    AABB bounds(positions[0], positions[0]);
+    for (const vec3& p : positions) {bounds.merge(p);}
+    vec3 extent = bounds.max - bounds.min;
+    float longest = std::max({extent.x, extent.y, extent.z});
+    if (!(longest > 0.f)) {return 0;}
+
+    //one empty layer before the mesh and up to two after it, so rounding never places the surface on the border
+    grid.size = longest / (float)resolution;
+    grid.origin = bounds.min - vec3(grid.size);
+    grid.dim[0] = (uint32_t)(extent.x / grid.size) + 3;
+    grid.dim[1] = (uint32_t)(extent.y / grid.size) + 3;
+    grid.dim[2] = (uint32_t)(extent.z / grid.size) + 3;
+    uint64_t total = (uint64_t)grid.dim[0] * grid.dim[1] * grid.dim[2];
+    //the voxels of the parts are addressed with 32 bit indices
+    if (total >= UINT32_MAX) {return 0;}
+    std::vector<uint8_t> state(total, __VOXEL_EMPTY);
+
+    //every task owns a range of z layers, so the triangles can write without synchronization
+    float half = grid.size * 0.5f;
+    uint64_t triCount = indices.size() / 3;
+    ThreadPool::getGlobal().parallelFor(grid.dim[2], 1, [&](uint64_t zBegin, uint64_t zEnd) {
+        for (uint64_t t = 0; t < triCount; ++t) {
+            vec3 tri[3] = {positions[indices[t*3]], positions[indices[t*3+1]], positions[indices[t*3+2]]};
+            AABB triBounds(tri[0], tri[0]);
+            triBounds.merge(tri[1]);
+            triBounds.merge(tri[2]);
+            vec3 lo = (triBounds.min - grid.origin) / grid.size;
+            vec3 hi = (triBounds.max - grid.origin) / grid.size;
+            uint32_t z0 = std::max((uint32_t)lo.z, (uint32_t)zBegin);
+            uint32_t z1 = std::min((uint32_t)hi.z, (uint32_t)zEnd - 1);
+            for (uint32_t z = z0; z <= z1; ++z) {
+                for (uint32_t y = (uint32_t)lo.y; y <= (uint32_t)hi.y; ++y) {
+                    for (uint32_t x = (uint32_t)lo.x; x <= (uint32_t)hi.x; ++x) {
+                        uint8_t& s = state[grid.index(x, y, z)];
+                        if (s == __VOXEL_SURFACE) {continue;}
+                        float center[3] = {grid.origin.x + (x + 0.5f)*grid.size, grid.origin.y + (y + 0.5f)*grid.size, grid.origin.z + (z + 0.5f)*grid.size};
+                        if (__triangleCubeOverlap(center, half, tri)) {s = __VOXEL_SURFACE;}
+                    }
+                }
+            }
+        }
+    });
+
+    //flood fill the outside starting at the empty border, everything that is not reached is inside of the mesh
+    std::vector<uint64_t> stack = {0};
+    state[0] = __VOXEL_OUTSIDE;
+    while (!stack.empty()) {
+        uint64_t idx = stack.back();
+        stack.pop_back();
+        uint32_t c[3];
+        grid.coord(idx, c);
+        const int64_t steps[3] = {1, (int64_t)grid.dim[0], (int64_t)grid.dim[0]*grid.dim[1]};
+        for (uint32_t a = 0; a < 3; ++a) {
+            if (c[a] > 0 && state[idx - steps[a]] == __VOXEL_EMPTY) {state[idx - steps[a]] = __VOXEL_OUTSIDE; stack.push_back(idx - steps[a]);}
+            if (c[a] + 1 < grid.dim[a] && state[idx + steps[a]] == __VOXEL_EMPTY) {state[idx + steps[a]] = __VOXEL_OUTSIDE; stack.push_back(idx + steps[a]);}
+        }
+    }
+
+    grid.labels.assign(total, UINT32_MAX);
+    uint64_t solid = 0;
+    for (uint64_t i = 0; i < total; ++i) {
+        if (state[i] != __VOXEL_OUTSIDE) {grid.labels[i] = 0; ++solid;}
+    }
+    return solid;
+}
+
+/**
+ * @brief collect the corners of the voxels that can be vertices of the hull of a set of voxels
+ * 
+ * Every voxel of a row along the x axis lies between the first and the last voxel of the row, so only the outer corners
+ * of these two voxels are needed to build the hull of the whole set.
+ * 
+ * @tparam Filter a function that gets the coordinate of a voxel and returns true if the voxel belongs to the set
+ * @param grid the voxel grid
+ * @param voxels the voxels to select the set from
+ * @param filter the function to select the voxels with
+ * @return std::vector<vec3> the corners in voxel space
+ */
+template <typename Filter>
+static std::vector<vec3> __hullPoints(const __VoxelGrid& grid, const std::vector<uint32_t>& voxels, Filter&& filter) noexcept {
+    uint64_t rows = (uint64_t)grid.dim[1] * grid.dim[2];
+    std::vector<uint32_t> rowMin(rows, UINT32_MAX);
+    std::vector<uint32_t> rowMax(rows, 0);
+    for (uint32_t idx : voxels) {
+        uint32_t c[3];
+        grid.coord(idx, c);
+        if (!filter(c)) {continue;}
+        uint64_t row = c[1] + (uint64_t)grid.dim[1]*c[2];
+        rowMin[row] = std::min(rowMin[row], c[0]);
+        rowMax[row] = std::max(rowMax[row], c[0]);
+    }
+
+    std::vector<vec3> points;
+    for (uint64_t row = 0; row < rows; ++row) {
+        if (rowMin[row] == UINT32_MAX) {continue;}
+        float y = (float)(row % grid.dim[1]);
+        float z = (float)(row / grid.dim[1]);
+        for (uint32_t i = 0; i < 4; ++i) {
+            points.push_back(vec3((float)rowMin[row], y + (float)(i & 1), z + (float)(i >> 1)));
+            points.push_back(vec3((float)rowMax[row] + 1.f, y + (float)(i & 1), z + (float)(i >> 1)));
+        }
+    }
+    return points;
+}
+
+/**
+ * @brief count the voxels inside of a hull that don't belong to a part
+ * 
+ * @param grid the voxel grid
+ * @param hull the hull of the part in voxel space
+ * @param id the label of the part
+ * @return uint64_t the amount of voxels that are covered by the hull but are outside of the mesh or belong to other parts
+ */
+static uint64_t __countConcavity(const __VoxelGrid& grid, const ConvexHull& hull, uint32_t id) noexcept {
+    //voxels whose centers are exactly on a plane of the hull count as inside
+    constexpr float EPSILON = 1e-3f;
+    const AABB& bounds = hull.getBounds();
+    uint32_t lo[3] = {(uint32_t)std::max(bounds.min.x, 0.f), (uint32_t)std::max(bounds.min.y, 0.f), (uint32_t)std::max(bounds.min.z, 0.f)};
+    uint32_t hi[3] = {std::min((uint32_t)bounds.max.x, grid.dim[0]), std::min((uint32_t)bounds.max.y, grid.dim[1]), std::min((uint32_t)bounds.max.z, grid.dim[2])};
+    uint64_t count = 0;
+    for (uint32_t z = lo[2]; z < hi[2]; ++z) {
+        for (uint32_t y = lo[1]; y < hi[1]; ++y) {
+            for (uint32_t x = lo[0]; x < hi[0]; ++x) {
+                if (grid.labels[grid.index(x, y, z)] == id) {continue;}
+                if (hull.contains(vec3(x + 0.5f, y + 0.5f, z + 0.5f), EPSILON)) {++count;}
+            }
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief compute the hull of the union of two point sets
+ * 
+ * @param a the first point set
+ * @param b the second point set
+ * @param hull the hull to build
+ */
+static void __mergedHull(const std::vector<vec3>& a, const std::vector<vec3>& b, ConvexHull& hull) noexcept {
+    std::vector<vec3> points;
+    points.reserve(a.size() + b.size());
+    points.insert(points.end(), a.begin(), a.end());
+    points.insert(points.end(), b.begin(), b.end());
+    hull.build(points);
+}
+
+/**
+ * @brief compute the cost of merging two pieces
+ * 
+ * @param a the first piece
+ * @param b the second piece
+ * @return float the volume the merged hull adds to both hulls or FLT_MAX if the pieces don't touch
+ */
+static float __mergeCost(const __Piece& a, const __Piece& b) noexcept {
+    //only pieces whose bounds touch are merged directly, everything else would create large hulls over empty space
+    if (a.bounds.min.x > b.bounds.max.x + 1.f || b.bounds.min.x > a.bounds.max.x + 1.f ||
+        a.bounds.min.y > b.bounds.max.y + 1.f || b.bounds.min.y > a.bounds.max.y + 1.f ||
+        a.bounds.min.z > b.bounds.max.z + 1.f || b.bounds.min.z > a.bounds.max.z + 1.f) {return FLT_MAX;}
+    ConvexHull hull;
+    __mergedHull(a.points, b.points, hull);
+    return hull.getVolume() - a.volume - b.volume;
+}
+
+std::vector<ConvexHull> ConvexDecomposition::decompose(const Mesh& mesh, const ConvexDecompositionSettings& settings) noexcept
+{
+    //collect the triangles of the mesh
+    std::vector<vec3> positions = mesh.getPositions();
+    if (positions.empty() || settings.resolution == 0) {return {};}
+    std::vector<uint32_t> indices;
+    if (mesh.getIndexCount()) {
+        indices.resize(mesh.getIndexCount());
+        mesh.visitIndices([&](auto src) {
+            for (uint64_t i = 0; i < indices.size(); ++i) {indices[i] = (uint32_t)src[i];}
+        });
+    } else {
+        indices.resize(positions.size());
+        for (uint32_t i = 0; i < (uint32_t)indices.size(); ++i) {indices[i] = i;}
+    }
+    indices.resize(indices.size() - indices.size() % 3);
+
+    __VoxelGrid grid;
+    uint64_t solid = __voxelize(positions, indices, std::min<uint32_t>(settings.resolution, GLGE_CONVEX_DECOMPOSITION_MAX_RESOLUTION), grid);
+    if (solid == 0) {return {};}
+    uint64_t allowedConcavity = (uint64_t)(settings.maxConcavity * (float)solid);
+
+    //the whole mesh is the first part
+    std::vector<__Part> parts(1);
+    parts[0].id = 0;
+    parts[0].depth = 0;
+    for (uint64_t i = 0; i < grid.labels.size(); ++i) {
+        if (grid.labels[i] == 0) {parts[0].voxels.push_back((uint32_t)i);}
+    }
+    uint32_t nextId = 1;
+    std::vector<__Piece> pieces;
+
+    //all parts of a level are independent, they only read the labels of the other parts
+    while (!parts.empty()) {
+        std::vector<__Piece> finished(parts.size());
+        std::vector<std::vector<uint32_t>> halves(parts.size() * 2);
+        ThreadPool::getGlobal().parallelFor(parts.size(), 1, [&](uint64_t begin, uint64_t end) {
+            for (uint64_t p = begin; p < end; ++p) {
+                const __Part& part = parts[p];
+                ConvexHull hull(__hullPoints(grid, part.voxels, [](const uint32_t*) {return true;}));
+
+                //parts that fill their hull well enough are finished
+                bool accept = part.depth >= settings.maxDepth || part.voxels.size() < 8 || hull.empty() ||
+                              __countConcavity(grid, hull, part.id) <= allowedConcavity;
+                uint32_t lo[3] = {UINT32_MAX, UINT32_MAX, UINT32_MAX};
+                uint32_t hi[3] = {0, 0, 0};
+                if (!accept) {
+                    for (uint32_t idx : part.voxels) {
+                        uint32_t c[3];
+                        grid.coord(idx, c);
+                        for (uint32_t a = 0; a < 3; ++a) {lo[a] = std::min(lo[a], c[a]); hi[a] = std::max(hi[a], c[a]);}
+                    }
+                    accept = lo[0] == hi[0] && lo[1] == hi[1] && lo[2] == hi[2];
+                }
+                if (accept) {
+                    std::span<const vec3> vertices = hull.getVertices();
+                    finished[p] = __Piece{std::vector<vec3>(vertices.begin(), vertices.end()), hull.getVolume(), hull.getBounds(), !hull.empty()};
+                    continue;
+                }
+
+                //try up to 8 evenly spaced axis aligned cuts per axis, the cut left of a plane gets the voxels below it
+                constexpr uint32_t CUTS_PER_AXIS = 8;
+                std::vector<std::pair<uint32_t, uint32_t>> candidates;
+                for (uint32_t a = 0; a < 3; ++a) {
+                    uint32_t extent = hi[a] - lo[a];
+                    if (extent == 0) {continue;}
+                    uint32_t step = std::max(1u, (extent + 1) / (CUTS_PER_AXIS + 1));
+                    for (uint32_t cut = lo[a] + step; cut <= hi[a]; cut += step) {candidates.push_back({a, cut});}
+                }
+                std::vector<float> costs(candidates.size(), FLT_MAX);
+                ThreadPool::getGlobal().parallelFor(candidates.size(), 1, [&](uint64_t cBegin, uint64_t cEnd) {
+                    for (uint64_t c = cBegin; c < cEnd; ++c) {
+                        auto [axis, cut] = candidates[c];
+                        uint64_t upper = 0;
+                        for (uint32_t idx : part.voxels) {
+                            uint32_t coord[3];
+                            grid.coord(idx, coord);
+                            upper += coord[axis] >= cut;
+                        }
+                        uint64_t lower = part.voxels.size() - upper;
+                        if (lower == 0 || upper == 0) {continue;}
+                        //the cost is the volume of both hulls and a small penalty for unbalanced cuts
+                        float cost = 0.05f * std::abs((float)lower - (float)upper);
+                        for (uint32_t s = 0; s < 2; ++s) {
+                            auto inSide = [&](const uint32_t* coord) {return (coord[axis] >= cut) == (s == 1);};
+                            cost += ConvexHull(__hullPoints(grid, part.voxels, inSide)).getVolume();
+                        }
+                        costs[c] = cost;
+                    }
+                });
+                uint64_t best = std::min_element(costs.begin(), costs.end()) - costs.begin();
+                if (costs.empty() || costs[best] == FLT_MAX) {
+                    std::span<const vec3> vertices = hull.getVertices();
+                    finished[p] = __Piece{std::vector<vec3>(vertices.begin(), vertices.end()), hull.getVolume(), hull.getBounds(), !hull.empty()};
+                    continue;
+                }
+                auto [axis, cut] = candidates[best];
+                for (uint32_t idx : part.voxels) {
+                    uint32_t coord[3];
+                    grid.coord(idx, coord);
+                    halves[p*2 + (coord[axis] >= cut)].push_back(idx);
+                }
+            }
+        });
+
+        //relabel the halves and continue with the next level
+        std::vector<__Part> next;
+        for (uint64_t p = 0; p < parts.size(); ++p) {
+            if (halves[p*2].empty()) {
+                if (finished[p].alive) {pieces.push_back(std::move(finished[p]));}
+                continue;
+            }
+            for (uint32_t s = 0; s < 2; ++s) {
+                __Part child;
+                child.id = nextId++;
+                child.depth = parts[p].depth + 1;
+                child.voxels = std::move(halves[p*2 + s]);
+                for (uint32_t idx : child.voxels) {grid.labels[idx] = child.id;}
+                next.push_back(std::move(child));
+            }
+        }
+        parts = std::move(next);
+    }
+
+    //merge the cheapest pair of touching hulls until the hull limit is reached
+    uint64_t count = pieces.size();
+    uint64_t maxHulls = std::max(settings.maxHulls, 1u);
+    if (count > maxHulls) {
+        std::vector<float> costs(count * count, FLT_MAX);
+        ThreadPool::getGlobal().parallelFor(count, 1, [&](uint64_t begin, uint64_t end) {
+            for (uint64_t i = begin; i < end; ++i) {
+                for (uint64_t j = i+1; j < count; ++j) {costs[i*count + j] = __mergeCost(pieces[i], pieces[j]);}
+            }
+        });
+        for (uint64_t alive = count; alive > maxHulls; --alive) {
+            uint64_t bi = 0, bj = 0;
+            float best = FLT_MAX;
+            for (uint64_t i = 0; i < count; ++i) {
+                if (!pieces[i].alive) {continue;}
+                for (uint64_t j = i+1; j < count; ++j) {
+                    if (pieces[j].alive && costs[i*count + j] < best) {best = costs[i*count + j]; bi = i; bj = j;}
+                }
+            }
+            //if no pieces touch anymore, merge the pieces whose combined bounds grow the least
+            if (best == FLT_MAX) {
+                for (uint64_t i = 0; i < count; ++i) {
+                    if (!pieces[i].alive) {continue;}
+                    for (uint64_t j = i+1; j < count; ++j) {
+                        if (!pieces[j].alive) {continue;}
+                        AABB merged = pieces[i].bounds;
+                        merged.merge(pieces[j].bounds);
+                        float cost = merged.getVolume() - pieces[i].bounds.getVolume() - pieces[j].bounds.getVolume();
+                        if (cost < best) {best = cost; bi = i; bj = j;}
+                    }
+                }
+            }
+
+            ConvexHull hull;
+            __mergedHull(pieces[bi].points, pieces[bj].points, hull);
+            std::span<const vec3> vertices = hull.getVertices();
+            pieces[bi] = __Piece{std::vector<vec3>(vertices.begin(), vertices.end()), hull.getVolume(), hull.getBounds(), true};
+            pieces[bj].alive = false;
+            std::vector<vec3>().swap(pieces[bj].points);
+
+            //only the costs of the merged piece changed
+            ThreadPool::getGlobal().parallelFor(count, 1, [&](uint64_t begin, uint64_t end) {
+                for (uint64_t j = begin; j < end; ++j) {
+                    if (j == bi || !pieces[j].alive) {continue;}
+                    float cost = __mergeCost(pieces[bi], pieces[j]);
+                    costs[std::min(bi, j)*count + std::max(bi, j)] = cost;
+                }
+            });
+        }
+    }
+
+    //move the hulls back to mesh space and apply the vertex limit
+    std::vector<ConvexHull> hulls;
+    for (__Piece& piece : pieces) {
+        if (!piece.alive) {continue;}
+        for (vec3& p : piece.points) {p = grid.origin + p * grid.size;}
+        ConvexHull hull;
+        if (hull.build(piece.points, settings.maxVerticesPerHull)) {hulls.push_back(std::move(hull));}
+    }
+    return hulls;
+}
+
+
+
+uint64_t convexDecomposition_Decompose(const Mesh* mesh, const ConvexDecompositionSettings* settings, ConvexHull** hulls, uint64_t maxHulls)
+{
+    std::vector<ConvexHull> result = ConvexDecomposition::decompose(*mesh, *settings);
+    if (!hulls) {return result.size();}
+    //hand out as many hulls as fit into the array
+    uint64_t count = std::min<uint64_t>(result.size(), maxHulls);
+    for (uint64_t i = 0; i < count; ++i) {hulls[i] = new ConvexHull(std::move(result[i]));}
+    return count;
+}
@@ -0,0 +1,114 @@
+/**
+ * @file ConvexDecomposition.h
+ * @author DM8AT
+ * @brief define an approximate convex decomposition that splits a mesh into a set of convex hulls
+ * @version 0.1
+ * @date 2025-11-09
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ */
+
+//header guard
+#ifndef _GLGE_CORE_GEOMETRY_VOLUMES_CONVEX_DECOMPOSITION_
+#define _GLGE_CORE_GEOMETRY_VOLUMES_CONVEX_DECOMPOSITION_
+
+//include the type definitions
+#include "../../Types.h"
+//include convex hulls as output
+#include "ConvexHull.h"
+
+//the largest usable resolution, the voxels of the padded grid must be addressable with 32 bit indices
+#define GLGE_CONVEX_DECOMPOSITION_MAX_RESOLUTION 1600
+
+/**
+ * @brief store the settings of a convex decomposition
+ */
+typedef struct s_ConvexDecompositionSettings {
+    //the amount of voxels along the longest axis of the mesh (clamped to GLGE_CONVEX_DECOMPOSITION_MAX_RESOLUTION)
+    uint32_t resolution;
+    //the maximum amount of hulls that are created
+    uint32_t maxHulls;
+    //the maximum amount of vertices of a single hull
+    uint32_t maxVerticesPerHull;
+    //the maximum amount of times a part of the mesh is split
+    uint32_t maxDepth;
+    //the amount of voxels that may be inside of a hull but not inside of the mesh, relative to the volume of the mesh
+    float maxConcavity;
+
+    //for C++ add a constructor with default values
+    #if __cplusplus
+
+    /**
+     * @brief Construct new Convex Decomposition Settings
+     * 
+     * @param _resolution the amount of voxels along the longest axis of the mesh (clamped to GLGE_CONVEX_DECOMPOSITION_MAX_RESOLUTION)
+     * @param _maxHulls the maximum amount of hulls that are created
+     * @param _maxVerticesPerHull the maximum amount of vertices of a single hull
+     * @param _maxDepth the maximum amount of times a part of the mesh is split
+     * @param _maxConcavity the amount of voxels that may be inside of a hull but not inside of the mesh, relative to the volume of the mesh
+     */
+    inline constexpr s_ConvexDecompositionSettings(uint32_t _resolution = 64, uint32_t _maxHulls = 32, uint32_t _maxVerticesPerHull = 64,
+                                                   uint32_t _maxDepth = 8, float _maxConcavity = 0.002f) noexcept
+     : resolution(_resolution), maxHulls(_maxHulls), maxVerticesPerHull(_maxVerticesPerHull), maxDepth(_maxDepth), maxConcavity(_maxConcavity)
+    {}
+
+    #endif
+
+} ConvexDecompositionSettings;
+
+//the decomposition class is only available for C++
+#if __cplusplus
+
+//include resizable containers for the result
+#include <vector>
+
+/**
+ * @brief a static class that splits a closed mesh into a set of convex hulls
+ * 
+ * The decomposition works similar to V-HACD:
+ * - the mesh is converted into a voxel grid and the inside of the mesh is filled
+ * - every part of the voxels (initially the whole mesh) is checked against its convex hull. If the hull contains too many
+ *   voxels that don't belong to the part, the part is cut by the axis aligned plane that results in the smallest hulls.
+ * - neighboring hulls are merged as long as there are more hulls than allowed, starting with the pairs whose merged hull
+ *   adds the smallest volume
+ * The voxelization, the cuts of all parts of a level, the candidate planes of a part and the merge costs are processed in
+ * parallel on the global thread pool. The mesh should be closed, open meshes are treated as a hollow surface.
+ */
+class ConvexDecomposition final
+{
+public:
+
+    /**
+     * @brief split a mesh into convex hulls
+     * 
+     * @param mesh the mesh to decompose. Meshes without indices are treated as triangle lists.
+     * @param settings the settings of the decomposition
+     * @return std::vector<ConvexHull> the hulls in mesh space or an empty list if the mesh has no usable positions or doesn't span a volume
+     */
+    static std::vector<ConvexHull> decompose(const Mesh& mesh, const ConvexDecompositionSettings& settings = ConvexDecompositionSettings()) noexcept;
+
+private:
+
+    //the class is static only
+    ConvexDecomposition() = delete;
+
+};
+
+#endif
+
+/**
+ * @brief split a mesh into convex hulls
+ * 
+ * Querying the amount runs the full decomposition, the result is not cached. At most settings->maxHulls hulls (one if it is 0) are created,
+ * so an array of that size can be passed directly instead of calling the function twice.
+ * 
+ * @param mesh a pointer to the mesh to decompose
+ * @param settings a pointer to the settings of the decomposition
+ * @param hulls a pointer to an array to write the hulls to. The hulls must be deleted using convexHull_Delete. May be NULL to only quarry the amount.
+ * @param maxHulls the amount of hulls that fit into the array
+ * @return uint64_t the amount of created hulls
+ */
+uint64_t convexDecomposition_Decompose(const Mesh* mesh, const ConvexDecompositionSettings* settings, ConvexHull** hulls, uint64_t maxHulls);
+
+#endif
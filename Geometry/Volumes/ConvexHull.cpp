@@ -0,0 +1,474 @@
+/**
+ * @file ConvexHull.cpp
+ * @author DM8AT
+ * @brief implement the quickhull algorithm for convex hulls and the C binding for convex hulls
+ * @version 0.1
+ * @date 2025-11-09
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ */
+
+//include convex hulls
+#include "ConvexHull.h"
+
+//for minimum, maximum and sorting
+#include <algorithm>
+//the faces with the furthest points are processed first
+#include <queue>
+//for the float epsilon
+#include <cfloat>
+
+/**
+ * @brief store a single triangle while the hull is build
+ */
+struct __HullFace {
+    //the vertices of the face, counter clockwise when viewed from the outside
+    uint32_t v[3];
+    //the face on the other side of the edge from v[i] to v[(i+1)%3]
+    uint32_t adj[3];
+    //the outward facing normal of the face (double precision keeps thin faces from tilting)
+    double normal[3];
+    //the distance of the face from the origin along the normal
+    double dist;
+    //the points that are outside of this face
+    std::vector<uint32_t> outside;
+    //the outside point that is furthest away from the face
+    uint32_t furthest = UINT32_MAX;
+    //the distance of the furthest point
+    float furthestDist = 0.f;
+    //the iteration the face was last found to be visible in
+    uint32_t visited = 0;
+    //false if the face was replaced
+    bool alive = true;
+};
+
+/**
+ * @brief store an edge of the border between the visible and the hidden faces
+ */
+struct __HorizonEdge {
+    //the start and end vertex of the edge (counter clockwise on the visible face)
+    uint32_t a, b;
+    //the hidden face behind the edge
+    uint32_t face;
+    //the index of the edge in the hidden face
+    uint32_t edge;
+    //the visible face in front of the edge
+    uint32_t visible;
+};
+
+/**
+ * @brief compute the signed distance of a point to the plane of a face
+ * 
+ * @param face the face to compute the distance to
+ * @param p the point to compute the distance for
+ * @return double the distance, positive if the point is outside of the face
+ */
+static inline double __distance(const __HullFace& face, const vec3& p) noexcept
+{return face.normal[0]*(double)p.x + face.normal[1]*(double)p.y + face.normal[2]*(double)p.z - face.dist;}
+
+/**
+ * @brief compute the plane of a face
+ * 
+ * @param face the face to compute the plane for
+ * @param points the positions of all points
+ * @return true : the face spans an area
+ * @return false : the face is degenerated, the plane is unchanged
+ */
+static bool __computePlane(__HullFace& face, const std::span<const vec3>& points) noexcept {
+    double p[3][3];
+    for (uint32_t i = 0; i < 3; ++i) {
+        const vec3& v = points[face.v[i]];
+        p[i][0] = v.x; p[i][1] = v.y; p[i][2] = v.z;
+    }
+    double e0[3], e1[3];
+    for (uint32_t i = 0; i < 3; ++i) {e0[i] = p[1][i] - p[0][i]; e1[i] = p[2][i] - p[0][i];}
+    double n[3] = {e0[1]*e1[2] - e0[2]*e1[1], e0[2]*e1[0] - e0[0]*e1[2], e0[0]*e1[1] - e0[1]*e1[0]};
+    double len = std::sqrt(n[0]*n[0] + n[1]*n[1] + n[2]*n[2]);
+    if (!(len > 0.0)) {return false;}
+    face.dist = 0.0;
+    for (uint32_t i = 0; i < 3; ++i) {
+        face.normal[i] = n[i] / len;
+        //averaging the corners spreads the rounding error evenly over the face
+        face.dist += face.normal[i] * (p[0][i] + p[1][i] + p[2][i]) / 3.0;
+    }
+    return true;
+}
+
+/**
+ * @brief add a point to the outside set of the face it is furthest outside of
+ * 
+ * @param faces all faces of the hull
+ * @param candidates the faces to check
+ * @param points the positions of all points
+ * @param point the index of the point to assign
+ * @param epsilon the distance a point must be outside of a face to be assigned
+ */
+static void __assignPoint(std::vector<__HullFace>& faces, std::span<const uint32_t> candidates, const std::span<const vec3>& points,
+                          uint32_t point, float epsilon) noexcept {
+    uint32_t best = UINT32_MAX;
+    float bestDist = epsilon;
+    for (uint32_t f : candidates) {
+        float d = (float)__distance(faces[f], points[point]);
+        if (d > bestDist) {best = f; bestDist = d;}
+    }
+    //points that are not outside of any face are inside of the hull
+    if (best == UINT32_MAX) {return;}
+    __HullFace& face = faces[best];
+    face.outside.push_back(point);
+    if (bestDist > face.furthestDist) {face.furthest = point; face.furthestDist = bestDist;}
+}
+
+bool ConvexHull::build(std::span<const vec3> points, uint32_t maxVertices) noexcept
+{
+    clear();
+    if (points.size() < 4 || points.size() >= UINT32_MAX) {return false;}
+    if (maxVertices && maxVertices < 4) {maxVertices = 4;}
+
+    //find the extreme points along all axes, the epsilon scales with the extent of the points
+    uint32_t extremes[6] = {0,0,0,0,0,0};
+    vec3 maxAbs(0.f);
+    for (uint32_t i = 0; i < (uint32_t)points.size(); ++i) {
+        const vec3& p = points[i];
+        if (p.x < points[extremes[0]].x) {extremes[0] = i;}
+        if (p.x > points[extremes[1]].x) {extremes[1] = i;}
+        if (p.y < points[extremes[2]].y) {extremes[2] = i;}
+        if (p.y > points[extremes[3]].y) {extremes[3] = i;}
+        if (p.z < points[extremes[4]].z) {extremes[4] = i;}
+        if (p.z > points[extremes[5]].z) {extremes[5] = i;}
+        maxAbs = vec3(std::max(maxAbs.x, std::abs(p.x)), std::max(maxAbs.y, std::abs(p.y)), std::max(maxAbs.z, std::abs(p.z)));
+    }
+    float epsilon = 3.f * FLT_EPSILON * (maxAbs.x + maxAbs.y + maxAbs.z);
+
+    //the initial simplex starts with the two extreme points that are furthest apart
+    uint32_t simplex[4];
+    float best = -1.f;
+    for (uint32_t i = 0; i < 6; ++i) {
+        for (uint32_t j = i+1; j < 6; ++j) {
+            vec3 d = points[extremes[i]] - points[extremes[j]];
+            if (dot(d, d) > best) {best = dot(d, d); simplex[0] = extremes[i]; simplex[1] = extremes[j];}
+        }
+    }
+    if (std::sqrt(best) <= epsilon) {return false;}
+
+    //then the point furthest away from the line
+    vec3 dir = points[simplex[1]] - points[simplex[0]];
+    best = -1.f;
+    for (uint32_t i = 0; i < (uint32_t)points.size(); ++i) {
+        vec3 c = cross(points[i] - points[simplex[0]], dir);
+        if (dot(c, c) > best) {best = dot(c, c); simplex[2] = i;}
+    }
+    if (std::sqrt(best) / length(dir) <= epsilon) {return false;}
+
+    //and the point furthest away from the plane of the triangle
+    vec3 normal = normalize(cross(points[simplex[1]] - points[simplex[0]], points[simplex[2]] - points[simplex[0]]));
+    best = -1.f;
+    float side = 0.f;
+    for (uint32_t i = 0; i < (uint32_t)points.size(); ++i) {
+        float d = dot(normal, points[i] - points[simplex[0]]);
+        if (std::abs(d) > best) {best = std::abs(d); side = d; simplex[3] = i;}
+    }
+    if (best <= epsilon) {return false;}
+    //make the base triangle face away from the last point
+    if (side > 0.f) {std::swap(simplex[1], simplex[2]);}
+
+    //create the faces of the simplex, all of them are counter clockwise when viewed from the outside
+    std::vector<__HullFace> faces(4);
+    const uint32_t simplexFaces[4][3] = {{0,1,2}, {0,3,1}, {1,3,2}, {2,3,0}};
+    for (uint32_t f = 0; f < 4; ++f) {
+        for (uint32_t i = 0; i < 3; ++i) {faces[f].v[i] = simplex[simplexFaces[f][i]];}
+        __computePlane(faces[f], points);
+    }
+    //every edge is shared with the face that has the same edge in the opposite direction
+    for (uint32_t f = 0; f < 4; ++f) {
+        for (uint32_t e = 0; e < 3; ++e) {
+            uint32_t a = faces[f].v[e], b = faces[f].v[(e+1)%3];
+            for (uint32_t o = 0; o < 4; ++o) {
+                for (uint32_t k = 0; k < 3; ++k) {
+                    if (faces[o].v[k] == b && faces[o].v[(k+1)%3] == a) {faces[f].adj[e] = o;}
+                }
+            }
+        }
+    }
+
+    //assign all remaining points to the faces they are outside of
+    const uint32_t initial[4] = {0,1,2,3};
+    for (uint32_t i = 0; i < (uint32_t)points.size(); ++i) {
+        if (i == simplex[0] || i == simplex[1] || i == simplex[2] || i == simplex[3]) {continue;}
+        __assignPoint(faces, initial, points, i, epsilon);
+    }
+
+    //always process the face with the furthest outside point, so a limited hull contains the most important points
+    using QueueEntry = std::pair<float, uint32_t>;
+    std::priority_queue<QueueEntry> queue;
+    for (uint32_t f = 0; f < 4; ++f) {
+        if (!faces[f].outside.empty()) {queue.push({faces[f].furthestDist, f});}
+    }
+
+    uint32_t vertexCount = 4;
+    uint32_t iteration = 0;
+    std::vector<uint32_t> visible;
+    std::vector<__HorizonEdge> horizon;
+    std::vector<uint32_t> created;
+    //the stack stores the face, the first edge to check and the amount of checked edges
+    struct StackEntry {uint32_t face, edge, count;};
+    std::vector<StackEntry> stack;
+    while (!queue.empty()) {
+        if (maxVertices && vertexCount >= maxVertices) {break;}
+        uint32_t start = queue.top().second;
+        queue.pop();
+        //skip faces that were replaced since they were queued
+        if (!faces[start].alive || faces[start].outside.empty()) {continue;}
+        uint32_t eye = faces[start].furthest;
+        const vec3& eyePos = points[eye];
+        ++iteration;
+
+        //find all faces that can see the point and the horizon around them using a depth first search
+        visible.clear();
+        horizon.clear();
+        stack.clear();
+        faces[start].visited = iteration;
+        visible.push_back(start);
+        stack.push_back({start, 0, 0});
+        while (!stack.empty()) {
+            StackEntry& top = stack.back();
+            if (top.count == 3) {stack.pop_back(); continue;}
+            uint32_t f = top.face;
+            uint32_t e = (top.edge + top.count) % 3;
+            ++top.count;
+            uint32_t n = faces[f].adj[e];
+            if (faces[n].visited == iteration) {continue;}
+            //the edge of the neighbor that points back to the current face
+            uint32_t k = (faces[n].adj[0] == f) ? 0 : ((faces[n].adj[1] == f) ? 1 : 2);
+            //any face the point is above must be replaced, a tolerance here would fold thin new faces inwards
+            if (__distance(faces[n], eyePos) > 0.0) {
+                faces[n].visited = iteration;
+                visible.push_back(n);
+                //continue after the shared edge, so the horizon is found in counter clockwise order
+                stack.push_back({n, (k+1) % 3, 0});
+            } else {
+                horizon.push_back({faces[f].v[e], faces[f].v[(e+1)%3], n, k, f});
+            }
+        }
+
+        //the horizon must be a single closed loop, else the hull is broken by numerical errors
+        bool closed = horizon.size() >= 3;
+        for (uint64_t i = 0; closed && i < horizon.size(); ++i) {closed = horizon[i].b == horizon[(i+1) % horizon.size()].a;}
+        if (!closed) {
+            //drop the point and continue with the rest of the hull
+            faces[start].outside.erase(std::find(faces[start].outside.begin(), faces[start].outside.end(), eye));
+            faces[start].furthest = UINT32_MAX;
+            faces[start].furthestDist = 0.f;
+            for (uint32_t p : faces[start].outside) {
+                float d = (float)__distance(faces[start], points[p]);
+                if (d > faces[start].furthestDist) {faces[start].furthest = p; faces[start].furthestDist = d;}
+            }
+            if (!faces[start].outside.empty()) {queue.push({faces[start].furthestDist, start});}
+            continue;
+        }
+
+        //connect every horizon edge to the point
+        created.clear();
+        uint32_t first = (uint32_t)faces.size();
+        uint32_t count = (uint32_t)horizon.size();
+        for (uint32_t i = 0; i < count; ++i) {
+            const __HorizonEdge& edge = horizon[i];
+            __HullFace face;
+            face.v[0] = edge.a;
+            face.v[1] = edge.b;
+            face.v[2] = eye;
+            face.adj[0] = edge.face;
+            face.adj[1] = first + (i+1) % count;
+            face.adj[2] = first + (i+count-1) % count;
+            //a face that is degenerated because the point lies on the edge keeps the plane of the replaced face
+            if (!__computePlane(face, points)) {
+                const __HullFace& replaced = faces[edge.visible];
+                for (uint32_t k = 0; k < 3; ++k) {face.normal[k] = replaced.normal[k];}
+                face.dist = 0.0;
+                face.dist = __distance(face, eyePos);
+            }
+            faces[edge.face].adj[edge.edge] = first + i;
+            faces.push_back(std::move(face));
+            created.push_back(first + i);
+        }
+
+        //the points outside of the replaced faces are either inside of the hull now or outside of a new face
+        for (uint32_t f : visible) {
+            faces[f].alive = false;
+            for (uint32_t p : faces[f].outside) {
+                if (p != eye) {__assignPoint(faces, created, points, p, epsilon);}
+            }
+            std::vector<uint32_t>().swap(faces[f].outside);
+        }
+        for (uint32_t f : created) {
+            if (!faces[f].outside.empty()) {queue.push({faces[f].furthestDist, f});}
+        }
+        ++vertexCount;
+    }
+
+    //collect all vertices that are used by the remaining faces
+    std::vector<uint32_t> remap(points.size(), UINT32_MAX);
+    std::vector<uint32_t> faceIds;
+    for (uint32_t f = 0; f < (uint32_t)faces.size(); ++f) {
+        if (!faces[f].alive) {continue;}
+        faceIds.push_back(f);
+        for (uint32_t i = 0; i < 3; ++i) {
+            uint32_t& idx = remap[faces[f].v[i]];
+            if (idx == UINT32_MAX) {
+                idx = (uint32_t)m_vertices.size();
+                m_vertices.push_back(points[faces[f].v[i]]);
+            }
+            m_indices.push_back(idx);
+        }
+    }
+
+    //neighboring faces whose vertices lie on the plane of a seed face share the plane of the seed. Comparing against the
+    //seed (instead of chaining neighbors) keeps all vertices of a merged face within the epsilon of its plane.
+    std::vector<bool> merged(faces.size(), false);
+    std::vector<uint32_t> pending;
+    for (uint32_t seed : faceIds) {
+        if (merged[seed]) {continue;}
+        const __HullFace& plane = faces[seed];
+        m_planes.push_back(ConvexHullPlane{vec3((float)plane.normal[0], (float)plane.normal[1], (float)plane.normal[2]), (float)plane.dist});
+        merged[seed] = true;
+        pending.push_back(seed);
+        while (!pending.empty()) {
+            uint32_t f = pending.back();
+            pending.pop_back();
+            for (uint32_t e = 0; e < 3; ++e) {
+                uint32_t n = faces[f].adj[e];
+                const double* nn = faces[n].normal;
+                if (merged[n] || (plane.normal[0]*nn[0] + plane.normal[1]*nn[1] + plane.normal[2]*nn[2]) <= 0.0) {continue;}
+                bool coplanar = true;
+                for (uint32_t i = 0; coplanar && i < 3; ++i)
+                {coplanar = std::abs(__distance(plane, points[faces[n].v[i]])) <= epsilon;}
+                if (coplanar) {
+                    merged[n] = true;
+                    pending.push_back(n);
+                }
+            }
+        }
+    }
+
+    //store the neighbors of every vertex in one array
+    std::vector<std::pair<uint32_t, uint32_t>> edges;
+    edges.reserve(m_indices.size());
+    for (uint64_t i = 0; i < m_indices.size(); i += 3) {
+        for (uint32_t e = 0; e < 3; ++e) {edges.push_back({m_indices[i+e], m_indices[i + (e+1)%3]});}
+    }
+    //every edge exists once per direction, so sorting groups the neighbors of every vertex
+    std::sort(edges.begin(), edges.end());
+    m_adjacencyStart.assign(m_vertices.size() + 1, 0);
+    m_adjacency.reserve(edges.size());
+    for (const auto& edge : edges) {
+        ++m_adjacencyStart[edge.first + 1];
+        m_adjacency.push_back(edge.second);
+    }
+    for (uint64_t i = 0; i < m_vertices.size(); ++i) {m_adjacencyStart[i+1] += m_adjacencyStart[i];}
+
+    //compute the bounds, the volume and the center of mass from tetrahedra between the faces and an inner point
+    m_bounds = AABB(m_vertices[0], m_vertices[0]);
+    vec3 center(0.f);
+    for (const vec3& v : m_vertices) {
+        m_bounds.merge(v);
+        center += v;
+    }
+    center = center / (float)m_vertices.size();
+    vec3 weighted(0.f);
+    for (uint64_t i = 0; i < m_indices.size(); i += 3) {
+        const vec3& a = m_vertices[m_indices[i]];
+        const vec3& b = m_vertices[m_indices[i+1]];
+        const vec3& c = m_vertices[m_indices[i+2]];
+        float vol = dot(a - center, cross(b - center, c - center)) / 6.f;
+        m_volume += vol;
+        weighted += (a + b + c + center) * (vol * 0.25f);
+    }
+    m_centroid = (m_volume > 0.f) ? weighted / m_volume : center;
+    return true;
+}
+
+void ConvexHull::clear() noexcept
+{
+    m_vertices.clear();
+    m_indices.clear();
+    m_planes.clear();
+    m_adjacencyStart.clear();
+    m_adjacency.clear();
+    m_bounds = AABB();
+    m_volume = 0.f;
+    m_centroid = vec3(0.f);
+}
+
+uint32_t ConvexHull::getSupportIndex(const vec3& direction, uint32_t start) const noexcept
+{
+    //the walk has some overhead, small hulls are faster to check completely
+    constexpr uint64_t BRUTE_FORCE_LIMIT = 32;
+    if (m_vertices.empty()) {return 0;}
+    if (m_vertices.size() <= BRUTE_FORCE_LIMIT || start >= m_vertices.size()) {start = 0;}
+    uint32_t best = start;
+    float bestDist = dot(m_vertices[start], direction);
+    if (m_vertices.size() <= BRUTE_FORCE_LIMIT) {
+        for (uint32_t i = 1; i < (uint32_t)m_vertices.size(); ++i) {
+            float d = dot(m_vertices[i], direction);
+            if (d > bestDist) {best = i; bestDist = d;}
+        }
+        return best;
+    }
+
+    //on a convex hull every local maximum is the global maximum, so walking to better neighbors finds the support point
+    bool improved = true;
+    while (improved) {
+        improved = false;
+        for (uint32_t n : getNeighbors(best)) {
+            float d = dot(m_vertices[n], direction);
+            if (d > bestDist) {best = n; bestDist = d; improved = true;}
+        }
+    }
+    return best;
+}
+
+bool ConvexHull::contains(const vec3& point, float epsilon) const noexcept
+{
+    if (m_planes.empty()) {return false;}
+    for (const ConvexHullPlane& plane : m_planes) {
+        if (dot(plane.normal, point) - plane.distance > epsilon) {return false;}
+    }
+    return true;
+}
+
+Mesh ConvexHull::toMesh() const noexcept
+{
+    if (m_vertices.empty()) {return Mesh();}
+    //positions are stored tightly packed, independent of the padding of the vector type
+    VertexLayout layout = {VertexElement(VERTEX_ELEMENT_TYPE_POSITION, VERTEX_ELEMENT_DATA_TYPE_FLOAT_VEC3)};
+    std::vector<float> positions(m_vertices.size() * 3);
+    for (uint64_t i = 0; i < m_vertices.size(); ++i) {
+        positions[i*3 + 0] = m_vertices[i].x;
+        positions[i*3 + 1] = m_vertices[i].y;
+        positions[i*3 + 2] = m_vertices[i].z;
+    }
+    return Mesh(positions.data(), m_vertices.size(), layout, m_indices.data(), m_indices.size(), INDEX_TYPE_UINT32);
+}
+
+
+
+ConvexHull* convexHull_Create(const Mesh* mesh, uint32_t maxVertices)
+{
+    //only return hulls that were build successfully
+    ConvexHull* hull = new ConvexHull();
+    if (!hull->build(*mesh, maxVertices)) {
+        delete hull;
+        return NULL;
+    }
+    return hull;
+}
+
+void convexHull_Delete(ConvexHull* hull) {delete hull;}
+
+uint64_t convexHull_GetVertexCount(const ConvexHull* hull) {return hull->getVertices().size();}
+
+const vec3* convexHull_GetVertices(const ConvexHull* hull) {return hull->getVertices().data();}
+
+vec3 convexHull_Support(const ConvexHull* hull, vec3 direction) {return hull->support(direction);}
+
+Mesh* convexHull_ToMesh(const ConvexHull* hull) {return new Mesh(hull->toMesh());}
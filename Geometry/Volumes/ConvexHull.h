@@ -0,0 +1,286 @@
+/**
+ * @file ConvexHull.h
+ * @author DM8AT
+ * @brief define convex hulls that are build from point clouds or meshes using the quickhull algorithm
+ * @version 0.1
+ * @date 2025-11-09
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ */
+
+//header guard
+#ifndef _GLGE_CORE_GEOMETRY_VOLUMES_CONVEX_HULL_
+#define _GLGE_CORE_GEOMETRY_VOLUMES_CONVEX_HULL_
+
+//include the type definitions
+#include "../../Types.h"
+//include math types
+#include "../../../GLGE_Math/GLGEMath.h"
+//include AABB's for the bounds of the hull
+#include "AABB.h"
+//include meshes as in- and output
+#include "../Surface/Mesh.h"
+
+/**
+ * @brief store a single plane of a convex hull
+ * 
+ * A point p is inside of the plane if dot(normal, p) <= distance
+ */
+typedef struct s_ConvexHullPlane {
+    //the normalized normal of the plane, pointing out of the hull
+    vec3 normal;
+    //the distance of the plane from the origin along the normal
+    float distance;
+} ConvexHullPlane;
+
+//the hull class is only available for C++
+#if __cplusplus
+
+//include typed views for the hull data
+#include <span>
+//include resizable containers
+#include <vector>
+
+/**
+ * @brief store a convex hull of a set of points
+ * 
+ * The hull is build using the quickhull algorithm. It stores the vertices and the outward facing triangles of the hull,
+ * the planes of the hull (coplanar triangles share a plane) and the neighbors of every vertex. The vertices and the
+ * neighbors are used by the support function, so the hull can be used directly by GJK / EPA style collision tests.
+ * The planes are used for separating axis tests and point containment tests.
+ */
+class ConvexHull
+{
+public:
+
+    /**
+     * @brief Construct a new Convex Hull
+     * 
+     * The hull is empty
+     */
+    ConvexHull() = default;
+
+    /**
+     * @brief Construct a new Convex Hull from a set of points
+     * 
+     * @param points the points to enclose
+     * @param maxVertices the maximum amount of vertices of the hull or 0 for no limit
+     */
+    inline ConvexHull(std::span<const vec3> points, uint32_t maxVertices = 0) noexcept
+    {build(points, maxVertices);}
+
+    /**
+     * @brief Construct a new Convex Hull from the positions of a mesh
+     * 
+     * @param mesh the mesh to enclose
+     * @param maxVertices the maximum amount of vertices of the hull or 0 for no limit
+     */
+    inline ConvexHull(const Mesh& mesh, uint32_t maxVertices = 0) noexcept
+    {build(mesh, maxVertices);}
+
+    /**
+     * @brief build the hull of a set of points
+     * 
+     * Points that are closer to the hull than a small epsilon (relative to the extent of the points) are treated as inside.
+     * If the amount of vertices is limited, the points that are furthest away from the current hull are added first. The
+     * resulting hull is a good approximation, but may not contain all points.
+     * 
+     * @param points the points to enclose
+     * @param maxVertices the maximum amount of vertices of the hull or 0 for no limit. Values below 4 are treated as 4.
+     * @return true : the hull was build
+     * @return false : there are less than 4 points or all points lie on a single plane. The hull is empty.
+     */
+    bool build(std::span<const vec3> points, uint32_t maxVertices = 0) noexcept;
+
+    /**
+     * @brief build the hull of the positions of a mesh
+     * 
+     * @param mesh the mesh to enclose
+     * @param maxVertices the maximum amount of vertices of the hull or 0 for no limit
+     * @return true : the hull was build
+     * @return false : the mesh has no usable positions or the positions don't span a volume. The hull is empty.
+     */
+    inline bool build(const Mesh& mesh, uint32_t maxVertices = 0) noexcept
+    {std::vector<vec3> positions = mesh.getPositions(); return build(positions, maxVertices);}
+
+    /**
+     * @brief remove all data from the hull
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief check if the hull is empty
+     * 
+     * @return true : the hull has no vertices
+     * @return false : the hull has vertices
+     */
+    inline bool empty() const noexcept {return m_vertices.empty();}
+
+    /**
+     * @brief get the vertex of the hull that is furthest along a direction
+     * 
+     * Large hulls walk over the neighbors of the vertices (hill climbing), small hulls simply check all vertices.
+     * 
+     * @param direction the direction to search in. Doesn't need to be normalized.
+     * @param start the index of the vertex to start the search at. Passing the result of the last query of a moving
+     * object makes repeated queries very cheap.
+     * @return uint32_t the index of the furthest vertex
+     */
+    uint32_t getSupportIndex(const vec3& direction, uint32_t start = 0) const noexcept;
+
+    /**
+     * @brief get the point of the hull that is furthest along a direction
+     * 
+     * @param direction the direction to search in. Doesn't need to be normalized.
+     * @return vec3 the furthest point or 0 if the hull is empty
+     */
+    inline vec3 support(const vec3& direction) const noexcept
+    {return m_vertices.empty() ? vec3(0.f) : m_vertices[getSupportIndex(direction)];}
+
+    /**
+     * @brief check if a point is inside of the hull
+     * 
+     * @param point the point to check
+     * @param epsilon the distance a point may be outside of the planes and still count as inside
+     * @return true : the point is inside of the hull
+     * @return false : the point is outside of the hull or the hull is empty
+     */
+    bool contains(const vec3& point, float epsilon = 0.f) const noexcept;
+
+    /**
+     * @brief Get the vertices of the hull
+     * 
+     * @return std::span<const vec3> the positions of all vertices
+     */
+    inline std::span<const vec3> getVertices() const noexcept {return m_vertices;}
+
+    /**
+     * @brief Get the triangles of the hull
+     * 
+     * @return std::span<const uint32_t> 3 vertex indices per triangle, counter clockwise when viewed from the outside
+     */
+    inline std::span<const uint32_t> getIndices() const noexcept {return m_indices;}
+
+    /**
+     * @brief Get the planes of the hull
+     * 
+     * @return std::span<const ConvexHullPlane> one plane per face, coplanar triangles share a plane
+     */
+    inline std::span<const ConvexHullPlane> getPlanes() const noexcept {return m_planes;}
+
+    /**
+     * @brief Get the neighbors of a vertex
+     * 
+     * @param vertex the index of the vertex
+     * @return std::span<const uint32_t> the indices of all vertices that share an edge with the vertex
+     */
+    inline std::span<const uint32_t> getNeighbors(uint32_t vertex) const noexcept
+    {return std::span<const uint32_t>(m_adjacency.data() + m_adjacencyStart[vertex], m_adjacencyStart[vertex+1] - m_adjacencyStart[vertex]);}
+
+    /**
+     * @brief Get the bounds of the hull
+     * 
+     * @return constexpr const AABB& the box that contains all vertices
+     */
+    inline constexpr const AABB& getBounds() const noexcept {return m_bounds;}
+
+    /**
+     * @brief Get the volume of the hull
+     * 
+     * @return constexpr float the enclosed volume
+     */
+    inline constexpr float getVolume() const noexcept {return m_volume;}
+
+    /**
+     * @brief Get the center of mass of the hull (assuming a uniform density)
+     * 
+     * @return constexpr const vec3& the center of mass
+     */
+    inline constexpr const vec3& getCentroid() const noexcept {return m_centroid;}
+
+    /**
+     * @brief create a mesh of the hull
+     * 
+     * @return Mesh a mesh with a 3D float position per vertex and the triangles of the hull
+     */
+    Mesh toMesh() const noexcept;
+
+protected:
+
+    //store the vertices of the hull
+    std::vector<vec3> m_vertices;
+    //store the triangles of the hull
+    std::vector<uint32_t> m_indices;
+    //store the planes of the hull
+    std::vector<ConvexHullPlane> m_planes;
+    //store the first neighbor of every vertex in m_adjacency (one more entry than vertices)
+    std::vector<uint32_t> m_adjacencyStart;
+    //store the neighbors of all vertices
+    std::vector<uint32_t> m_adjacency;
+    //store the bounds of the hull
+    AABB m_bounds;
+    //store the enclosed volume
+    float m_volume = 0.f;
+    //store the center of mass
+    vec3 m_centroid = vec3(0.f);
+
+};
+
+#else //else, define an opaque data structure
+
+//define an opaque (MSVC requires the unused byte) for a convex hull
+typedef struct s_ConvexHull {byte unused;} ConvexHull;
+
+#endif
+
+/**
+ * @brief create the convex hull of the positions of a mesh
+ * 
+ * @param mesh a pointer to the mesh to enclose
+ * @param maxVertices the maximum amount of vertices of the hull or 0 for no limit
+ * @return ConvexHull* a pointer to the new hull or NULL if the positions don't span a volume
+ */
+ConvexHull* convexHull_Create(const Mesh* mesh, uint32_t maxVertices);
+
+/**
+ * @brief delete an existing convex hull
+ * 
+ * @param hull a pointer to the hull to delete
+ */
+void convexHull_Delete(ConvexHull* hull);
+
+/**
+ * @brief get the amount of vertices of a convex hull
+ * 
+ * @param hull a pointer to the hull to quarry the data from
+ * @return uint64_t the amount of vertices
+ */
+uint64_t convexHull_GetVertexCount(const ConvexHull* hull);
+
+/**
+ * @brief get the vertices of a convex hull
+ * 
+ * @param hull a pointer to the hull to quarry the data from
+ * @return const vec3* a pointer to the first vertex
+ */
+const vec3* convexHull_GetVertices(const ConvexHull* hull);
+
+/**
+ * @brief get the point of a convex hull that is furthest along a direction
+ * 
+ * @param hull a pointer to the hull to quarry the data from
+ * @param direction the direction to search in
+ * @return vec3 the furthest point
+ */
+vec3 convexHull_Support(const ConvexHull* hull, vec3 direction);
+
+/**
+ * @brief create a mesh of a convex hull
+ * 
+ * @param hull a pointer to the hull to create the mesh for
+ * @return Mesh* a pointer to a new mesh. It must be deleted using mesh_Delete.
+ */
+Mesh* convexHull_ToMesh(const ConvexHull* hull);
+
+#endif
@@ -19,5 +19,9 @@
 #include "Sphere.h"
 //include BVH's
 #include "BVH.h"
+//include convex hulls
+#include "ConvexHull.h"
+//include convex decompositions
+#include "ConvexDecomposition.h"
 
 #endif
\ No newline at end of file
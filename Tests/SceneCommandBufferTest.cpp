@@ -0,0 +1,64 @@
+/**
+ * @file SceneCommandBufferTest.cpp
+ * @author DM8AT
+ * @brief check that the commands recorded in a scene command buffer are applied in the order they were recorded in
+ * @version 0.1
+ * @date 2025-11-17
+ * 
+ * usage: GLGE_CORE_SCENE_COMMAND_BUFFER_TEST
+ * 
+ * The program returns 0 if all checks passed and prints every failed check.
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ */
+
+//include the ECS
+#include "../Geometry/Structure/ECS/ECS.h"
+
+//for the output
+#include <cstdio>
+
+/**
+ * @brief a simple component used by the checks
+ */
+struct Stunned {
+    //the amount of frames the object is stunned for
+    int frames = 0;
+};
+
+//store the amount of failed checks
+static int __failed = 0;
+
+/**
+ * @brief check a condition and print it if it failed
+ * 
+ * @param condition the condition that must be true
+ * @param name the name of the check
+ */
+static void __check(bool condition, const char* name) noexcept {
+    if (condition) {return;}
+    printf("FAILED: %s\n", name);
+    ++__failed;
+}
+
+int main() {
+    Scene scene("test");
+    Object obj = scene.createObject("obj");
+    SceneCommandBuffer& cb = scene.getCommandBuffer();
+
+    //removing and then adding a component must leave the added component
+    cb.remove<Stunned>(obj);
+    cb.add<Stunned>(obj, Stunned{5});
+    scene.applyCommands();
+    __check(scene.has<Stunned>(obj) && scene.get<Stunned>(obj)->frames == 5, "remove then add keeps the added component");
+
+    //adding and then removing a component must leave no component
+    cb.add<Stunned>(obj, Stunned{7});
+    cb.remove<Stunned>(obj);
+    scene.applyCommands();
+    __check(!scene.has<Stunned>(obj), "add then remove leaves no component");
+
+    if (__failed == 0) {printf("all checks passed\n");}
+    return (__failed == 0) ? 0 : 1;
+}
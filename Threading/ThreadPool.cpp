@@ -0,0 +1,151 @@
+/**
+ * @file ThreadPool.cpp
+ * @author DM8AT
+ * @brief implement the shared thread pool
+ * @version 0.1
+ * @date 2025-11-02
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ */
+
+//include the thread pool
+#include "ThreadPool.h"
+//for the shared job state
+#include <memory>
+//for minimum and maximum
+#include <algorithm>
+
+ThreadPool::ThreadPool(uint32_t threadCount) noexcept
+{
+    //if no amount is given, use one thread per hardware thread except the calling one
+    if (threadCount == 0) {
+        uint32_t hardware = std::thread::hardware_concurrency();
+        threadCount = (hardware > 1) ? (hardware - 1) : 1;
+    }
+
+    //create all the threads
+    m_threads.resize(threadCount);
+    for (auto& t : m_threads)
+    {t = std::thread(&ThreadPool::worker_ThreadFunction, this);}
+}
+
+ThreadPool::~ThreadPool() noexcept
+{
+    //stop the worker threads
+    {
+        std::unique_lock lock(m_jobMutex);
+        m_running = false;
+    }
+    m_jobAvailable.notify_all();
+
+    //join back all threads
+    for (auto& t : m_threads)
+    {t.join();}
+}
+
+void ThreadPool::enqueue(std::function<void()> job) noexcept
+{
+    //without workers, just run the job
+    if (m_threads.empty()) {
+        job();
+        return;
+    }
+
+    //queue the job
+    {
+        std::unique_lock lock(m_jobMutex);
+        m_jobs.push(std::move(job));
+    }
+    //notify a single worker thread
+    m_jobAvailable.notify_one();
+}
+
+void ThreadPool::parallelFor(uint64_t count, uint64_t grainSize, const std::function<void(uint64_t, uint64_t)>& func) noexcept
+{
+    //nothing to do
+    if (count == 0) {return;}
+    //calculate the amount of chunks
+    grainSize = std::max<uint64_t>(grainSize, 1);
+    uint64_t chunks = (count + grainSize - 1) / grainSize;
+
+    //if there is not enough work to split, just run it here
+    if ((chunks == 1) || m_threads.empty()) {
+        func(0, count);
+        return;
+    }
+
+    //store the state shared between all threads working on the range
+    //it is shared so late helpers that find no more work never touch freed memory
+    struct State {
+        //the next chunk to process
+        std::atomic<uint64_t> next{0};
+        //the amount of finished chunks
+        std::atomic<uint64_t> done{0};
+        //used to wake the calling thread
+        std::mutex mutex;
+        std::condition_variable finished;
+    };
+    std::shared_ptr<State> state = std::make_shared<State>();
+
+    //the function every participating thread runs: grab chunks till all are taken
+    auto work = [state, count, grainSize, chunks, &func]() {
+        uint64_t chunk = 0;
+        while ((chunk = state->next.fetch_add(1, std::memory_order::relaxed)) < chunks) {
+            //run the chunk
+            uint64_t begin = chunk * grainSize;
+            func(begin, std::min(begin + grainSize, count));
+            //signal the calling thread if this was the last chunk
+            if (state->done.fetch_add(1, std::memory_order::acq_rel) + 1 == chunks) {
+                std::unique_lock lock(state->mutex);
+                state->finished.notify_all();
+            }
+        }
+    };
+
+    //start helpers on the workers (the calling thread also works, so one less is needed)
+    uint64_t helpers = std::min<uint64_t>(m_threads.size(), chunks - 1);
+    for (uint64_t i = 0; i < helpers; ++i)
+    {enqueue(work);}
+
+    //work on this thread as well
+    work();
+
+    //wait till the chunks that are still processed by workers are done
+    std::unique_lock lock(state->mutex);
+    state->finished.wait(lock, [&]{return state->done.load(std::memory_order::acquire) == chunks;});
+}
+
+ThreadPool& ThreadPool::getGlobal() noexcept
+{
+    //create the pool on first use
+    static ThreadPool pool;
+    return pool;
+}
+
+void ThreadPool::worker_ThreadFunction() noexcept
+{
+    //run till the pool is stopped
+    while (true)
+    {
+        //store the next job
+        std::function<void()> job;
+
+        {
+            //make sure the queue is locked while getting data from it
+            std::unique_lock lock(m_jobMutex);
+            //wait for new work
+            m_jobAvailable.wait(lock, [this]{return !m_jobs.empty() || !m_running;});
+
+            //only stop if all queued work is done
+            if (m_jobs.empty()) {return;}
+
+            //get the job from the queue
+            job = std::move(m_jobs.front());
+            m_jobs.pop();
+        }
+
+        //run the job
+        job();
+    }
+}
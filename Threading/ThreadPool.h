@@ -0,0 +1,123 @@
+/**
+ * @file ThreadPool.h
+ * @author DM8AT
+ * @brief define a simple pool of worker threads that can be shared by all CPU heavy systems
+ * @version 0.1
+ * @date 2025-11-02
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ */
+
+//header guard
+#ifndef _GLGE_CORE_THREADING_THREAD_POOL_
+#define _GLGE_CORE_THREADING_THREAD_POOL_
+
+//include the default types
+#include "../Types.h"
+
+//the thread pool is only available for C++
+#if __cplusplus
+
+//vectors store the worker threads
+#include <vector>
+//a queue stores the pending jobs
+#include <queue>
+//jobs are stored as generic functions
+#include <functional>
+//threads are required for multi-threaded work loads
+#include <thread>
+//mutexes and conditional variables are used for work queueing
+#include <mutex>
+#include <condition_variable>
+//atomics are used to distribute work
+#include <atomic>
+
+/**
+ * @brief a pool of worker threads to run jobs on
+ * 
+ * The pool is used for data parallel work (like mesh processing) where the calling thread waits for the result.
+ * The calling thread always works on the jobs it waits for, so nested parallel calls can't dead-lock.
+ */
+class ThreadPool final
+{
+public:
+
+    /**
+     * @brief Construct a new Thread Pool
+     * 
+     * @param threadCount the amount of worker threads to create. 0 creates one worker per hardware thread except the calling one.
+     */
+    ThreadPool(uint32_t threadCount = 0) noexcept;
+
+    /**
+     * @brief Destroy the Thread Pool
+     * 
+     * @warning all jobs that are still queued are finished before the workers are joined
+     */
+    ~ThreadPool() noexcept;
+
+    //the pool owns the threads, so it can't be copied
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief queue a new job to run on one of the worker threads
+     * 
+     * If the pool has no worker threads the job is executed directly
+     * 
+     * @param job the job to run
+     */
+    void enqueue(std::function<void()> job) noexcept;
+
+    /**
+     * @brief run a function over a range of elements in parallel
+     * 
+     * The range is split into chunks of at most grainSize elements. The function is called once per chunk.
+     * This function returns when all chunks are finished.
+     * 
+     * @param count the amount of elements to process
+     * @param grainSize the maximum amount of elements processed by a single function call
+     * @param func the function to call. It gets the first element and the element after the last element of a chunk.
+     */
+    void parallelFor(uint64_t count, uint64_t grainSize, const std::function<void(uint64_t, uint64_t)>& func) noexcept;
+
+    /**
+     * @brief Get the amount of worker threads
+     * 
+     * @return uint32_t the amount of worker threads owned by the pool
+     */
+    inline uint32_t getThreadCount() const noexcept {return (uint32_t)m_threads.size();}
+
+    /**
+     * @brief Get the global thread pool
+     * 
+     * The global pool is created on first use and has one worker per hardware thread except the calling one.
+     * 
+     * @return ThreadPool& a reference to the shared thread pool
+     */
+    static ThreadPool& getGlobal() noexcept;
+
+private:
+
+    /**
+     * @brief this is the function that runs on all worker threads
+     */
+    void worker_ThreadFunction() noexcept;
+
+    //store the worker threads
+    std::vector<std::thread> m_threads;
+    //store all jobs that wait for execution
+    std::queue<std::function<void()>> m_jobs;
+    //a mutex to make the job queue thread safe
+    std::mutex m_jobMutex;
+    //store if a job is available
+    std::condition_variable m_jobAvailable;
+    //store if the pool is running
+    bool m_running = true;
+
+};
+
+#endif
+
+#endif
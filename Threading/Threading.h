@@ -0,0 +1,19 @@
+/**
+ * @file Threading.h
+ * @author DM8AT
+ * @brief include everything related to multi-threading
+ * @version 0.1
+ * @date 2025-11-02
+ * 
+ * @copyright Copyright (c) 2025
+ * 
+ */
+
+//header guard
+#ifndef _GLGE_CORE_THREADING_
+#define _GLGE_CORE_THREADING_
+
+//include the thread pool
+#include "ThreadPool.h"
+
+#endif